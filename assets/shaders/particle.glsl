@@ -0,0 +1,190 @@
+/*
+ * Particulas Gerstner - codigo comun
+ * Incluido por shader.vert (rasterizado) y splat_project.comp (splatting)
+ */
+
+uniform mat4 mvp;
+uniform float time;
+uniform float layerOffset;  // Offset vertical de la capa
+uniform float intensity;    // Intensidad del color (1.0 = principal)
+uniform float uGridSize;    // Tamaño del grid para wrapping correcto
+uniform float peakExp;      // Exponente para resaltar solo picos (1.0 = normal, >1.0 = solo picos)
+
+// Audio Uniforms (Reactividad)
+uniform float uBass;
+uniform float uMids;
+uniform float uTreble;
+
+// Historial de espectro (fila = un analisis de ~21 ms, ver Spectrogram.h).
+// Cada particula ve el audio de hace (distancia a la camara) filas, asi
+// los golpes de bajo se propagan hacia el fondo
+uniform sampler2D uSpectrogram;
+uniform float uSpectrogramHead;    // Fila mas reciente
+uniform float uSpectrogramRows;
+uniform float uHistoryOrigin;      // Distancia que ve el audio actual
+uniform float uHistoryRowsPerUnit; // 0 = todo el oceano reacciona a la vez
+
+// Bins log del espectrograma que cubren cada banda (bins FFT 5 y 40)
+const float SPECTRUM_BASS_END = 20.0 / 64.0;
+const float SPECTRUM_MIDS_END = 43.0 / 64.0;
+
+// Bandas que ve esta particula (las escribe gerstnerWave)
+float pBass;
+float pMids;
+float pTreble;
+
+float spectrumBand(float row, float u0, float u1) {
+    float sum = 0.0;
+    for (int i = 0; i < 4; i++) {
+        float u = mix(u0, u1, (float(i) + 0.5) / 4.0);
+        sum += textureLod(uSpectrogram, vec2(u, row), 0.0).r;
+    }
+    return sum * 0.25;
+}
+
+vec3 spectrumBands(float age) {
+    // GL_REPEAT en T: edades por encima de head dan la vuelta al ring
+    float row = (uSpectrogramHead - age + 0.5) / uSpectrogramRows;
+    return vec3(spectrumBand(row, 0.0, SPECTRUM_BASS_END),
+                spectrumBand(row, SPECTRUM_BASS_END, SPECTRUM_MIDS_END),
+                spectrumBand(row, SPECTRUM_MIDS_END, 1.0));
+}
+
+// Uniforms actuales + cuanto cambio el espectro entre entonces y ahora:
+// sin historial (o a distancia origin) es exactamente lo de antes
+void sampleAudioHistory(vec2 gridPos) {
+    pBass = uBass;
+    pMids = uMids;
+    pTreble = uTreble;
+    if (uHistoryRowsPerUnit <= 0.0 || uSpectrogramRows < 2.0)
+        return;
+
+    // w de clip = profundidad en vista (proyeccion perspectiva)
+    float dist = (mvp * vec4(gridPos.x, layerOffset, gridPos.y, 1.0)).w;
+    float age = clamp((dist - uHistoryOrigin) * uHistoryRowsPerUnit, 0.0,
+                      uSpectrogramRows - 2.0);
+    vec3 delta = spectrumBands(age) - spectrumBands(0.0);
+    pBass = clamp(uBass + delta.x, 0.0, 1.0);
+    pMids = clamp(uMids + delta.y, 0.0, 1.0);
+    pTreble = clamp(uTreble + delta.z, 0.0, 1.0);
+}
+
+// Parametros de las ondas
+const float amplitude = 0.15;
+const float frequency = 3.0;
+const float speed = 1.5;
+const float steepness = 0.5;
+const float PI = 3.14159;
+
+// Funcion de onda Gerstner
+vec3 gerstnerWave(vec2 pos, float t) {
+    // Scroll infinito uniforme
+    float driftSpeed = 0.4;
+    float gridSize = uGridSize;
+    
+    // Wrap en ambos ejes para evitar bordes
+    vec2 driftedPos;
+    driftedPos.x = mod(pos.x + gridSize * 0.5, gridSize) - gridSize * 0.5;
+    driftedPos.y = mod(pos.y + t * driftSpeed + gridSize * 0.5, gridSize) - gridSize * 0.5;
+    sampleAudioHistory(driftedPos);
+    
+    // Direcciones de onda
+    vec2 dir1 = normalize(vec2(1.0, 0.5));
+    vec2 dir2 = normalize(vec2(-0.7, 1.0));
+    
+    // Audio Reactivity (Amplitude)
+    // Linear multiplier provides better sensitivity at low volumes
+    float bassPunch = pBass * 0.4; 
+    float audioEnergy = (bassPunch * 0.8) + (pMids * 0.2);
+    float audioAmp = audioEnergy * 0.5; 
+    float currentAmp = amplitude + audioAmp;
+    
+    // Wave 1
+    float phase1 = dot(dir1, driftedPos) * frequency - t * speed;
+    float wave1 = sin(phase1) * currentAmp;
+    float dx1 = steepness * currentAmp * dir1.x * cos(phase1);
+    float dz1 = steepness * currentAmp * dir1.y * cos(phase1);
+    
+    // Wave 2 (crossed)
+    float phase2 = dot(dir2, driftedPos) * frequency * 1.3 - t * speed * 0.8;
+    float wave2 = sin(phase2) * currentAmp * 0.6;
+    float dx2 = steepness * currentAmp * 0.6 * dir2.x * cos(phase2);
+    float dz2 = steepness * currentAmp * 0.6 * dir2.y * cos(phase2);
+    
+    // Combine
+    float height = wave1 + wave2;
+    float offsetX = dx1 + dx2;
+    float offsetZ = dz1 + dz2;
+    
+    return vec3(driftedPos.x + offsetX, height, driftedPos.y + offsetZ);
+}
+
+// Tamaño (gl_PointSize) y color de una particula ya desplazada
+// (despues de gerstnerWave: usa las bandas de la particula)
+void particleAppearance(vec3 wavePos, out float pointSize, out vec3 color) {
+    // Size and Color based on height
+    float maxExpectedAmp = 0.4;
+    float rawHeight = (wavePos.y - layerOffset + maxExpectedAmp) / (2.0 * maxExpectedAmp);
+    float heightFactor = pow(clamp(rawHeight, 0.001, 1.0), peakExp); 
+    
+    // Treble adds sparkle size
+    float sparkleBoost = pTreble * 2.0; 
+    
+    float maxSize = ((peakExp > 1.5) ? 7.0 : 6.0) + sparkleBoost; 
+    float minSize = 2.0; 
+    pointSize = mix(minSize, maxSize, heightFactor) * intensity;
+    
+    // Identify Layers
+    // Far: > 10.0, Main: > 5.0, Near: < 5.0
+    bool isFarLayer = uGridSize > 10.0;
+    bool isMainLayer = uGridSize > 5.0 && !isFarLayer;
+
+    // Color Palette
+    vec3 cyan, magenta;
+    
+    if (isFarLayer) {
+        // Far Layer: Strong Neon
+        cyan = vec3(0.1, 0.6, 0.9);
+        magenta = vec3(1.3, 0.1, 1.3); 
+    } else {
+        // Main/Near Layers: Softer tone
+        cyan = vec3(0.1, 0.6, 0.9) * 0.85;
+        magenta = vec3(1.3, 0.1, 1.3) * 0.85;
+    }
+    
+    vec3 pastelPink = vec3(1.0, 0.8, 1.0);
+    
+    // Brighten with treble
+    magenta += vec3(pTreble * 0.2); 
+    
+    // Color Mix
+    float colorMix = smoothstep(0.35, 0.75, rawHeight);
+    vec3 baseColor = mix(cyan, magenta, colorMix);
+    
+    // Foam Factor
+    float foamMix = 0.0;
+    
+    if (isFarLayer) {
+        foamMix = 0.0;
+    } else if (isMainLayer) {
+        foamMix = smoothstep(0.93, 1.0, rawHeight);
+    } else {
+        // Reduced visibility for near layer
+        foamMix = smoothstep(0.93, 1.0, rawHeight) * 0.3;
+    }
+    
+    // Dynamic Brightness Pulse
+    float pulse = 0.0;
+    if (isFarLayer) {
+        // "Capa Inferior": Strong Neon Reactivity
+        pulse = pBass * 0.8; 
+    } else {
+        // Main/Near layers: Subtle pulse
+        pulse = pBass * 0.15;
+    }
+    
+    float dynamicIntensity = intensity * (1.0 + pulse);
+    
+    // Apply final mix: Base -> Pastel Pink (only if foamMix > 0)
+    color = mix(baseColor, pastelPink, foamMix) * dynamicIntensity;
+}
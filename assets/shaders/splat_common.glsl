@@ -0,0 +1,33 @@
+/*
+ * Splatting por tiles - buffers y utilidades comunes
+ * Debe coincidir con SplatBinning.h/.cpp (referencia CPU)
+ */
+
+const int TILE_SIZE = 16;
+
+// Particula proyectada: centro en ventana, tamaño (0 = recortada), color
+struct Splat {
+    vec4 centerSize;
+    vec4 color;
+};
+
+layout(std430, binding = 1) buffer SplatBuffer { Splat splats[]; };
+layout(std430, binding = 2) buffer TileCountBuffer { uint tileCounts[]; };
+layout(std430, binding = 3) buffer TileOffsetBuffer { uint tileOffsets[]; };
+layout(std430, binding = 4) buffer TileCursorBuffer { uint tileCursor[]; };
+layout(std430, binding = 5) buffer TileListBuffer { uint tileList[]; };
+
+uniform ivec2 uViewport;   // Tamaño del target en pixeles
+uniform int uTilesX;
+
+// Rango inclusivo de tiles (x0, y0, x1, y1); vacio si x0 > x1
+ivec4 splatTileRange(vec3 centerSize) {
+    float radius = centerSize.z * 0.5;
+    ivec2 p0 = ivec2(ceil(centerSize.xy - radius - 0.5));
+    ivec2 p1 = ivec2(floor(centerSize.xy + radius - 0.5));
+    p0 = max(p0, ivec2(0));
+    p1 = min(p1, uViewport - 1);
+    if (centerSize.z <= 0.0 || any(greaterThan(p0, p1)))
+        return ivec4(0, 0, -1, -1);
+    return ivec4(p0 / TILE_SIZE, p1 / TILE_SIZE);
+}
@@ -0,0 +1,69 @@
+#pragma once
+/*
+ * Bench - Mini harness de microbenchmarks
+ * Repite cada caso hasta MIN_SECONDS y reporta ns/iter y elementos/s
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace bench {
+
+constexpr double MIN_SECONDS = 0.25;
+
+// Evita que el compilador elimine resultados no usados
+template <typename T> inline void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile char sink;
+  sink = *reinterpret_cast<const volatile char *>(&value);
+#endif
+}
+
+struct Result {
+  double nsPerIter = 0.0;
+  double itemsPerSecond = 0.0;
+};
+
+inline const char *&filter() {
+  static const char *value = nullptr;
+  return value;
+}
+
+inline bool enabled(const std::string &name) {
+  return !filter() || std::strstr(name.c_str(), filter()) != nullptr;
+}
+
+// items: elementos procesados por iteracion (muestras, puntos, ...)
+template <typename Fn>
+Result run(const std::string &name, double items, Fn &&fn) {
+  Result result;
+  if (!enabled(name))
+    return result;
+
+  using Clock = std::chrono::steady_clock;
+  fn(); // calentamiento
+
+  size_t iterations = 1;
+  double elapsed = 0.0;
+  while (true) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; i++)
+      fn();
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    if (elapsed >= MIN_SECONDS)
+      break;
+    iterations *= 2;
+  }
+
+  result.nsPerIter = elapsed * 1e9 / (double)iterations;
+  result.itemsPerSecond = items * (double)iterations / elapsed;
+  std::printf("%-40s %14.1f ns/iter %12.2f M items/s\n", name.c_str(),
+              result.nsPerIter, result.itemsPerSecond / 1e6);
+  return result;
+}
+
+} // namespace bench
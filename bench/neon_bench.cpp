@@ -0,0 +1,279 @@
+// Neon Gerstner - microbenchmarks del nucleo
+// Uso: neon_bench [filtro]
+
+#include "AnalysisRing.h"
+#include "BandAnalyzer.h"
+#include "BandEngine.h"
+#include "Bench.h"
+#include "CaptureCadence.h"
+#include "FFT.h"
+#include "FilterbankAnalyzer.h"
+#include "Grid.h"
+#include "Nebula.h"
+#include "SignalFixtures.h"
+#include "SoftRenderer.h"
+#include "Spectrogram.h"
+#include "SplatBinning.h"
+#include "Stats.h"
+#include "WaveMath.h"
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static void benchFFT() {
+  for (size_t n : {256u, 512u, 1024u, 2048u, 4096u}) {
+    FFT fft(n);
+    std::vector<float> signal = fixtures::whiteNoise(0.5f, n);
+    std::vector<std::complex<float>> out(n);
+    bench::run("fft/real/" + std::to_string(n), (double)n, [&] {
+      fft.forwardReal(signal.data(), out.data());
+      bench::doNotOptimize(out[1]);
+    });
+  }
+}
+
+static void benchBands() {
+  const size_t n = BandAnalyzer::BLOCK_SIZE;
+  std::vector<float> signal = fixtures::whiteNoise(0.2f, n);
+  BandAnalyzer analyzer;
+  analyzer.analyzeBlock(signal.data());
+  const std::vector<float> &mags = analyzer.magnitudes();
+
+  bench::run("bands/measure", (double)mags.size(), [&] {
+    BandLevels b = measureBands(mags.data(), mags.size());
+    bench::doNotOptimize(b);
+  });
+
+  bench::run("bands/analyze_block", (double)n, [&] {
+    analyzer.analyzeBlock(signal.data());
+    bench::doNotOptimize(analyzer.levels());
+  });
+
+  float row[SPECTRUM_BINS];
+  bench::run("bands/spectrum_row", (double)mags.size(), [&] {
+    measureSpectrum(mags.data(), mags.size(), row);
+    bench::doNotOptimize(row[0]);
+  });
+
+  // Lado CPU del espectrograma: una fila por analisis
+  SpectrogramHistory history;
+  bench::run("spectrogram/push_row", 1.0, [&] {
+    bench::doNotOptimize(history.push(row));
+  });
+
+  // 10 ms de audio a 48kHz por paquete, como un periodo WASAPI tipico
+  std::vector<float> packet = fixtures::whiteNoise(0.2f, 480);
+  bench::run("bands/push_480", 480.0, [&] {
+    analyzer.push(packet.data(), packet.size());
+    bench::doNotOptimize(analyzer.levels());
+  });
+
+  // Mismo paquete por el banco de filtros (15 actualizaciones por paquete)
+  FilterbankAnalyzer filterbank;
+  bench::run("bands/filterbank_push_480", 480.0, [&] {
+    filterbank.push(packet.data(), packet.size());
+    bench::doNotOptimize(filterbank.levels());
+  });
+}
+
+// Latencia de ataque por motor: tono tras silencio, con el inicio en 11
+// fases distintas del bloque FFT. Paquetes de un hop (32) y de un periodo
+// WASAPI (480)
+static void benchOnsetLatency() {
+  struct Case {
+    const char *name;
+    float frequency;
+    Band band;
+  };
+  for (Case c : {Case{"bass_60hz", 60.0f, Band::Bass},
+                 Case{"mids_1khz", 1000.0f, Band::Mids},
+                 Case{"treble_6khz", 6000.0f, Band::Treble}}) {
+    for (size_t chunk : {32u, 480u}) {
+      for (AnalysisEngine engine :
+           {AnalysisEngine::FFT, AnalysisEngine::Filterbank}) {
+        std::string name = std::string("onset/") + c.name + "/" +
+                           analysisEngineName(engine) + "_" +
+                           std::to_string(chunk);
+        if (!bench::enabled(name))
+          continue;
+        std::vector<double> ms;
+        for (size_t onset = 12000; onset < 12000 + 1024; onset += 101) {
+          std::vector<float> signal = fixtures::silence(onset);
+          std::vector<float> tone = fixtures::sine(c.frequency, 0.05f, 24000);
+          signal.insert(signal.end(), tone.begin(), tone.end());
+          ms.push_back((double)measureOnsetLatency(engine, signal.data(),
+                                                   signal.size(), onset,
+                                                   chunk, c.band) /
+                       48.0);
+        }
+        Distribution d = summarize(ms);
+        std::printf("%-40s %14.2f ms mean %9.2f ms max\n", name.c_str(),
+                    d.mean, d.max);
+      }
+    }
+  }
+}
+
+static void benchDownmix() {
+  const size_t frames = 480;
+  for (int channels : {2, 6}) {
+    std::vector<float> inter = fixtures::interleave(
+        fixtures::whiteNoise(0.5f, frames), channels);
+    std::vector<float> mono(frames);
+    bench::run("downmix/" + std::to_string(channels) + "ch_480",
+               (double)frames, [&] {
+                 downmixToMono(inter.data(), frames, channels, mono.data());
+                 bench::doNotOptimize(mono[0]);
+               });
+  }
+}
+
+static void benchWaves() {
+  // Mismas capas que main.cpp
+  struct Layer {
+    const char *name;
+    int size;
+    float spacing;
+  };
+  for (Layer layer : {Layer{"far", 100, 0.25f}, Layer{"main", 200, 0.03f},
+                      Layer{"near", 300, 0.015f}}) {
+    std::vector<float> grid = generateGrid(layer.size, layer.spacing);
+    size_t count = grid.size() / 2;
+    std::vector<WavePoint> out(count);
+    WaveParams params;
+    params.time = 12.5f;
+    params.gridSize = layer.size * layer.spacing;
+    params.bass = 0.6f;
+    params.mids = 0.3f;
+    bench::run(std::string("wave/cpu_") + layer.name, (double)count, [&] {
+      evaluateWaveGrid(grid.data(), count, params, out.data());
+      bench::doNotOptimize(out[count / 2]);
+    });
+  }
+
+  bench::run("grid/generate_300", 300.0 * 300.0, [&] {
+    std::vector<float> grid = generateGrid(300, 0.015f);
+    bench::doNotOptimize(grid[0]);
+  });
+}
+
+// Coste CPU del binning por tiles (referencia del camino en compute)
+static void benchSplatBinning() {
+  struct Resolution {
+    const char *name;
+    int width, height;
+  };
+  for (Resolution res : {Resolution{"1080p", 1920, 1080},
+                         Resolution{"4K", 3840, 2160}}) {
+    const size_t count = 140000;
+    std::vector<float> r = fixtures::whiteNoise(1.0f, count * 3, 7);
+    std::vector<Splat> splats(count);
+    for (size_t i = 0; i < count; i++) {
+      splats[i].x = (r[3 * i] * 0.5f + 0.5f) * res.width;
+      splats[i].y = (r[3 * i + 1] * 0.5f + 0.5f) * res.height;
+      splats[i].size = 2.0f + (r[3 * i + 2] * 0.5f + 0.5f) * 14.0f;
+    }
+    TileGrid grid = makeTileGrid(res.width, res.height);
+    TileBins bins;
+    bench::run(std::string("splat/bin_140k_") + res.name, (double)count, [&] {
+      binSplats(splats.data(), count, res.width, res.height, grid, bins);
+      bench::doNotOptimize(bins.indices.size());
+    });
+  }
+}
+
+// Coste de publicar y de leer un AudioFrame (por renderer, por frame)
+static void benchAnalysisRing() {
+  const uint32_t capacity = 256;
+  std::vector<std::max_align_t> memory(
+      AnalysisRing::bytesFor(capacity) / sizeof(std::max_align_t) + 8);
+  // Cabecera y slots alineados a linea de cache
+  void *base = reinterpret_cast<void *>(
+      (reinterpret_cast<uintptr_t>(memory.data()) + 63) & ~uintptr_t(63));
+  AnalysisRing::format(base, AnalysisRing::bytesFor(capacity), capacity);
+  AnalysisRingWriter writer(base);
+  AnalysisRingReader reader(base);
+  AudioFrame frame;
+  frame.bass = 0.5f;
+
+  bench::run("ring/publish", 1.0, [&] {
+    bench::doNotOptimize(writer.publish(frame));
+  });
+  bench::run("ring/read_latest", 1.0, [&] {
+    AudioFrame out;
+    reader.readLatest(out);
+    bench::doNotOptimize(out.bass);
+  });
+}
+
+// Contabilidad del hilo de captura por paquete (dentro del tiempo real)
+static void benchCadence() {
+  CadenceMonitor monitor(10.0);
+  uint64_t now = 1;
+  bench::run("cadence/wake_work", 1.0, [&] {
+    monitor.wake(now += 10000000);
+    monitor.workDone(now + 50000);
+  });
+  bench::run("cadence/report_2048", 2048.0, [&] {
+    bench::doNotOptimize(monitor.report().jitterMs.p99);
+  });
+}
+
+// Renderer CPU: ruido de la nebulosa, bloom, combine y un frame completo
+static void benchSoftRenderer() {
+  F4 x(0.1f, 0.2f, 0.3f, 0.4f), y(0.5f), z(-0.7f);
+  bench::run("soft/simplex_noise_x4", 4.0, [&] {
+    F4 n = simplexNoise(x, y, z);
+    bench::doNotOptimize(n);
+    x = x + F4(0.001f);
+  });
+
+  ThreadPool pool(1);
+  FloatImage scene, ping, pong;
+  scene.resize(1280, 720);
+  std::vector<float> r = fixtures::whiteNoise(1.0f, scene.pixels.size(), 3);
+  for (size_t i = 0; i < r.size(); i++)
+    scene.pixels[i] = r[i] * r[i] * 4.0f;
+  bench::run("soft/blur_pass_720p", 1280.0 * 720.0, [&] {
+    blurPass(scene, ping, true, pool);
+    bench::doNotOptimize(ping.pixels[0]);
+  });
+  std::vector<uint8_t> rgb;
+  bench::run("soft/combine_720p", 1280.0 * 720.0, [&] {
+    combineImage(scene, scene, 0.9f, rgb, pool);
+    bench::doNotOptimize(rgb[0]);
+  });
+
+  // Frame completo en un hilo (escena de RenderBench)
+  SoftRenderer renderer(640, 360, 1);
+  renderer.setNebulaScale(2);
+  SoftFrame frame;
+  frame.time = 10.0f;
+  frame.bass = 0.5f;
+  frame.mids = 0.3f;
+  frame.treble = 0.4f;
+  bench::run("soft/frame_360p_1thread", 1.0, [&] {
+    renderer.render(frame);
+    bench::doNotOptimize(renderer.image()[0]);
+  });
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1)
+    bench::filter() = argv[1];
+
+  benchFFT();
+  benchBands();
+  benchOnsetLatency();
+  benchDownmix();
+  benchWaves();
+  benchSplatBinning();
+  benchAnalysisRing();
+  benchCadence();
+  benchSoftRenderer();
+  return 0;
+}
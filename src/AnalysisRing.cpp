@@ -0,0 +1,121 @@
+#include "AnalysisRing.h"
+
+#include <cstring>
+#include <new>
+
+using analysis_ring::Header;
+using analysis_ring::Slot;
+
+static_assert(sizeof(Slot) % 64 == 0, "slots start on a cache line");
+
+// Slots justo despues de la cabecera (ambos alineados a 64)
+static Slot *slotsOf(void *memory) {
+  return reinterpret_cast<Slot *>(static_cast<char *>(memory) +
+                                  sizeof(Header));
+}
+
+static const Slot *slotsOf(const void *memory) {
+  return reinterpret_cast<const Slot *>(static_cast<const char *>(memory) +
+                                        sizeof(Header));
+}
+
+size_t AnalysisRing::bytesFor(uint32_t capacity) {
+  return sizeof(Header) + (size_t)capacity * sizeof(Slot);
+}
+
+bool AnalysisRing::format(void *memory, size_t bytes, uint32_t capacity) {
+  if (!memory || capacity == 0 || bytes < bytesFor(capacity))
+    return false;
+
+  Header *header = new (memory) Header;
+  header->magic = analysis_ring::MAGIC;
+  header->version = analysis_ring::VERSION;
+  header->capacity = capacity;
+  header->slotSize = (uint32_t)sizeof(Slot);
+  header->published.store(0, std::memory_order_relaxed);
+
+  Slot *slots = slotsOf(memory);
+  for (uint32_t i = 0; i < capacity; i++) {
+    Slot *slot = new (&slots[i]) Slot;
+    slot->stamp.store(0, std::memory_order_relaxed);
+    slot->frame = AudioFrame();
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  return true;
+}
+
+bool AnalysisRing::validate(const void *memory, size_t bytes) {
+  if (!memory || bytes < sizeof(Header))
+    return false;
+  const Header *header = static_cast<const Header *>(memory);
+  return header->magic == analysis_ring::MAGIC &&
+         header->version == analysis_ring::VERSION &&
+         header->slotSize == sizeof(Slot) && header->capacity > 0 &&
+         bytes >= bytesFor(header->capacity);
+}
+
+AnalysisRingWriter::AnalysisRingWriter(void *memory)
+    : header(static_cast<Header *>(memory)), slots(slotsOf(memory)) {
+  next = header->published.load(std::memory_order_relaxed) + 1;
+}
+
+uint64_t AnalysisRingWriter::publish(const AudioFrame &frame) {
+  const uint64_t sequence = next++;
+  Slot &slot = slots[(sequence - 1) % header->capacity];
+
+  // Impar: slot en escritura. Los lectores que lo vean reintentan
+  slot.stamp.store(2 * sequence - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  AudioFrame copy = frame;
+  copy.sequence = sequence;
+  std::memcpy(&slot.frame, &copy, sizeof(AudioFrame));
+
+  slot.stamp.store(2 * sequence, std::memory_order_release);
+  header->published.store(sequence, std::memory_order_release);
+  return sequence;
+}
+
+AnalysisRingReader::AnalysisRingReader(const void *memory)
+    : header(static_cast<const Header *>(memory)), slots(slotsOf(memory)) {}
+
+uint64_t AnalysisRingReader::latestSequence() const {
+  if (!header)
+    return 0;
+  return header->published.load(std::memory_order_acquire);
+}
+
+RingRead AnalysisRingReader::read(uint64_t sequence, AudioFrame &out) const {
+  if (!header || sequence == 0)
+    return RingRead::NotYet;
+  const Slot &slot = slots[(sequence - 1) % header->capacity];
+  const uint64_t complete = 2 * sequence;
+
+  uint64_t before = slot.stamp.load(std::memory_order_acquire);
+  if (before > complete)
+    return RingRead::Overwritten;
+  if (before < complete)
+    return RingRead::NotYet; // Incluye 2*seq-1: el escritor esta en el slot
+
+  AudioFrame copy;
+  std::memcpy(&copy, &slot.frame, sizeof(AudioFrame));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint64_t after = slot.stamp.load(std::memory_order_relaxed);
+  if (after != before)
+    return RingRead::Overwritten; // Sobrescrito durante la copia
+
+  out = copy;
+  return RingRead::Ok;
+}
+
+bool AnalysisRingReader::readLatest(AudioFrame &out) const {
+  // Solo falla si el escritor da la vuelta completa al ring durante la
+  // copia; se reintenta con la nueva ultima secuencia
+  for (;;) {
+    uint64_t sequence = latestSequence();
+    if (sequence == 0)
+      return false;
+    if (read(sequence, out) == RingRead::Ok)
+      return true;
+  }
+}
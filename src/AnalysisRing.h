@@ -0,0 +1,88 @@
+#pragma once
+/*
+ * AnalysisRing - Ring lock-free de AudioFrame (un escritor, N lectores)
+ * Opera sobre un bloque de memoria cualquiera (heap o memoria compartida).
+ * Cada slot es un seqlock: los lectores nunca bloquean al escritor y
+ * detectan si el frame que leian fue sobrescrito.
+ */
+
+#include "AudioFrame.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "AnalysisRing needs lock-free 64-bit atomics across processes");
+
+namespace analysis_ring {
+
+constexpr uint32_t MAGIC = 0x4E474152; // "NGAR"
+constexpr uint32_t VERSION = 2; // 2: fila de espectro en AudioFrame
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t capacity;
+  uint32_t slotSize;
+  alignas(64) std::atomic<uint64_t> published; // Ultima secuencia completa
+};
+
+// stamp = 2*seq - 1 mientras se escribe seq, 2*seq cuando esta completo
+struct alignas(64) Slot {
+  std::atomic<uint64_t> stamp;
+  AudioFrame frame;
+};
+
+} // namespace analysis_ring
+
+class AnalysisRing {
+public:
+  static size_t bytesFor(uint32_t capacity);
+
+  // Inicializa cabecera y slots (solo el escritor, antes de publicar)
+  static bool format(void *memory, size_t bytes, uint32_t capacity);
+
+  // Comprueba magic/version/tamaño antes de leer
+  static bool validate(const void *memory, size_t bytes);
+};
+
+class AnalysisRingWriter {
+public:
+  AnalysisRingWriter() = default;
+  explicit AnalysisRingWriter(void *memory);
+
+  // Asigna la siguiente secuencia y publica; devuelve la secuencia
+  uint64_t publish(const AudioFrame &frame);
+
+private:
+  analysis_ring::Header *header = nullptr;
+  analysis_ring::Slot *slots = nullptr;
+  uint64_t next = 1;
+};
+
+enum class RingRead {
+  Ok,
+  NotYet,     // Aun no publicado
+  Overwritten // El escritor ya dio la vuelta al ring
+};
+
+class AnalysisRingReader {
+public:
+  AnalysisRingReader() = default;
+  explicit AnalysisRingReader(const void *memory);
+
+  uint64_t latestSequence() const;
+
+  // Frame con secuencia exacta (para seguir todos los frames en orden)
+  RingRead read(uint64_t sequence, AudioFrame &out) const;
+
+  // Ultimo frame completo; false si aun no hay ninguno
+  bool readLatest(AudioFrame &out) const;
+
+  uint32_t capacity() const { return header ? header->capacity : 0; }
+
+private:
+  const analysis_ring::Header *header = nullptr;
+  const analysis_ring::Slot *slots = nullptr;
+};
@@ -1,39 +1,16 @@
 #include "AudioCapture.h"
-#include <complex>
-#include <iostream>
-#include <vector>
-
-const double PI = 3.141592653589793238460;
-
-// Simple FFT implementation
-typedef std::complex<double> Complex;
-typedef std::vector<Complex> CArray;
-
-void fft(CArray &x) {
-  const size_t N = x.size();
-  if (N <= 1)
-    return;
-
-  // slice not supports std::vector directly, manual split
-  CArray even(N / 2);
-  CArray odd(N / 2);
 
-  for (size_t i = 0; i < N / 2; ++i) {
-    even[i] = x[2 * i];
-    odd[i] = x[2 * i + 1];
-  }
+#include "BandAnalyzer.h"
 
-  fft(even);
-  fft(odd);
+#include <algorithm>
+#include <iostream>
 
-  for (size_t k = 0; k < N / 2; ++k) {
-    Complex t = std::polar(1.0, -2 * PI * k / N) * odd[k];
-    x[k] = even[k] + t;
-    x[k + N / 2] = even[k] - t;
-  }
-}
+// Buffer compartido de 1 s: margen de sobra si el hilo se retrasa
+constexpr REFERENCE_TIME CAPTURE_BUFFER_DURATION = 10000000;
 
-AudioCapture::AudioCapture() {}
+AudioCapture::AudioCapture(const RealtimeOptions &realtime,
+                           AnalysisEngine engine)
+    : realtime(realtime), analyzer(createBandEngine(engine)) {}
 
 AudioCapture::~AudioCapture() { stop(); }
 
@@ -56,19 +33,42 @@ void AudioCapture::stop() {
   }
 }
 
+AudioFrame AudioCapture::latest() const {
+  std::lock_guard<std::mutex> lock(dataMutex);
+  return published;
+}
+
+bool AudioCapture::cadence(CadenceReport &out) const {
+  out = cadenceMonitor.report();
+  return true;
+}
+
 float AudioCapture::getBass() const {
   std::lock_guard<std::mutex> lock(dataMutex);
-  return smoothBass;
+  return published.bass;
 }
 
 float AudioCapture::getMids() const {
   std::lock_guard<std::mutex> lock(dataMutex);
-  return smoothMids;
+  return published.mids;
 }
 
 float AudioCapture::getTreble() const {
   std::lock_guard<std::mutex> lock(dataMutex);
-  return smoothTreble;
+  return published.treble;
+}
+
+void AudioCapture::publish(uint32_t flags) {
+  BandLevels levels = analyzer->levels();
+  std::lock_guard<std::mutex> lock(dataMutex);
+  published.sequence++;
+  published.timestampNs = monotonicNowNs();
+  published.bass = levels.bass;
+  published.mids = levels.mids;
+  published.treble = levels.treble;
+  published.flags = flags;
+  std::copy(analyzer->spectrum(), analyzer->spectrum() + SPECTRUM_BINS,
+            published.spectrum);
 }
 
 void AudioCapture::captureLoop() {
@@ -76,6 +76,11 @@ void AudioCapture::captureLoop() {
   if (FAILED(hr))
     return;
 
+  // MMCSS y afinidad para todo el bucle; se deshace al salir
+  RealtimeScope realtimeScope(realtime);
+  if (!realtimeScope.describe().empty())
+    std::cout << "Audio thread: " << realtimeScope.describe() << std::endl;
+
   hr = CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL,
                         __uuidof(IMMDeviceEnumerator),
                         (void **)&deviceEnumerator);
@@ -93,11 +98,24 @@ void AudioCapture::captureLoop() {
     hr = audioClient->GetMixFormat(&waveFormat);
   }
 
+  REFERENCE_TIME devicePeriod = 100000; // 10 ms si el driver no lo dice
+  if (SUCCEEDED(hr)) {
+    audioClient->GetDevicePeriod(&devicePeriod, nullptr);
+    packetEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    if (!packetEvent)
+      hr = HRESULT_FROM_WIN32(GetLastError());
+  }
+
   if (SUCCEEDED(hr)) {
-    // Inicializar en modo LOOPBACK
-    hr = audioClient->Initialize(AUDCLNT_SHAREMODE_SHARED,
-                                 AUDCLNT_STREAMFLAGS_LOOPBACK, 10000000, 0,
-                                 waveFormat, nullptr);
+    // LOOPBACK dirigido por eventos: WASAPI señala packetEvent cada periodo
+    hr = audioClient->Initialize(
+        AUDCLNT_SHAREMODE_SHARED,
+        AUDCLNT_STREAMFLAGS_LOOPBACK | AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+        CAPTURE_BUFFER_DURATION, 0, waveFormat, nullptr);
+  }
+
+  if (SUCCEEDED(hr)) {
+    hr = audioClient->SetEventHandle(packetEvent);
   }
 
   if (SUCCEEDED(hr)) {
@@ -110,12 +128,29 @@ void AudioCapture::captureLoop() {
   } else {
     std::cerr << "Failed to initialize WASAPI loopback: " << hr << std::endl;
     running = false;
+    if (packetEvent)
+      CloseHandle(packetEvent);
+    packetEvent = nullptr;
     CoUninitialize();
     return;
   }
 
+  // Sin render activo el loopback no entrega paquetes y el evento no llega
+  // (y antes de Windows 10 no se señala nunca en loopback): la espera vence
+  // a los dos periodos y se vacia el buffer igualmente
+  const double periodMs = (double)devicePeriod / 10000.0;
+  const DWORD waitMs = (DWORD)std::max(1.0, 2.0 * periodMs);
+  cadenceMonitor.setPeriod(periodMs);
+
   UINT32 packetLength = 0;
   while (running) {
+    DWORD wait = WaitForSingleObject(packetEvent, waitMs);
+    bool woken = wait == WAIT_OBJECT_0;
+    if (woken)
+      cadenceMonitor.wake(monotonicNowNs());
+    else
+      cadenceMonitor.timeout();
+
     hr = captureClient->GetNextPacketSize(&packetLength);
 
     while (packetLength != 0) {
@@ -128,41 +163,31 @@ void AudioCapture::captureLoop() {
       if (FAILED(hr))
         break;
 
+      if (flags & AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY)
+        cadenceMonitor.discontinuity(); // El buffer se desbordo
+
       if (flags & AUDCLNT_BUFFERFLAGS_SILENT) {
         // Silence detected: Decay values to zero to prevent "stuck" high volume
-        std::lock_guard<std::mutex> lock(dataMutex);
-        smoothBass *= 0.9f;
-        smoothMids *= 0.9f;
-        smoothTreble *= 0.9f;
+        analyzer->decaySilence();
+        publish(AUDIO_FRAME_SILENT);
       } else {
         // Float stereo loopback format assumed
         float *pFloatData = (float *)pData;
-        size_t samplesToProcess = 1024;
-
-        static std::vector<float> fftBuffer;
 
         // Downmix to mono and accumulate
-        int channels = waveFormat->nChannels;
-        for (UINT32 i = 0; i < numFramesAvailable; i++) {
-          float sample = 0;
-          for (int c = 0; c < channels; c++) {
-            sample += pFloatData[i * channels + c];
-          }
-          sample /= channels;
-          fftBuffer.push_back(sample);
-
-          if (fftBuffer.size() >= samplesToProcess) {
-            applyFFT(fftBuffer.data(), samplesToProcess);
-            fftBuffer.clear();
-          }
-        }
+        monoBuffer.resize(numFramesAvailable);
+        downmixToMono(pFloatData, numFramesAvailable, waveFormat->nChannels,
+                      monoBuffer.data());
+        if (analyzer->push(monoBuffer.data(), numFramesAvailable) > 0)
+          publish(0);
       }
 
       captureClient->ReleaseBuffer(numFramesAvailable);
       captureClient->GetNextPacketSize(&packetLength);
     }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (woken)
+      cadenceMonitor.workDone(monotonicNowNs());
   }
 
   audioClient->Stop();
@@ -176,73 +201,9 @@ void AudioCapture::captureLoop() {
     device->Release();
   if (deviceEnumerator)
     deviceEnumerator->Release();
+  if (packetEvent)
+    CloseHandle(packetEvent);
+  packetEvent = nullptr;
 
   CoUninitialize();
 }
-
-void AudioCapture::applyFFT(const float *data, size_t samples) {
-  if (samples == 0)
-    return;
-
-  // Preparar datos complejos para FFT
-  CArray complexData(samples);
-  for (size_t i = 0; i < samples; ++i) {
-    complexData[i] = Complex(data[i], 0);
-  }
-
-  // Ejecutar FFT
-  fft(complexData);
-
-  // Analyze bands
-  // Bin width = 46.8 Hz (at 48kHz sample rate, N=1024)
-
-  float currentBass = 0.0f;
-  float currentMids = 0.0f;
-  float currentTreble = 0.0f;
-
-  // Approximate bins
-  // Bass: 0 - 5 (0 - ~250Hz)
-  // Mids: 6 - 40 (~250Hz - ~2000Hz)
-  // Treble: 41 - 250 (~2000Hz - ~12000Hz)
-
-  for (size_t i = 0; i < samples / 2; ++i) {
-    float magnitude = std::abs(complexData[i]);
-
-    if (i > 0 && i <= 5)
-      currentBass += magnitude;
-    else if (i > 5 && i <= 40)
-      currentMids += magnitude;
-    else if (i > 40 && i < 250)
-      currentTreble += magnitude;
-  }
-
-  // Normalize values (empirical)
-  // Increased divisors to prevent saturation at 100% volume
-  currentBass /= 150.0f;
-  currentMids /= 250.0f;
-  currentTreble /= 400.0f;
-
-  // Clamp 0-1
-  currentBass = std::min(1.0f, currentBass);
-  currentMids = std::min(1.0f, currentMids);
-  currentTreble = std::min(1.0f, currentTreble);
-
-  // Update thread-safe values with smoothing
-  std::lock_guard<std::mutex> lock(dataMutex);
-
-  // Fast attack, slow decay
-  if (currentBass > smoothBass)
-    smoothBass = currentBass;
-  else
-    smoothBass += (currentBass - smoothBass) * SMOOTHING;
-
-  if (currentMids > smoothMids)
-    smoothMids = currentMids;
-  else
-    smoothMids += (currentMids - smoothMids) * SMOOTHING;
-
-  if (currentTreble > smoothTreble)
-    smoothTreble = currentTreble;
-  else
-    smoothTreble += (currentTreble - smoothTreble) * SMOOTHING;
-}
@@ -6,22 +6,36 @@
 
 #define NOMINMAX
 
+#include "AudioSource.h"
+#include "BandEngine.h"
+#include "CaptureCadence.h"
+#include "RealtimeThread.h"
+
 #include <atomic>
 #include <audioclient.h>
 #include <cmath>
+#include <memory>
 #include <mmdeviceapi.h>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include <windows.h>
 
-class AudioCapture {
+class AudioCapture : public AudioSource {
 public:
-  AudioCapture();
+  explicit AudioCapture(const RealtimeOptions &realtime = RealtimeOptions(),
+                        AnalysisEngine engine = AnalysisEngine::FFT);
   ~AudioCapture();
 
   bool initialize();
-  void start();
-  void stop();
+  void start() override;
+  void stop() override;
+
+  // Ultimo analisis con secuencia y timestamp
+  AudioFrame latest() const override;
+
+  // Intervalo entre paquetes, jitter y overruns del hilo de captura
+  bool cadence(CadenceReport &out) const override;
 
   // Valores normalizados 0.0 - 1.0, suavizados
   float getBass() const;
@@ -30,8 +44,7 @@ public:
 
 private:
   void captureLoop();
-  void processAudioData(const float *data, size_t samples);
-  void applyFFT(const float *data, size_t samples);
+  void publish(uint32_t flags);
 
   // WASAPI
   IMMDeviceEnumerator *deviceEnumerator = nullptr;
@@ -39,21 +52,19 @@ private:
   IAudioClient *audioClient = nullptr;
   IAudioCaptureClient *captureClient = nullptr;
   WAVEFORMATEX *waveFormat = nullptr;
+  HANDLE packetEvent = nullptr; // Señalado por WASAPI en cada periodo
 
-  // Thread
+  // Thread (MMCSS "Pro Audio" mientras dura captureLoop)
   std::thread captureThread;
   std::atomic<bool> running{false};
+  RealtimeOptions realtime;
+  CadenceMonitor cadenceMonitor;
+
+  // Analisis (solo lo toca el hilo de captura)
+  std::unique_ptr<BandEngine> analyzer; // FFT o filterbank
+  std::vector<float> monoBuffer;
 
   // Audio analysis results (thread-safe)
   mutable std::mutex dataMutex;
-  float bass = 0.0f;
-  float mids = 0.0f;
-  float treble = 0.0f;
-
-  // Smoothing
-  float smoothBass = 0.0f;
-  float smoothMids = 0.0f;
-  float smoothTreble = 0.0f;
-  static constexpr float SMOOTHING =
-      0.15f; // Slower decay for smoother fade-out
+  AudioFrame published;
 };
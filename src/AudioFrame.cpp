@@ -0,0 +1,9 @@
+#include "AudioFrame.h"
+
+#include <chrono>
+
+int64_t monotonicNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
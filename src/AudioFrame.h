@@ -0,0 +1,28 @@
+#pragma once
+/*
+ * AudioFrame - Instantanea de un analisis publicado
+ * POD de tamaño fijo: se copia tal cual a memoria compartida
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+// Bins log-espaciados de cada fila del espectrograma (~47 Hz - 12 kHz)
+constexpr size_t SPECTRUM_BINS = 64;
+
+enum AudioFrameFlags : uint32_t {
+  AUDIO_FRAME_SILENT = 1u << 0, // Paquete marcado como silencio
+};
+
+struct AudioFrame {
+  uint64_t sequence = 0;   // 1, 2, 3... (0 = aun no hay datos)
+  int64_t timestampNs = 0; // Reloj monotono al terminar el analisis
+  float bass = 0.0f;
+  float mids = 0.0f;
+  float treble = 0.0f;
+  uint32_t flags = 0;
+  float spectrum[SPECTRUM_BINS] = {}; // Normalizado 0-1, mismo suavizado
+};
+
+// Reloj monotono en ns (steady_clock; compartido entre procesos en Linux)
+int64_t monotonicNowNs();
@@ -0,0 +1,28 @@
+#pragma once
+/*
+ * AudioSource - Origen de analisis de audio para el renderer
+ * Captura local (WASAPI), servidor de analisis en memoria compartida, ...
+ */
+
+#include "AudioFrame.h"
+#include "CaptureCadence.h"
+
+class AudioSource {
+public:
+  virtual ~AudioSource() = default;
+
+  virtual void start() {}
+  virtual void stop() {}
+
+  // Ultimo analisis publicado (sequence 0 si aun no hay datos)
+  virtual AudioFrame latest() const = 0;
+
+  // Ritmo del hilo de captura; false si la fuente no tiene hilo propio
+  virtual bool cadence(CadenceReport &) const { return false; }
+};
+
+// Sin dispositivo: todas las bandas a cero
+class SilentAudioSource : public AudioSource {
+public:
+  AudioFrame latest() const override { return AudioFrame(); }
+};
@@ -0,0 +1,180 @@
+#include "BandAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+
+void downmixToMono(const float *interleaved, size_t frames, int channels,
+                   float *mono) {
+  if (channels == 1) {
+    std::copy(interleaved, interleaved + frames, mono);
+    return;
+  }
+  if (channels == 2) {
+    // Caso comun (loopback estereo): sin bucle interno
+    for (size_t i = 0; i < frames; i++) {
+      mono[i] = (interleaved[2 * i] + interleaved[2 * i + 1]) * 0.5f;
+    }
+    return;
+  }
+  const float inv = 1.0f / (float)channels;
+  for (size_t i = 0; i < frames; i++) {
+    float sample = 0;
+    for (int c = 0; c < channels; c++) {
+      sample += interleaved[i * channels + c];
+    }
+    mono[i] = sample * inv;
+  }
+}
+
+float syntheticMusicSample(uint64_t index, int sampleRate) {
+  double t = (double)index / sampleRate;
+  double beat = std::fmod(t, 0.5);
+  double kick = std::exp(-beat * 12.0) * std::sin(2.0 * M_PI * 60.0 * t);
+  double pad = 0.15 * std::sin(2.0 * M_PI * 1000.0 * t);
+  // Hi-hat en las corcheas; el resto es sin signo: restar ya en int64_t
+  int64_t noise = (int64_t)((index * 2654435761u >> 7) % 2001) - 1000;
+  double hat =
+      std::exp(-std::fmod(t, 0.25) * 60.0) * (double)noise / 1000.0;
+  return (float)(0.6 * kick + pad + 0.2 * hat);
+}
+
+BandLevels measureBands(const float *magnitudes, size_t bins) {
+  // Bin width = 46.8 Hz (at 48kHz sample rate, N=1024)
+  // Approximate bins
+  // Bass: 0 - 5 (0 - ~250Hz)
+  // Mids: 6 - 40 (~250Hz - ~2000Hz)
+  // Treble: 41 - 250 (~2000Hz - ~12000Hz)
+  BandLevels current;
+  for (size_t i = 1; i < bins && i < 250; ++i) {
+    if (i <= 5)
+      current.bass += magnitudes[i];
+    else if (i <= 40)
+      current.mids += magnitudes[i];
+    else
+      current.treble += magnitudes[i];
+  }
+
+  // Normalize values (empirical)
+  // Increased divisors to prevent saturation at 100% volume
+  current.bass = std::min(1.0f, current.bass / 150.0f);
+  current.mids = std::min(1.0f, current.mids / 250.0f);
+  current.treble = std::min(1.0f, current.treble / 400.0f);
+  return current;
+}
+
+// Escala por bin FFT: ajuste potencial de los divisores de measureBands
+// repartidos por bin (bass ~30 en el bin 3, mids ~7 en el 23, treble ~1.9
+// en el 145)
+static float spectrumReference(float bin) {
+  return 30.0f * std::pow(bin / 3.0f, -0.71f);
+}
+
+namespace {
+// Rangos de bins FFT por banda log (1 - 250) y su escala, calculados una vez
+struct SpectrumLayout {
+  size_t begin[SPECTRUM_BINS];
+  size_t end[SPECTRUM_BINS];
+  float lo[SPECTRUM_BINS];
+  float hi[SPECTRUM_BINS];
+  float scale[SPECTRUM_BINS]; // 1 / (bins * referencia)
+
+  SpectrumLayout() {
+    const float first = 1.0f, last = 250.0f;
+    for (size_t k = 0; k < SPECTRUM_BINS; k++) {
+      float lo = first * std::pow(last / first, (float)k / SPECTRUM_BINS);
+      float hi = first * std::pow(last / first, (float)(k + 1) / SPECTRUM_BINS);
+      this->lo[k] = lo;
+      this->hi[k] = hi;
+      // Bandas graves mas estrechas que un bin: repiten el bin que las contiene
+      begin[k] = (size_t)lo;
+      end[k] = std::max(begin[k] + 1, (size_t)hi);
+      scale[k] = 1.0f / ((float)(end[k] - begin[k]) *
+                         spectrumReference(0.5f * (lo + hi)));
+    }
+  }
+};
+const SpectrumLayout spectrumLayout;
+} // namespace
+
+SpectrumBand spectrumBand(size_t k) {
+  return {spectrumLayout.lo[k], spectrumLayout.hi[k], spectrumLayout.scale[k]};
+}
+
+void measureSpectrum(const float *magnitudes, size_t bins, float *row) {
+  for (size_t k = 0; k < SPECTRUM_BINS; k++) {
+    size_t end = std::min(spectrumLayout.end[k], bins);
+    float sum = 0.0f;
+    for (size_t i = spectrumLayout.begin[k]; i < end; i++)
+      sum += magnitudes[i];
+    row[k] = std::min(1.0f, sum * spectrumLayout.scale[k]);
+  }
+}
+
+static float smoothValue(float smooth, float current, float smoothing) {
+  if (current > smooth)
+    return current;
+  return smooth + (current - smooth) * smoothing;
+}
+
+void BandSmoother::update(const BandLevels &current) {
+  smooth.bass = smoothValue(smooth.bass, current.bass, SMOOTHING);
+  smooth.mids = smoothValue(smooth.mids, current.mids, SMOOTHING);
+  smooth.treble = smoothValue(smooth.treble, current.treble, SMOOTHING);
+}
+
+void BandSmoother::decay(float factor) {
+  smooth.bass *= factor;
+  smooth.mids *= factor;
+  smooth.treble *= factor;
+}
+
+BandAnalyzer::BandAnalyzer(size_t blockSize)
+    : fft(blockSize), fftOut(blockSize), mags(blockSize / 2),
+      measuredRow(SPECTRUM_BINS), spectrumRow(SPECTRUM_BINS) {
+  pending.reserve(blockSize);
+}
+
+size_t BandAnalyzer::push(const float *mono, size_t samples) {
+  const size_t block = fft.size();
+  size_t analyzed = 0;
+
+  // Bloques completos se analizan sin copia; el resto se acumula
+  while (samples > 0) {
+    if (pending.empty() && samples >= block) {
+      analyzeBlock(mono);
+      mono += block;
+      samples -= block;
+      analyzed++;
+      continue;
+    }
+    size_t take = std::min(block - pending.size(), samples);
+    pending.insert(pending.end(), mono, mono + take);
+    mono += take;
+    samples -= take;
+    if (pending.size() == block) {
+      analyzeBlock(pending.data());
+      pending.clear();
+      analyzed++;
+    }
+  }
+  return analyzed;
+}
+
+void BandAnalyzer::analyzeBlock(const float *block) {
+  fft.forwardReal(block, fftOut.data());
+  for (size_t i = 0; i < mags.size(); ++i) {
+    mags[i] = std::abs(fftOut[i]);
+  }
+  smoother.update(measureBands(mags.data(), mags.size()));
+
+  measureSpectrum(mags.data(), mags.size(), measuredRow.data());
+  for (size_t k = 0; k < SPECTRUM_BINS; k++)
+    spectrumRow[k] = smoothValue(spectrumRow[k], measuredRow[k],
+                                 BandSmoother::SMOOTHING);
+}
+
+void BandAnalyzer::decaySilence() {
+  smoother.decay();
+  for (float &v : spectrumRow)
+    v *= BandSmoother::SILENCE_DECAY;
+}
@@ -0,0 +1,86 @@
+#pragma once
+/*
+ * BandAnalyzer - Analisis de bandas (bass/mids/treble) sobre bloques FFT
+ * Independiente de la plataforma: recibe muestras mono ya mezcladas
+ */
+
+#include "AudioFrame.h"
+#include "BandEngine.h"
+#include "FFT.h"
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+// Mezcla audio intercalado (frames x channels) a mono
+void downmixToMono(const float *interleaved, size_t frames, int channels,
+                   float *mono);
+
+// Senal de prueba de neon_render sin --pcm: bombo a 120 bpm, pad de 1 kHz
+// y hi-hat de ruido determinista; muestra 'index' en [-1, 1]
+float syntheticMusicSample(uint64_t index, int sampleRate);
+
+// Suma magnitudes por banda y normaliza (empirico, 1024 muestras a 48kHz)
+BandLevels measureBands(const float *magnitudes, size_t bins);
+
+// Espectro en SPECTRUM_BINS bandas log (bins FFT 1-249, como las bandas)
+// normalizado a 0-1 con la misma escala que measureBands
+void measureSpectrum(const float *magnitudes, size_t bins, float *row);
+
+// Banda log k del espectro: bordes en bins FFT (fraccionarios) y la escala
+// por magnitud que le aplica measureSpectrum
+struct SpectrumBand {
+  float loBin;
+  float hiBin;
+  float scale;
+};
+SpectrumBand spectrumBand(size_t k);
+
+// Fast attack, slow decay
+class BandSmoother {
+public:
+  void update(const BandLevels &current);
+  // Silencio: decae hacia cero para no quedarse "pegado"
+  void decay(float factor = SILENCE_DECAY);
+  const BandLevels &levels() const { return smooth; }
+
+  static constexpr float SMOOTHING =
+      0.15f; // Slower decay for smoother fade-out
+  static constexpr float SILENCE_DECAY = 0.9f;
+
+private:
+  BandLevels smooth;
+};
+
+class BandAnalyzer : public BandEngine {
+public:
+  static constexpr size_t BLOCK_SIZE = 1024;
+
+  explicit BandAnalyzer(size_t blockSize = BLOCK_SIZE);
+
+  // Acumula muestras mono; analiza cada bloque completo.
+  // Devuelve el numero de bloques analizados.
+  size_t push(const float *mono, size_t samples) override;
+
+  // Analiza un bloque de blockSize() muestras directamente
+  void analyzeBlock(const float *block);
+
+  void decaySilence() override;
+
+  const BandLevels &levels() const override { return smoother.levels(); }
+  // Fila de espectro suavizada (SPECTRUM_BINS valores)
+  const float *spectrum() const override { return spectrumRow.data(); }
+  // Magnitudes del ultimo bloque (blockSize()/2 bins)
+  const std::vector<float> &magnitudes() const { return mags; }
+  size_t blockSize() const { return fft.size(); }
+  size_t updateInterval() const override { return fft.size(); }
+
+private:
+  FFT fft;
+  std::vector<float> pending;
+  std::vector<std::complex<float>> fftOut;
+  std::vector<float> mags;
+  BandSmoother smoother;
+  std::vector<float> measuredRow;
+  std::vector<float> spectrumRow;
+};
@@ -0,0 +1,62 @@
+#include "BandEngine.h"
+
+#include "BandAnalyzer.h"
+#include "FilterbankAnalyzer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+bool parseAnalysisEngine(const std::string &name, AnalysisEngine &engine) {
+  if (name == "fft")
+    engine = AnalysisEngine::FFT;
+  else if (name == "filterbank")
+    engine = AnalysisEngine::Filterbank;
+  else
+    return false;
+  return true;
+}
+
+const char *analysisEngineName(AnalysisEngine engine) {
+  return engine == AnalysisEngine::Filterbank ? "filterbank" : "fft";
+}
+
+std::unique_ptr<BandEngine> createBandEngine(AnalysisEngine engine) {
+  if (engine == AnalysisEngine::Filterbank)
+    return std::make_unique<FilterbankAnalyzer>();
+  return std::make_unique<BandAnalyzer>();
+}
+
+float bandLevel(const BandLevels &levels, Band band) {
+  switch (band) {
+  case Band::Bass:
+    return levels.bass;
+  case Band::Mids:
+    return levels.mids;
+  default:
+    return levels.treble;
+  }
+}
+
+size_t measureOnsetLatency(AnalysisEngine engine, const float *signal,
+                           size_t samples, size_t onset, size_t chunk,
+                           Band band) {
+  // Nivel tras cada paquete: (muestras consumidas, nivel)
+  std::unique_ptr<BandEngine> analyzer = createBandEngine(engine);
+  std::vector<std::pair<size_t, float>> trace;
+  for (size_t offset = 0; offset < samples; offset += chunk) {
+    size_t take = std::min(chunk, samples - offset);
+    analyzer->push(signal + offset, take);
+    trace.push_back({offset + take, bandLevel(analyzer->levels(), band)});
+  }
+  if (trace.empty())
+    return SIZE_MAX;
+
+  float threshold = 0.5f * trace.back().second;
+  for (const auto &point : trace) {
+    if (point.first > onset && point.second >= threshold &&
+        threshold > 0.0f)
+      return point.first - onset;
+  }
+  return SIZE_MAX;
+}
@@ -0,0 +1,58 @@
+#pragma once
+/*
+ * BandEngine - Motor de analisis de bandas, seleccionable en ejecucion
+ * FFT por bloques (BandAnalyzer) o banco de filtros IIR muestra a muestra
+ * (FilterbankAnalyzer). Mismas bandas, espectro y suavizado en ambos.
+ */
+
+#include "AudioFrame.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// Valores normalizados 0.0 - 1.0
+struct BandLevels {
+  float bass = 0.0f;
+  float mids = 0.0f;
+  float treble = 0.0f;
+};
+
+enum class AnalysisEngine {
+  FFT,       // Bloques de 1024 muestras (~21 ms a 48 kHz)
+  Filterbank // Biquads + envolventes, actualiza cada 32 muestras
+};
+
+bool parseAnalysisEngine(const std::string &name, AnalysisEngine &engine);
+const char *analysisEngineName(AnalysisEngine engine);
+
+class BandEngine {
+public:
+  virtual ~BandEngine() = default;
+
+  // Acumula muestras mono (48 kHz); devuelve cuantas actualizaciones de
+  // levels()/spectrum() produjo
+  virtual size_t push(const float *mono, size_t samples) = 0;
+
+  // Silencio: decae hacia cero para no quedarse "pegado"
+  virtual void decaySilence() = 0;
+
+  virtual const BandLevels &levels() const = 0;
+  // Fila de espectro suavizada (SPECTRUM_BINS valores)
+  virtual const float *spectrum() const = 0;
+
+  // Muestras entre actualizaciones
+  virtual size_t updateInterval() const = 0;
+};
+
+std::unique_ptr<BandEngine> createBandEngine(AnalysisEngine engine);
+
+enum class Band { Bass, Mids, Treble };
+float bandLevel(const BandLevels &levels, Band band);
+
+// Latencia de ataque: muestras desde 'onset' hasta que la banda supera la
+// mitad del nivel que alcanza al final de la señal, entregada en paquetes
+// de 'chunk' muestras (como la captura). SIZE_MAX si no llega nunca.
+size_t measureOnsetLatency(AnalysisEngine engine, const float *signal,
+                           size_t samples, size_t onset, size_t chunk,
+                           Band band);
@@ -0,0 +1,104 @@
+#include "CaptureCadence.h"
+
+#include <cmath>
+#include <cstdio>
+
+CadenceMonitor::CadenceMonitor(double periodMs, size_t window)
+    : periodMs(periodMs), ring(window > 0 ? window : 1) {
+  counters.periodMs = periodMs;
+}
+
+void CadenceMonitor::setPeriod(double ms) {
+  std::lock_guard<std::mutex> lock(mutex);
+  periodMs = ms;
+  counters.periodMs = ms;
+}
+
+void CadenceMonitor::wake(uint64_t nowNs) {
+  std::lock_guard<std::mutex> lock(mutex);
+  counters.wakeups++;
+  pendingIntervalMs = -1.0;
+  if (lastWakeNs != 0 && nowNs >= lastWakeNs) {
+    pendingIntervalMs = (double)(nowNs - lastWakeNs) * 1e-6;
+    if (pendingIntervalMs > periodMs * CADENCE_LATE_FACTOR)
+      counters.late++;
+  }
+  lastWakeNs = nowNs;
+  wakeNs = nowNs;
+}
+
+void CadenceMonitor::workDone(uint64_t nowNs) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (wakeNs == 0)
+    return;
+  double workMs = nowNs >= wakeNs ? (double)(nowNs - wakeNs) * 1e-6 : 0.0;
+  if (workMs > periodMs)
+    counters.overruns++;
+  ring[next] = {pendingIntervalMs, workMs};
+  next = (next + 1) % ring.size();
+  if (stored < ring.size())
+    stored++;
+  wakeNs = 0;
+}
+
+void CadenceMonitor::discontinuity() {
+  std::lock_guard<std::mutex> lock(mutex);
+  counters.discontinuities++;
+}
+
+void CadenceMonitor::timeout() {
+  std::lock_guard<std::mutex> lock(mutex);
+  counters.timeouts++;
+  lastWakeNs = 0;
+}
+
+CadenceReport CadenceMonitor::report() const {
+  CadenceReport out;
+  std::vector<double> interval, jitter, work;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    out = counters;
+    interval.reserve(stored);
+    work.reserve(stored);
+    for (size_t i = 0; i < stored; i++) {
+      const Sample &s = ring[i];
+      work.push_back(s.workMs);
+      if (s.intervalMs >= 0.0)
+        interval.push_back(s.intervalMs);
+    }
+  }
+  // Ordenar fuera del lock: el hilo de captura no espera al lector
+  jitter.reserve(interval.size());
+  for (double ms : interval)
+    jitter.push_back(std::fabs(ms - out.periodMs));
+  out.intervalMs = summarize(std::move(interval));
+  out.jitterMs = summarize(std::move(jitter));
+  out.workMs = summarize(std::move(work));
+  return out;
+}
+
+void CadenceMonitor::reset() {
+  std::lock_guard<std::mutex> lock(mutex);
+  next = stored = 0;
+  lastWakeNs = wakeNs = 0;
+  pendingIntervalMs = -1.0;
+  counters = CadenceReport();
+  counters.periodMs = periodMs;
+}
+
+std::string formatCadenceReport(const CadenceReport &report) {
+  char buffer[640];
+  std::snprintf(
+      buffer, sizeof(buffer),
+      "period %.2f ms, wakeups %llu late %llu overruns %llu "
+      "discontinuities %llu timeouts %llu\n"
+      "  interval ms %s\n  jitter ms   %s\n  work ms     %s\n",
+      report.periodMs, (unsigned long long)report.wakeups,
+      (unsigned long long)report.late, (unsigned long long)report.overruns,
+      (unsigned long long)report.discontinuities,
+      (unsigned long long)report.timeouts,
+      formatDistribution(report.intervalMs, 3).c_str(),
+      formatDistribution(report.jitterMs, 3).c_str(),
+      formatDistribution(report.workMs, 3).c_str());
+  return buffer;
+}
@@ -0,0 +1,66 @@
+#pragma once
+/*
+ * CaptureCadence - Ritmo del hilo de captura: intervalo entre despertares,
+ * jitter respecto al periodo del dispositivo, trabajo por paquete y
+ * contadores de retrasos, overruns y discontinuidades.
+ * Lo escribe el hilo de captura; report() se puede pedir desde cualquiera.
+ */
+
+#include "Stats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Un despertar mas tarde que periodo * LATE_FACTOR cuenta como retraso
+constexpr double CADENCE_LATE_FACTOR = 1.5;
+
+struct CadenceReport {
+  double periodMs = 0.0;
+  uint64_t wakeups = 0;
+  uint64_t late = 0;            // Intervalo > periodo * CADENCE_LATE_FACTOR
+  uint64_t overruns = 0;        // Trabajo de un despertar > periodo
+  uint64_t discontinuities = 0; // La fuente perdio datos (glitch)
+  uint64_t timeouts = 0;        // Espera sin paquete (silencio o sin evento)
+  Distribution intervalMs;      // Ultimas 'window' muestras
+  Distribution jitterMs;        // |intervalo - periodo|
+  Distribution workMs;
+};
+
+class CadenceMonitor {
+public:
+  explicit CadenceMonitor(double periodMs = 10.0, size_t window = 2048);
+
+  void setPeriod(double ms);
+
+  // Hilo de captura: el paquete llega / termina de procesarse
+  void wake(uint64_t nowNs);
+  void workDone(uint64_t nowNs);
+  void discontinuity();
+  // La espera vencio sin datos: el siguiente intervalo empieza de cero
+  void timeout();
+
+  CadenceReport report() const;
+  void reset();
+
+private:
+  struct Sample {
+    double intervalMs;
+    double workMs;
+  };
+
+  mutable std::mutex mutex;
+  double periodMs;
+  std::vector<Sample> ring; // Reservado al construir: sin heap en tiempo real
+  size_t next = 0;
+  size_t stored = 0;
+  uint64_t lastWakeNs = 0;
+  uint64_t wakeNs = 0;
+  double pendingIntervalMs = -1.0; // < 0: primer despertar tras un hueco
+  CadenceReport counters;
+};
+
+// Contadores en una linea y las tres distribuciones debajo
+std::string formatCadenceReport(const CadenceReport &report);
@@ -0,0 +1,77 @@
+#include "FFT.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+FFT::FFT(size_t size) : n(size) {
+  if (!isPowerOfTwo(size))
+    throw std::invalid_argument("FFT size must be a power of two");
+
+  // Twiddles en doble precision para no acumular error en tamaños grandes
+  const double PI = 3.141592653589793238460;
+  twiddles.resize(n / 2);
+  for (size_t k = 0; k < n / 2; ++k) {
+    double angle = -2.0 * PI * (double)k / (double)n;
+    twiddles[k] = std::complex<float>((float)std::cos(angle),
+                                      (float)std::sin(angle));
+  }
+
+  unsigned bits = 0;
+  while ((size_t(1) << bits) < n)
+    bits++;
+
+  bitReverse.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t r = 0;
+    for (unsigned b = 0; b < bits; ++b) {
+      if (i & (size_t(1) << b))
+        r |= 1u << (bits - 1 - b);
+    }
+    bitReverse[i] = r;
+  }
+}
+
+void FFT::forward(std::complex<float> *data) const {
+  for (size_t i = 0; i < n; ++i) {
+    size_t j = bitReverse[i];
+    if (i < j)
+      std::swap(data[i], data[j]);
+  }
+  butterflies(data);
+}
+
+void FFT::forwardReal(const float *input, std::complex<float> *output) const {
+  // La permutacion se aplica al copiar, sin swaps
+  for (size_t i = 0; i < n; ++i) {
+    output[bitReverse[i]] = std::complex<float>(input[i], 0.0f);
+  }
+  butterflies(output);
+}
+
+void FFT::butterflies(std::complex<float> *data) const {
+  // Acceso como pares (re, im): el estandar garantiza este layout para
+  // std::complex y evita la ruta lenta de operator* (__mulsc3)
+  float *d = reinterpret_cast<float *>(data);
+  const float *w = reinterpret_cast<const float *>(twiddles.data());
+
+  // Butterflies: en cada etapa el paso por la tabla de twiddles se reduce
+  for (size_t len = 2; len <= n; len <<= 1) {
+    size_t half = len / 2;
+    size_t stride = n / len;
+    for (size_t start = 0; start < n; start += len) {
+      float *a = d + 2 * start;
+      float *b = d + 2 * (start + half);
+      for (size_t k = 0; k < half; ++k) {
+        float wr = w[2 * k * stride];
+        float wi = w[2 * k * stride + 1];
+        float tr = wr * b[2 * k] - wi * b[2 * k + 1];
+        float ti = wr * b[2 * k + 1] + wi * b[2 * k];
+        b[2 * k] = a[2 * k] - tr;
+        b[2 * k + 1] = a[2 * k + 1] - ti;
+        a[2 * k] += tr;
+        a[2 * k + 1] += ti;
+      }
+    }
+  }
+}
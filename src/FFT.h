@@ -0,0 +1,35 @@
+#pragma once
+/*
+ * FFT - Transformada rapida de Fourier (radix-2, iterativa)
+ * El plan precalcula twiddles y la permutacion bit-reversal una sola vez
+ */
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class FFT {
+public:
+  // size debe ser potencia de 2
+  explicit FFT(size_t size);
+
+  size_t size() const { return n; }
+
+  // Transformada in-place sobre 'size' valores complejos
+  void forward(std::complex<float> *data) const;
+
+  // Entrada real, salida compleja completa (size valores)
+  void forwardReal(const float *input, std::complex<float> *output) const;
+
+  static bool isPowerOfTwo(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+  }
+
+private:
+  void butterflies(std::complex<float> *data) const;
+
+  size_t n = 0;
+  std::vector<std::complex<float>> twiddles; // n/2 factores e^(-2*pi*i*k/n)
+  std::vector<uint32_t> bitReverse;
+};
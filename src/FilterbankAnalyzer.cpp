@@ -0,0 +1,195 @@
+#include "FilterbankAnalyzer.h"
+
+#include "BandAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Ancho de un bin del analisis FFT de referencia (1024 muestras, 48 kHz)
+constexpr float FFT_BIN_HZ =
+    FilterbankAnalyzer::SAMPLE_RATE / (float)BandAnalyzer::BLOCK_SIZE;
+// Magnitud FFT de un seno de amplitud 1 centrado en un bin (N / 2)
+constexpr float FFT_TONE_GAIN = (float)BandAnalyzer::BLOCK_SIZE * 0.5f;
+
+// Evita denormales al decaer los filtros: una continua minima en la
+// entrada de cada etapa mantiene el estado lejos de cero
+constexpr float ANTI_DENORMAL = 1e-18f;
+
+// Dos paso banda iguales en cascada estrechan la banda ~0.65x: cada etapa
+// se ensancha para que el -3 dB del conjunto quede en los bordes
+constexpr double CASCADE_WIDEN = 1.55;
+
+struct BandEdges {
+  float loBin, hiBin, gain;
+};
+
+// Mismos rangos de bins que measureBands. Ganancia empirica: la FFT suma
+// magnitudes (y fugas) de todos los bins de la banda y el filtro mide un
+// pico, asi que la relacion cambia entre tonos y ruido; es la media
+// geometrica de ambas razones FFT / filtro, con los divisores de
+// measureBands
+constexpr BandEdges BASS = {0.5f, 5.5f, 4.2f};
+constexpr BandEdges MIDS = {5.5f, 40.5f, 5.0f};
+constexpr BandEdges TREBLE = {40.5f, 249.5f, 6.7f};
+
+struct Biquad {
+  double b0, b1, b2, a1, a2;
+};
+
+// RBJ Audio EQ Cookbook
+enum class Shape { LowPass, HighPass, BandPass };
+
+Biquad design(Shape shape, double hz, double octavesOrQ) {
+  double w0 = 2.0 * M_PI * hz / FilterbankAnalyzer::SAMPLE_RATE;
+  double cs = std::cos(w0), sn = std::sin(w0);
+  double alpha = shape == Shape::BandPass
+                     ? sn * std::sinh(std::log(2.0) / 2.0 * octavesOrQ * w0 /
+                                      sn)
+                     : sn / (2.0 * octavesOrQ);
+  double b0, b1, b2;
+  if (shape == Shape::LowPass) {
+    b0 = b2 = (1.0 - cs) / 2.0;
+    b1 = 1.0 - cs;
+  } else if (shape == Shape::HighPass) {
+    b0 = b2 = (1.0 + cs) / 2.0;
+    b1 = -(1.0 + cs);
+  } else { // Ganancia 0 dB en el centro
+    b0 = alpha;
+    b1 = 0.0;
+    b2 = -alpha;
+  }
+  double a0 = 1.0 + alpha;
+  return {b0 / a0, b1 / a0, b2 / a0, -2.0 * cs / a0, (1.0 - alpha) / a0};
+}
+
+} // namespace
+
+FilterbankAnalyzer::Channel FilterbankAnalyzer::channel(size_t index) {
+  // Espectro: un tono centrado da el mismo nivel que en el analisis FFT;
+  // su pico es la amplitud y su magnitud FFT, amplitud * N / 2
+  if (index < SPECTRUM_BINS) {
+    SpectrumBand band = spectrumBand(index);
+    return {band.loBin * FFT_BIN_HZ, band.hiBin * FFT_BIN_HZ,
+            FFT_TONE_GAIN * band.scale};
+  }
+  const BandEdges &edges = index == SPECTRUM_BINS       ? BASS
+                           : index == SPECTRUM_BINS + 1 ? MIDS
+                                                        : TREBLE;
+  return {edges.loBin * FFT_BIN_HZ, edges.hiBin * FFT_BIN_HZ, edges.gain};
+}
+
+FilterbankAnalyzer::FilterbankAnalyzer() {
+  // Coeficientes por canal; los canales de relleno quedan a cero
+  float c[2][5][GROUPS * 4] = {};
+  float gains[GROUPS * 4] = {};
+  for (size_t i = 0; i < CHANNELS; i++) {
+    Channel ch = channel(i);
+    Biquad first, second;
+    if (i < SPECTRUM_BINS) {
+      double octaves = std::max(std::log2((double)ch.hiHz / ch.loHz),
+                                (double)MIN_BANDWIDTH_OCTAVES);
+      first = second = design(Shape::BandPass, std::sqrt(ch.loHz * ch.hiHz),
+                              octaves * CASCADE_WIDEN);
+    } else {
+      first = design(Shape::HighPass, ch.loHz, M_SQRT1_2);
+      second = design(Shape::LowPass, ch.hiHz, M_SQRT1_2);
+    }
+    const Biquad *biquads[2] = {&first, &second};
+    for (int s = 0; s < 2; s++) {
+      c[s][0][i] = (float)biquads[s]->b0;
+      c[s][1][i] = (float)biquads[s]->b1;
+      c[s][2][i] = (float)biquads[s]->b2;
+      c[s][3][i] = (float)biquads[s]->a1;
+      c[s][4][i] = (float)biquads[s]->a2;
+    }
+    gains[i] = ch.scale;
+  }
+  for (int s = 0; s < 2; s++) {
+    for (size_t g = 0; g < GROUPS; g++) {
+      Stage &stage = stages[s][g];
+      stage.b0 = F4::load(&c[s][0][4 * g]);
+      stage.b1 = F4::load(&c[s][1][4 * g]);
+      stage.b2 = F4::load(&c[s][2][4 * g]);
+      stage.a1 = F4::load(&c[s][3][4 * g]);
+      stage.a2 = F4::load(&c[s][4][4 * g]);
+    }
+  }
+  for (size_t g = 0; g < GROUPS; g++)
+    scale[g] = F4::load(&gains[4 * g]);
+
+  // BandSmoother decae SMOOTHING por bloque de 1024: misma constante de
+  // tiempo repartida en bloques de HOP
+  decayCoeff = F4(1.0f - std::pow(1.0f - BandSmoother::SMOOTHING,
+                                  (float)HOP / BandAnalyzer::BLOCK_SIZE));
+}
+
+void FilterbankAnalyzer::filter(const float *mono, size_t samples) {
+  const F4 bias(ANTI_DENORMAL);
+  // Grupo por fuera: coeficientes y estado se quedan en registros
+  for (size_t g = 0; g < GROUPS; g++) {
+    Stage s = stages[0][g], t = stages[1][g];
+    F4 p = peak[g];
+    for (size_t i = 0; i < samples; i++) {
+      F4 x(mono[i] + ANTI_DENORMAL);
+      F4 u = madd(s.z1, s.b0, x);
+      s.z1 = s.z2 + s.b1 * x - s.a1 * u;
+      s.z2 = s.b2 * x - s.a2 * u;
+      u = u + bias;
+      F4 y = madd(t.z1, t.b0, u);
+      t.z1 = t.z2 + t.b1 * u - t.a1 * y;
+      t.z2 = t.b2 * u - t.a2 * y;
+      p = max(p, abs(y));
+    }
+    stages[0][g].z1 = s.z1;
+    stages[0][g].z2 = s.z2;
+    stages[1][g].z1 = t.z1;
+    stages[1][g].z2 = t.z2;
+    peak[g] = p;
+  }
+}
+
+void FilterbankAnalyzer::finishHop() {
+  for (size_t g = 0; g < GROUPS; g++) {
+    F4 measured = min(F4(1.0f), peak[g] * scale[g]);
+    // smoothValue sin ramas: max(medido, decaido) es ataque instantaneo
+    smooth[g] = max(measured, madd(smooth[g], measured - smooth[g],
+                                   decayCoeff));
+    peak[g] = F4();
+  }
+  publishSmoothed();
+}
+
+void FilterbankAnalyzer::publishSmoothed() {
+  alignas(16) float lanes[GROUPS * 4];
+  for (size_t g = 0; g < GROUPS; g++)
+    smooth[g].store(&lanes[4 * g]);
+  std::copy(lanes, lanes + SPECTRUM_BINS, spectrumRow);
+  current.bass = lanes[SPECTRUM_BINS];
+  current.mids = lanes[SPECTRUM_BINS + 1];
+  current.treble = lanes[SPECTRUM_BINS + 2];
+}
+
+size_t FilterbankAnalyzer::push(const float *mono, size_t samples) {
+  size_t hops = 0;
+  while (samples > 0) {
+    size_t take = std::min(HOP - hopFill, samples);
+    filter(mono, take);
+    mono += take;
+    samples -= take;
+    hopFill += take;
+    if (hopFill == HOP) {
+      finishHop();
+      hopFill = 0;
+      hops++;
+    }
+  }
+  return hops;
+}
+
+void FilterbankAnalyzer::decaySilence() {
+  for (size_t g = 0; g < GROUPS; g++)
+    smooth[g] = smooth[g] * F4(BandSmoother::SILENCE_DECAY);
+  publishSmoothed();
+}
@@ -0,0 +1,64 @@
+#pragma once
+/*
+ * FilterbankAnalyzer - Analisis de bandas en el dominio del tiempo
+ * Banco de filtros IIR de 4o orden (dos biquads RBJ en cascada) con un
+ * seguidor de envolvente por banda: pico rectificado de cada HOP muestras y el mismo
+ * ataque instantaneo / decaimiento SMOOTHING que BandSmoother, escalado a
+ * la duracion del hop. Cuatro bandas por instruccion (F4).
+ * Responde a un ataque en ~1 ms en vez de esperar un bloque FFT completo.
+ */
+
+#include "BandEngine.h"
+#include "Simd.h"
+
+#include <cstddef>
+
+class FilterbankAnalyzer : public BandEngine {
+public:
+  static constexpr size_t HOP = 32; // 0.67 ms a 48 kHz
+  static constexpr float SAMPLE_RATE = 48000.0f;
+  // Bandas del espectro mas estrechas que esto resuenan demasiado
+  static constexpr float MIN_BANDWIDTH_OCTAVES = 0.25f;
+
+  FilterbankAnalyzer();
+
+  size_t push(const float *mono, size_t samples) override;
+  void decaySilence() override;
+
+  const BandLevels &levels() const override { return current; }
+  const float *spectrum() const override { return spectrumRow; }
+  size_t updateInterval() const override { return HOP; }
+
+  // Canal del banco: SPECTRUM_BINS bandas del espectro (dos paso banda
+  // iguales) y luego bass, mids y treble (paso alto en loHz + paso bajo en
+  // hiHz, Butterworth)
+  struct Channel {
+    float loHz;
+    float hiHz;
+    float scale; // Pico de la envolvente -> nivel 0-1
+  };
+  static constexpr size_t CHANNELS = SPECTRUM_BINS + 3;
+  static Channel channel(size_t index);
+
+private:
+  static constexpr size_t GROUPS = (CHANNELS + 3) / 4;
+
+  void filter(const float *mono, size_t samples);
+  void finishHop();
+  void publishSmoothed(); // smooth -> levels() y spectrum()
+
+  // Biquad en forma directa II transpuesta, 4 canales por F4
+  struct Stage {
+    F4 b0, b1, b2, a1, a2; // Normalizados por a0
+    F4 z1, z2;
+  };
+  Stage stages[2][GROUPS];
+  F4 scale[GROUPS];
+  F4 peak[GROUPS];   // Pico |y| del hop en curso
+  F4 smooth[GROUPS]; // Envolvente suavizada (0-1)
+  F4 decayCoeff;     // SMOOTHING equivalente por hop
+  size_t hopFill = 0;
+
+  BandLevels current;
+  float spectrumRow[SPECTRUM_BINS] = {};
+};
@@ -0,0 +1,76 @@
+#include "FrameGraph.h"
+
+#include "PostProcess.h"
+#include "WaveLayers.h"
+
+#include <string>
+
+FrameGraphTargets declareFrameGraph(RenderGraph &graph,
+                                    const FrameGraphSettings &settings,
+                                    const FrameGraphCallbacks &callbacks) {
+  FrameGraphTargets targets;
+  TargetDesc hdr;
+  hdr.width = settings.width;
+  hdr.height = settings.height;
+  hdr.format = TargetFormat::RGBA16F;
+  targets.scene = graph.createTarget("scene", hdr);
+  targets.bloom[0] = graph.createTarget("bloom_a", hdr);
+  targets.bloom[1] = graph.createTarget("bloom_b", hdr);
+  targets.backbuffer = graph.importTarget("backbuffer", true);
+
+  size_t nebula = graph.addPass("nebula", callbacks.nebula);
+  graph.write(nebula, targets.scene);
+
+  // Blend aditivo: leen y escriben la escena
+  size_t stars = graph.addPass("stars", callbacks.stars);
+  graph.read(stars, targets.scene);
+  graph.write(stars, targets.scene);
+  graph.setContributes(stars, settings.stars);
+
+  if (settings.splat) {
+    size_t splat = graph.addPass("waves_splat", callbacks.splat);
+    graph.read(splat, targets.scene);
+    graph.write(splat, targets.scene);
+    graph.setContributes(splat, settings.waves);
+  } else {
+    for (size_t i = 0; i < WAVE_LAYER_COUNT; i++) {
+      std::function<void()> fn;
+      if (callbacks.waves)
+        fn = [&callbacks, i] { callbacks.waves(i); };
+      size_t layer =
+          graph.addPass(std::string("waves_") + WAVE_LAYERS[i].name, fn);
+      graph.read(layer, targets.scene);
+      graph.write(layer, targets.scene);
+      graph.setContributes(layer,
+                           settings.waves && WAVE_LAYERS[i].intensity > 0.0f);
+    }
+  }
+
+  // Blur separable: H(scene -> a), V(a -> b), y luego H(b -> a), V(a -> b)
+  bool bloomOn = settings.bloomStrength > 0.0f;
+  ResourceHandle from = targets.scene;
+  for (int i = 0; i < BLOOM_ITERATIONS; i++) {
+    for (int horizontal = 1; horizontal >= 0; horizontal--) {
+      ResourceHandle to = targets.bloom[horizontal ? 0 : 1];
+      std::function<void()> fn;
+      if (callbacks.blur)
+        fn = [&callbacks, from, to, horizontal] {
+          callbacks.blur(from, to, horizontal == 1);
+        };
+      size_t blur = graph.addPass(
+          std::string(horizontal ? "blur_h" : "blur_v") + std::to_string(i),
+          fn);
+      graph.read(blur, from);
+      graph.write(blur, to);
+      graph.setContributes(blur, bloomOn);
+      from = to;
+    }
+  }
+  targets.bloomResult = from;
+
+  size_t combine = graph.addPass("combine", callbacks.combine);
+  graph.read(combine, targets.scene);
+  graph.read(combine, targets.bloomResult);
+  graph.write(combine, targets.backbuffer);
+  return targets;
+}
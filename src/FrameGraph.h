@@ -0,0 +1,46 @@
+#pragma once
+/*
+ * FrameGraph - Las pasadas del frame de main.cpp sobre RenderGraph
+ * nebula -> stars -> waves (3 capas o splat) -> blur H/V x BLOOM_ITERATIONS
+ * -> combine. La declaracion es portable; main.cpp pone el GL en los
+ * callbacks y los tests comprueban orden y memoria sin contexto.
+ */
+
+#include "RenderGraph.h"
+
+#include <cstddef>
+#include <functional>
+
+struct FrameGraphSettings {
+  int width = 1280;
+  int height = 720;
+  bool splat = false;         // Una pasada de compute para las tres capas
+  float bloomStrength = 1.0f; // 0: blur descartado, combine sin bloom
+  // Recursos aun cargando en el arranque: sus pasadas no aportan
+  bool stars = true;
+  bool waves = true;
+};
+
+struct FrameGraphTargets {
+  ResourceHandle scene = 0;
+  ResourceHandle bloom[2] = {0, 0}; // Ping-pong del blur
+  ResourceHandle backbuffer = 0;
+  ResourceHandle bloomResult = 0; // El que lee combine
+};
+
+// Callbacks vacios (tests) dejan la pasada sin trabajo. Las pasadas
+// guardan referencias: tienen que vivir mientras se ejecute el grafo
+struct FrameGraphCallbacks {
+  std::function<void()> nebula; // Limpia la escena y pinta el fondo
+  std::function<void()> stars;
+  std::function<void(size_t layer)> waves;
+  std::function<void()> splat;
+  // Una pasada de blur: 'from' -> 'to'
+  std::function<void(ResourceHandle from, ResourceHandle to, bool horizontal)>
+      blur;
+  std::function<void()> combine;
+};
+
+FrameGraphTargets declareFrameGraph(RenderGraph &graph,
+                                    const FrameGraphSettings &settings,
+                                    const FrameGraphCallbacks &callbacks);
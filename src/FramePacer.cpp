@@ -0,0 +1,161 @@
+#include "FramePacer.h"
+
+#include <glad/glad.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <thread>
+
+// Recalibrar el reloj de GPU de vez en cuando (deriva entre relojes)
+static constexpr int CALIBRATE_EVERY = 240;
+
+static double nsToMs(int64_t ns) { return (double)ns / 1e6; }
+
+// sleep_for tiene granularidad de ~1 ms (15 ms en Windows sin
+// timeBeginPeriod): dormir hasta cerca y terminar cediendo el hilo
+static void sleepUntilNs(int64_t targetNs) {
+  const int64_t spinNs = 2000000;
+  int64_t now = monotonicNowNs();
+  if (targetNs - now > spinNs)
+    std::this_thread::sleep_for(
+        std::chrono::nanoseconds(targetNs - now - spinNs));
+  while (monotonicNowNs() < targetNs)
+    std::this_thread::yield();
+}
+
+FramePacer::FramePacer() {
+  for (PendingFrame &frame : pending) {
+    glGenQueries(1, &frame.elapsedQuery);
+    glGenQueries(1, &frame.doneQuery);
+  }
+}
+
+FramePacer::~FramePacer() {
+  drainFences(0);
+  for (PendingFrame &frame : pending) {
+    glDeleteQueries(1, &frame.elapsedQuery);
+    glDeleteQueries(1, &frame.doneQuery);
+  }
+}
+
+void FramePacer::configure(GLFWwindow *window, const PacingConfig &config) {
+  drainFences(0);
+  current = config;
+  current.framesInFlight = clampFramesInFlight(config.framesInFlight);
+  if (current.swapInterval >= 0)
+    glfwSwapInterval(current.swapInterval);
+
+  GLFWmonitor *monitor = glfwGetWindowMonitor(window);
+  if (!monitor)
+    monitor = glfwGetPrimaryMonitor();
+  const GLFWvidmode *mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+  int refresh = mode && mode->refreshRate > 0 ? mode->refreshRate : 60;
+  int interval = current.swapInterval > 0 ? current.swapInterval : 1;
+  scheduler = DeadlineScheduler(1000.0 * interval / refresh, current.marginMs);
+
+  calibrateIn = 0;
+  lastPresentNs = 0;
+}
+
+void FramePacer::drainFences(int keep) {
+  while (fenceCount > keep) {
+    glClientWaitSync(fences[0], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+    glDeleteSync(fences[0]);
+    for (int i = 1; i < fenceCount; i++)
+      fences[i - 1] = fences[i];
+    fenceCount--;
+  }
+}
+
+void FramePacer::calibrateClock() {
+  GLint64 gpuNow = 0;
+  glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+  gpuToCpuNs = monotonicNowNs() - (int64_t)gpuNow;
+  calibrateIn = CALIBRATE_EVERY;
+}
+
+void FramePacer::beginFrame() {
+  if (calibrateIn-- <= 0)
+    calibrateClock();
+
+  // Con N en vuelo, el frame actual espera a que termine el de hace N
+  if (current.framesInFlight > 0)
+    drainFences(current.framesInFlight - 1);
+
+  if (current.deadlineSleep && lastPresentNs != 0) {
+    int64_t now = monotonicNowNs();
+    double sleep = scheduler.sleepMs(nsToMs(lastPresentNs), nsToMs(now));
+    if (sleep > 0.0)
+      sleepUntilNs(now + (int64_t)(sleep * 1e6));
+  }
+
+  frameStartNs = monotonicNowNs();
+
+  // Sin slot libre (cola mas profunda que QUERY_SLOTS) no se mide
+  frameSlot = -1;
+  if (!pending[nextSlot].active) {
+    frameSlot = nextSlot;
+    nextSlot = (nextSlot + 1) % QUERY_SLOTS;
+    pending[frameSlot].active = true;
+    glBeginQuery(GL_TIME_ELAPSED, pending[frameSlot].elapsedQuery);
+  }
+}
+
+void FramePacer::audioSampled(const AudioFrame &frame) {
+  int64_t now = monotonicNowNs();
+  sampledNs = now;
+  if (frame.sequence != 0)
+    recorded.audioAgeMs.push_back(nsToMs(now - frame.timestampNs));
+}
+
+void FramePacer::endFrame() {
+  if (frameSlot < 0)
+    return;
+  glEndQuery(GL_TIME_ELAPSED);
+  // En modo default el audio se lee antes de beginFrame
+  pending[frameSlot].sampledNs = sampledNs;
+}
+
+void FramePacer::afterSwap() {
+  int64_t now = monotonicNowNs();
+  scheduler.recordCpu(nsToMs(now - frameStartNs));
+  if (lastPresentNs != 0)
+    recorded.frameMs.push_back(nsToMs(now - lastPresentNs));
+  lastPresentNs = now;
+
+  if (frameSlot >= 0)
+    glQueryCounter(pending[frameSlot].doneQuery, GL_TIMESTAMP);
+
+  if (current.framesInFlight > 0) {
+    fences[fenceCount++] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+  }
+
+  collectQueries();
+}
+
+void FramePacer::collectQueries() {
+  for (PendingFrame &frame : pending) {
+    if (!frame.active)
+      continue;
+    GLint available = 0;
+    glGetQueryObjectiv(frame.doneQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+      continue;
+
+    GLuint64 elapsed = 0, done = 0;
+    glGetQueryObjectui64v(frame.elapsedQuery, GL_QUERY_RESULT, &elapsed);
+    glGetQueryObjectui64v(frame.doneQuery, GL_QUERY_RESULT, &done);
+    double gpuMs = nsToMs((int64_t)elapsed);
+    scheduler.recordGpu(gpuMs);
+    recorded.gpuMs.push_back(gpuMs);
+    recorded.latencyMs.push_back(
+        nsToMs((int64_t)done + gpuToCpuNs - frame.sampledNs));
+    frame.active = false;
+  }
+}
+
+std::string FramePacer::report() const {
+  return formatPacingReport(current.mode, recorded);
+}
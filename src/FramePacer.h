@@ -0,0 +1,78 @@
+#pragma once
+/*
+ * FramePacer - Aplica un PacingConfig al bucle de render
+ * Fences para limitar frames en vuelo, queries de GPU para el
+ * planificador por deadline y muestras de latencia por modo
+ */
+
+#include "AudioFrame.h"
+#include "FramePacing.h"
+
+#include <cstdint>
+#include <string>
+
+struct GLFWwindow;
+typedef struct __GLsync *GLsync;
+
+class FramePacer {
+public:
+  FramePacer();
+  ~FramePacer();
+  FramePacer(const FramePacer &) = delete;
+  FramePacer &operator=(const FramePacer &) = delete;
+
+  // Aplica swap interval y refresco del monitor; vacia la cola previa
+  void configure(GLFWwindow *window, const PacingConfig &config);
+  const PacingConfig &config() const { return current; }
+  // Periodo de refresco * swap interval (60 Hz si no se conoce)
+  double periodMs() const { return scheduler.period(); }
+
+  // Espera fences (frames en vuelo) y duerme hasta el deadline
+  void beginFrame();
+
+  // Momento en que se leyo el analisis que usara este frame
+  void audioSampled(const AudioFrame &frame);
+
+  // Justo antes y justo despues de glfwSwapBuffers
+  void endFrame();
+  void afterSwap();
+
+  // Tras una pausa del bucle (modo idle): el siguiente present no cuenta
+  // como frame ni sirve de referencia al deadline
+  void resume() { lastPresentNs = 0; }
+
+  const PacingSamples &samples() const { return recorded; }
+  void resetSamples() { recorded.clear(); }
+  std::string report() const;
+
+private:
+  static constexpr int QUERY_SLOTS = 8;
+
+  struct PendingFrame {
+    unsigned int elapsedQuery = 0;
+    unsigned int doneQuery = 0; // GL_TIMESTAMP tras el swap
+    int64_t sampledNs = 0;
+    bool active = false;
+  };
+
+  void drainFences(int keep);
+  void collectQueries();
+  void calibrateClock();
+
+  PacingConfig current;
+  DeadlineScheduler scheduler;
+
+  GLsync fences[MAX_FRAMES_IN_FLIGHT + 1] = {};
+  int fenceCount = 0;
+
+  PendingFrame pending[QUERY_SLOTS];
+  int frameSlot = -1;    // Slot del frame en curso (-1 sin medir)
+  int nextSlot = 0;
+  int64_t gpuToCpuNs = 0; // Reloj GL_TIMESTAMP -> monotonicNowNs
+  int calibrateIn = 0;
+
+  int64_t frameStartNs = 0;
+  int64_t sampledNs = 0; // Ultima lectura del analisis
+  int64_t lastPresentNs = 0;
+  PacingSamples recorded;
+};
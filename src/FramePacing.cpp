@@ -0,0 +1,100 @@
+#include "FramePacing.h"
+
+#include <algorithm>
+#include <cstdio>
+
+PacingConfig pacingPreset(PacingMode mode) {
+  PacingConfig config;
+  config.mode = mode;
+  if (mode == PacingMode::Default)
+    return config;
+
+  config.swapInterval = 1;
+  config.framesInFlight = 1;
+  config.lateAudio = true;
+  config.deadlineSleep = mode == PacingMode::Deadline;
+  return config;
+}
+
+bool parsePacingMode(const std::string &name, PacingMode &mode) {
+  if (name == "default")
+    mode = PacingMode::Default;
+  else if (name == "low-latency")
+    mode = PacingMode::LowLatency;
+  else if (name == "deadline")
+    mode = PacingMode::Deadline;
+  else
+    return false;
+  return true;
+}
+
+const char *pacingModeName(PacingMode mode) {
+  switch (mode) {
+  case PacingMode::LowLatency:
+    return "low-latency";
+  case PacingMode::Deadline:
+    return "deadline";
+  default:
+    return "default";
+  }
+}
+
+int clampFramesInFlight(int frames) {
+  if (frames <= 0)
+    return 0;
+  return std::min(frames, MAX_FRAMES_IN_FLIGHT);
+}
+
+RollingEstimate::RollingEstimate(size_t window, double percentile)
+    : window(window), percentile(percentile) {}
+
+void RollingEstimate::add(double value) {
+  samples.push_back(value);
+  if (samples.size() > window)
+    samples.pop_front();
+}
+
+double RollingEstimate::estimate() const {
+  std::vector<double> sorted(samples.begin(), samples.end());
+  std::sort(sorted.begin(), sorted.end());
+  return percentileSorted(sorted, percentile);
+}
+
+DeadlineScheduler::DeadlineScheduler(double periodMs, double marginMs)
+    : periodMs(periodMs), marginMs(marginMs) {}
+
+double DeadlineScheduler::sleepMs(double lastPresentMs, double nowMs) const {
+  double work = cpu.estimate() + gpu.estimate() + marginMs;
+  double start = lastPresentMs + periodMs - work;
+  return std::max(0.0, start - nowMs);
+}
+
+void PacingSamples::clear() {
+  frameMs.clear();
+  latencyMs.clear();
+  audioAgeMs.clear();
+  gpuMs.clear();
+}
+
+std::string formatPacingReport(PacingMode mode,
+                               const PacingSamples &samples) {
+  struct Row {
+    const char *name;
+    const std::vector<double> &values;
+  };
+  const Row rows[] = {{"frame", samples.frameMs},
+                      {"latency", samples.latencyMs},
+                      {"audio age", samples.audioAgeMs},
+                      {"gpu", samples.gpuMs}};
+
+  std::string report;
+  char line[256];
+  for (const Row &row : rows) {
+    Distribution d = summarize(row.values);
+    std::snprintf(line, sizeof(line), "%-12s %-10s %s\n",
+                  pacingModeName(mode), row.name,
+                  d.count ? formatDistribution(d, 2).c_str() : "n/a");
+    report += line;
+  }
+  return report;
+}
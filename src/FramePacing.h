@@ -0,0 +1,90 @@
+#pragma once
+/*
+ * FramePacing - Modos de ritmo de frame y planificador por deadline
+ * Politica portable (sin GL); FramePacer la aplica con fences y queries
+ */
+
+#include "Stats.h"
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+enum class PacingMode {
+  Default,    // Lo que haga el driver (comportamiento original)
+  LowLatency, // Swap interval 1, 1 frame en vuelo, audio leido tarde
+  Deadline    // LowLatency + dormir hasta justo antes del deadline
+};
+
+constexpr int MAX_FRAMES_IN_FLIGHT = 3;
+
+struct PacingConfig {
+  PacingMode mode = PacingMode::Default;
+  int swapInterval = -1;   // -1: no tocar el del driver
+  int framesInFlight = 0;  // 0: sin limite (cola del driver), 1-3 con fences
+  bool lateAudio = false;  // Leer el analisis tras las esperas, no antes
+  bool deadlineSleep = false;
+  double marginMs = 1.0;   // Holgura sobre CPU + GPU estimados
+};
+
+PacingConfig pacingPreset(PacingMode mode);
+bool parsePacingMode(const std::string &name, PacingMode &mode);
+const char *pacingModeName(PacingMode mode);
+
+// 0 = sin limite; el resto se limita a 1..MAX_FRAMES_IN_FLIGHT
+int clampFramesInFlight(int frames);
+
+// Percentil alto de las ultimas N muestras (estimacion de coste del frame)
+class RollingEstimate {
+public:
+  explicit RollingEstimate(size_t window = 60, double percentile = 90.0);
+
+  void add(double value);
+  double estimate() const;
+  size_t size() const { return samples.size(); }
+
+private:
+  size_t window;
+  double percentile;
+  std::deque<double> samples;
+};
+
+// Empieza el frame lo mas tarde posible para terminar antes del vblank:
+// inicio = ultimo present + periodo - (CPU + GPU + margen)
+class DeadlineScheduler {
+public:
+  explicit DeadlineScheduler(double periodMs = 1000.0 / 60.0,
+                             double marginMs = 1.0);
+
+  void setPeriod(double ms) { periodMs = ms; }
+  void setMargin(double ms) { marginMs = ms; }
+  double period() const { return periodMs; }
+
+  void recordCpu(double ms) { cpu.add(ms); }
+  void recordGpu(double ms) { gpu.add(ms); }
+  double cpuEstimateMs() const { return cpu.estimate(); }
+  double gpuEstimateMs() const { return gpu.estimate(); }
+
+  // Cuanto dormir ahora (mismo reloj para lastPresentMs y nowMs)
+  double sleepMs(double lastPresentMs, double nowMs) const;
+
+private:
+  double periodMs;
+  double marginMs;
+  RollingEstimate cpu;
+  RollingEstimate gpu;
+};
+
+// Muestras de un modo: frame = present a present, latency = lectura del
+// audio -> GPU termina el frame, audioAge = analisis -> lectura
+struct PacingSamples {
+  std::vector<double> frameMs;
+  std::vector<double> latencyMs;
+  std::vector<double> audioAgeMs;
+  std::vector<double> gpuMs;
+
+  void clear();
+};
+
+std::string formatPacingReport(PacingMode mode, const PacingSamples &samples);
@@ -0,0 +1,11 @@
+#pragma once
+/*
+ * GlmTransform - Paso de las matrices del nucleo (Transform.h) a glm
+ */
+
+#include "Transform.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+inline glm::mat4 toGlm(const Mat4 &m) { return glm::make_mat4(m.m); }
@@ -0,0 +1,17 @@
+#include "GpuTimer.h"
+
+#include <glad/glad.h>
+
+GpuTimer::GpuTimer() { glGenQueries(1, &query); }
+
+GpuTimer::~GpuTimer() { glDeleteQueries(1, &query); }
+
+void GpuTimer::begin() { glBeginQuery(GL_TIME_ELAPSED, query); }
+
+void GpuTimer::end() { glEndQuery(GL_TIME_ELAPSED); }
+
+double GpuTimer::elapsedMs() const {
+  GLuint64 ns = 0;
+  glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+  return (double)ns / 1e6;
+}
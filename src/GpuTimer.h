@@ -0,0 +1,21 @@
+#pragma once
+/*
+ * GpuTimer - Medicion de tiempo de GPU con GL_TIME_ELAPSED
+ */
+
+class GpuTimer {
+public:
+  GpuTimer();
+  ~GpuTimer();
+  GpuTimer(const GpuTimer &) = delete;
+  GpuTimer &operator=(const GpuTimer &) = delete;
+
+  void begin();
+  void end();
+
+  // Espera al resultado de la ultima medicion (bloquea)
+  double elapsedMs() const;
+
+private:
+  unsigned int query = 0;
+};
@@ -0,0 +1,16 @@
+#include "Grid.h"
+
+#include <cstddef>
+
+std::vector<float> generateGrid(int size, float spacing) {
+  std::vector<float> vertices;
+  vertices.reserve((size_t)size * size * 2);
+  float offset = (size - 1) * spacing / 2.0f;
+  for (int z = 0; z < size; z++) {
+    for (int x = 0; x < size; x++) {
+      vertices.push_back(x * spacing - offset);
+      vertices.push_back(z * spacing - offset);
+    }
+  }
+  return vertices;
+}
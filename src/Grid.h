@@ -0,0 +1,8 @@
+#pragma once
+/*
+ * Grid - Rejillas de particulas (pares x, z centrados en el origen)
+ */
+
+#include <vector>
+
+std::vector<float> generateGrid(int size, float spacing);
@@ -0,0 +1,180 @@
+#include "IdleThrottle.h"
+
+#include <algorithm>
+#include <cstdio>
+
+IdleThrottle::IdleThrottle(const IdleConfig &config) : settings(config) {}
+
+void IdleThrottle::audio(const AudioFrame &frame, double nowMs) {
+  // Un analisis repetido no es actividad: si la fuente deja de publicar,
+  // el ultimo nivel se quedaria "pegado" para siempre
+  if (frame.sequence == 0 || frame.sequence == lastSequence)
+    return;
+  lastSequence = frame.sequence;
+  float level = std::max(frame.bass, std::max(frame.mids, frame.treble));
+  if (level <= settings.silenceLevel)
+    return;
+  lastActivityMs = nowMs;
+  if (idling && !woken) {
+    // La latencia de despertar cuenta desde que termino el analisis
+    woken = true;
+    activityAtMs =
+        frame.timestampNs > 0 ? std::min(nowMs, frame.timestampNs / 1e6)
+                              : nowMs;
+  }
+}
+
+void IdleThrottle::input(double nowMs) {
+  lastActivityMs = nowMs;
+  if (idling && !woken) {
+    woken = true;
+    activityAtMs = nowMs;
+  }
+}
+
+void IdleThrottle::enterIdle(double nowMs) {
+  totals.activeMs += nowMs - segmentStartMs;
+  segmentStartMs = nowMs;
+  idling = true;
+  nebulaValid = false;
+  nextIdleFrameMs = nowMs; // El primer frame idle llena la cache
+}
+
+void IdleThrottle::leaveIdle(double nowMs) {
+  totals.idleMs += nowMs - segmentStartMs;
+  segmentStartMs = nowMs;
+  idling = false;
+  woken = false;
+  nebulaValid = false;
+  totals.wakes++;
+  totals.maxWakeMs = std::max(totals.maxWakeMs, nowMs - activityAtMs);
+}
+
+IdleAction IdleThrottle::next(double nowMs) {
+  IdleAction action = decide(nowMs);
+  resumedRender = action == IdleAction::Render && lastAction != action;
+  lastAction = action;
+  return action;
+}
+
+IdleAction IdleThrottle::decide(double nowMs) {
+  if (idling && woken)
+    leaveIdle(nowMs);
+  if (!idling) {
+    if (!enabled() || nowMs - lastActivityMs < settings.enterAfterMs) {
+      presentPending = false; // El frame completo ya redibuja
+      totals.activeFrames++;
+      return IdleAction::Render;
+    }
+    enterIdle(nowMs);
+  }
+
+  if (nowMs >= nextIdleFrameMs) {
+    // Cadencia fija; si el bucle se retrasa no se encadenan frames
+    nextIdleFrameMs += 1000.0 / settings.idleFps;
+    if (nextIdleFrameMs <= nowMs)
+      nextIdleFrameMs = nowMs + 1000.0 / settings.idleFps;
+    presentPending = false;
+    totals.idleFrames++;
+    return IdleAction::IdleFrame;
+  }
+  if (presentPending) {
+    presentPending = false;
+    totals.presents++;
+    return IdleAction::Present;
+  }
+  return IdleAction::Wait;
+}
+
+double IdleThrottle::waitMs(double nowMs) const {
+  if (!idling)
+    return 0.0;
+  return std::clamp(nextIdleFrameMs - nowMs, 0.0, settings.activePeriodMs);
+}
+
+bool IdleThrottle::refreshNebula(double nowMs) {
+  if (nebulaValid && nowMs - nebulaDrawnMs < settings.nebulaRefreshMs) {
+    totals.nebulaReuses++;
+    return false;
+  }
+  nebulaValid = true;
+  nebulaDrawnMs = nowMs;
+  return true;
+}
+
+void IdleThrottle::recordCpu(IdleAction action, double ms) {
+  Cost &cost = action == IdleAction::Render ? activeCpu : idleCpu;
+  cost.sum += ms;
+  cost.count++;
+}
+
+void IdleThrottle::recordGpu(IdleAction action, double ms) {
+  Cost &cost = action == IdleAction::Render ? activeGpu : idleGpu;
+  cost.sum += ms;
+  cost.count++;
+}
+
+IdleReport IdleThrottle::report(double nowMs) const {
+  IdleReport out = totals;
+  if (idling)
+    out.idleMs += nowMs - segmentStartMs;
+  else
+    out.activeMs += nowMs - segmentStartMs;
+
+  out.activeCpuMs = activeCpu.mean();
+  out.idleCpuMs = idleCpu.mean();
+  out.gpuMeasured = activeGpu.count > 0;
+  out.activeGpuMs = activeGpu.mean();
+  out.idleGpuMs = idleGpu.mean();
+
+  // Frames que se habrian dibujado en idle al ritmo medido fuera de idle
+  double period = out.activeFrames > 0 && out.activeMs > 0.0
+                      ? out.activeMs / out.activeFrames
+                      : settings.activePeriodMs;
+  double skipped = out.idleMs / period;
+  // Sin frames normales medidos no hay con que comparar
+  if (activeCpu.count > 0)
+    out.savedCpuMs = skipped * out.activeCpuMs - idleCpu.sum;
+  if (out.gpuMeasured)
+    out.savedGpuMs = skipped * out.activeGpuMs - idleGpu.sum;
+  return out;
+}
+
+void IdleThrottle::reset(double nowMs) {
+  totals = IdleReport();
+  activeCpu = activeGpu = idleCpu = idleGpu = Cost();
+  idling = woken = presentPending = nebulaValid = resumedRender = false;
+  lastAction = IdleAction::Render;
+  lastActivityMs = segmentStartMs = nowMs;
+}
+
+std::string formatIdleReport(const IdleReport &report) {
+  char gpu[96] = "gpu n/a";
+  if (report.gpuMeasured)
+    std::snprintf(gpu, sizeof(gpu), "gpu %.2f / %.2f ms", report.activeGpuMs,
+                  report.idleGpuMs);
+  // gpuMeasured implica frames normales (las queries son del pacer)
+  char saved[96] = "n/a";
+  if (report.gpuMeasured)
+    std::snprintf(saved, sizeof(saved), "cpu %.2f s gpu %.2f s",
+                  report.savedCpuMs / 1000.0, report.savedGpuMs / 1000.0);
+  else if (report.activeFrames > 0 && report.activeCpuMs > 0.0)
+    std::snprintf(saved, sizeof(saved), "cpu %.2f s",
+                  report.savedCpuMs / 1000.0);
+
+  char buffer[640];
+  std::snprintf(
+      buffer, sizeof(buffer),
+      "idle %.1f s of %.1f s, wakes %llu (max %.2f ms)\n"
+      "  frames: active %llu idle %llu presents %llu nebula reuses %llu\n"
+      "  cost per frame active / idle: cpu %.2f / %.2f ms, %s\n"
+      "  saved: %s\n",
+      report.idleMs / 1000.0, (report.activeMs + report.idleMs) / 1000.0,
+      (unsigned long long)report.wakes, report.maxWakeMs,
+      (unsigned long long)report.activeFrames,
+      (unsigned long long)report.idleFrames,
+      (unsigned long long)report.presents,
+      (unsigned long long)report.nebulaReuses, report.activeCpuMs,
+      report.idleCpuMs, gpu, saved);
+  return buffer;
+}
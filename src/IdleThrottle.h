@@ -0,0 +1,119 @@
+#pragma once
+/*
+ * IdleThrottle - Modo idle del bucle de render
+ * Sin audio por encima del umbral ni entrada durante enterAfterMs, dibuja a
+ * idleFps con la nebulosa cacheada y espera eventos entre frames; vuelve a
+ * ritmo normal en cuanto hay actividad (como mucho un periodo despues).
+ * Politica portable (sin GL); main.cpp la aplica y le pasa los costes.
+ */
+
+#include "AudioFrame.h"
+
+#include <cstdint>
+#include <string>
+
+struct IdleConfig {
+  double idleFps = 5.0;         // 0 = sin modo idle
+  double enterAfterMs = 5000.0; // Silencio + entrada quieta antes de entrar
+  float silenceLevel = 0.02f;   // Bandas por debajo de esto = silencio
+  // La nebulosa sin audio solo deriva (t * 0.1): se redibuja con esta
+  // cadencia y el resto de frames idle copian la cacheada
+  double nebulaRefreshMs = 1000.0;
+  // Periodo de un frame a ritmo normal; tambien la rodaja maxima de espera
+  // en idle, para notar el audio (que no genera eventos) a tiempo
+  double activePeriodMs = 1000.0 / 60.0;
+};
+
+enum class IdleAction {
+  Render,    // Frame completo a ritmo normal
+  IdleFrame, // Frame completo a ritmo idle (nebulosa cacheada)
+  Present,   // Solo combine: escena y bloom del ultimo frame
+  Wait       // Nada que dibujar: esperar eventos durante waitMs()
+};
+
+struct IdleReport {
+  double activeMs = 0.0;
+  double idleMs = 0.0;
+  uint64_t activeFrames = 0;
+  uint64_t idleFrames = 0;
+  uint64_t presents = 0;     // Redibujados solo con combine (expose)
+  uint64_t nebulaReuses = 0; // Frames idle que copiaron la nebulosa
+  uint64_t wakes = 0;        // Salidas de idle
+  double maxWakeMs = 0.0;    // Actividad -> primer frame a ritmo normal
+  // Coste medio por frame
+  bool gpuMeasured = false; // Sin queries de GPU los campos gpu quedan a 0
+  double activeCpuMs = 0.0;
+  double activeGpuMs = 0.0;
+  double idleCpuMs = 0.0; // Frames idle y presents
+  double idleGpuMs = 0.0;
+  // Frente a dibujar el tiempo idle a ritmo normal
+  double savedCpuMs = 0.0;
+  double savedGpuMs = 0.0;
+};
+
+class IdleThrottle {
+public:
+  explicit IdleThrottle(const IdleConfig &config = IdleConfig());
+
+  const IdleConfig &config() const { return settings; }
+  bool enabled() const { return settings.idleFps > 0.0; }
+  bool idle() const { return idling; }
+
+  // Actividad: analisis nuevo con alguna banda sobre el umbral, o cualquier
+  // evento de entrada. Mismo reloj (ms) que monotonicNowNs() / 1e6
+  void audio(const AudioFrame &frame, double nowMs);
+  void input(double nowMs);
+  // La ventana pide redibujar (expose) sin que cambie la escena
+  void requestPresent() { presentPending = true; }
+
+  // Que hacer en esta vuelta del bucle
+  IdleAction next(double nowMs);
+  // El ultimo next() fue el primer Render tras vueltas que no pasan por el
+  // pacer (idle, present, espera): su present a present no es un frame
+  bool resumed() const { return resumedRender; }
+  // Cuanto esperar eventos tras un Wait (<= activePeriodMs)
+  double waitMs(double nowMs) const;
+
+  // En un IdleFrame: true si toca redibujar la nebulosa cacheada. La cache
+  // se invalida al salir de idle (y con invalidateCache, p.ej. resize)
+  bool refreshNebula(double nowMs);
+  void invalidateCache() { nebulaValid = false; }
+
+  // Coste del frame dibujado con 'action' (GPU puede llegar mas tarde)
+  void recordCpu(IdleAction action, double ms);
+  void recordGpu(IdleAction action, double ms);
+
+  IdleReport report(double nowMs) const;
+  void reset(double nowMs);
+
+private:
+  struct Cost {
+    double sum = 0.0;
+    uint64_t count = 0;
+    double mean() const { return count ? sum / count : 0.0; }
+  };
+
+  IdleAction decide(double nowMs);
+  void enterIdle(double nowMs);
+  void leaveIdle(double nowMs);
+
+  IdleConfig settings;
+  bool idling = false;
+  bool presentPending = false;
+  bool nebulaValid = false;
+  IdleAction lastAction = IdleAction::Render;
+  bool resumedRender = false;
+  double lastActivityMs = 0.0;
+  double activityAtMs = 0.0; // Origen de la actividad que despierta
+  bool woken = false;
+  double segmentStartMs = 0.0;
+  double nextIdleFrameMs = 0.0;
+  double nebulaDrawnMs = 0.0;
+  uint64_t lastSequence = 0;
+
+  IdleReport totals;
+  Cost activeCpu, activeGpu, idleCpu, idleGpu;
+};
+
+// Contadores, coste medio por frame y tiempo ahorrado (varias lineas)
+std::string formatIdleReport(const IdleReport &report);
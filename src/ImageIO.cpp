@@ -0,0 +1,50 @@
+#include "ImageIO.h"
+
+#include <iostream>
+
+bool writePPM(std::FILE *file, int width, int height,
+              const std::vector<uint8_t> &rgb) {
+  if (!file || rgb.size() < (size_t)width * height * 3)
+    return false;
+  std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+  size_t bytes = (size_t)width * height * 3;
+  return std::fwrite(rgb.data(), 1, bytes, file) == bytes;
+}
+
+bool writePPM(const std::string &path, int width, int height,
+              const std::vector<uint8_t> &rgb) {
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    std::cerr << "ImageIO: cannot write " << path << std::endl;
+    return false;
+  }
+  bool ok = writePPM(file, width, height, rgb);
+  ok = std::fclose(file) == 0 && ok;
+  if (!ok)
+    std::cerr << "ImageIO: short write to " << path << std::endl;
+  return ok;
+}
+
+bool readPPM(const std::string &path, int &width, int &height,
+             std::vector<uint8_t> &rgb) {
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  if (!file) {
+    std::cerr << "ImageIO: cannot open " << path << std::endl;
+    return false;
+  }
+  int maxValue = 0;
+  // fgetc consume el separador unico entre la cabecera y los datos
+  bool ok = std::fscanf(file, "P6 %d %d %d", &width, &height, &maxValue) ==
+                3 &&
+            std::fgetc(file) != EOF && width > 0 && height > 0 &&
+            maxValue == 255;
+  if (ok) {
+    rgb.resize((size_t)width * height * 3);
+    ok = std::fread(rgb.data(), 1, rgb.size(), file) == rgb.size();
+  }
+  std::fclose(file);
+  if (!ok)
+    std::cerr << "ImageIO: " << path << " is not an 8-bit P6 image"
+              << std::endl;
+  return ok;
+}
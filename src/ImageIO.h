@@ -0,0 +1,19 @@
+#pragma once
+/*
+ * ImageIO - Frames RGB 8 bits en PPM binario (P6)
+ * Sin dependencias; ffmpeg/ImageMagick los leen directamente
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// rgb: width * height * 3 bytes, fila superior primero
+bool writePPM(std::FILE *file, int width, int height,
+              const std::vector<uint8_t> &rgb);
+bool writePPM(const std::string &path, int width, int height,
+              const std::vector<uint8_t> &rgb);
+
+bool readPPM(const std::string &path, int &width, int &height,
+             std::vector<uint8_t> &rgb);
@@ -0,0 +1,145 @@
+#include "Nebula.h"
+
+#include <algorithm>
+
+static F4 mod289(F4 x) {
+  return x - floor(x * F4(1.0f / 289.0f)) * F4(289.0f);
+}
+
+static F4 permute(F4 x) {
+  return mod289((x * F4(34.0f) + F4(1.0f)) * x);
+}
+
+static F4 taylorInvSqrt(F4 r) {
+  return F4(1.79284291400159f) - F4(0.85373472095314f) * r;
+}
+
+static F4 smoothstep(float edge0, float edge1, F4 x) {
+  F4 t = (x - F4(edge0)) * F4(1.0f / (edge1 - edge0));
+  t = min(max(t, F4(0.0f)), F4(1.0f));
+  return t * t * (F4(3.0f) - F4(2.0f) * t);
+}
+
+F4 simplexNoise(F4 vx, F4 vy, F4 vz) {
+  const F4 Cx(1.0f / 6.0f), Cy(1.0f / 3.0f);
+  const F4 zero(0.0f), one(1.0f);
+
+  // First corner
+  F4 s = (vx + vy + vz) * Cy;
+  F4 ix = floor(vx + s), iy = floor(vy + s), iz = floor(vz + s);
+  F4 t = (ix + iy + iz) * Cx;
+  F4 x0[3] = {vx - ix + t, vy - iy + t, vz - iz + t};
+
+  // Other corners: g = step(x0.yzx, x0.xyz), l = 1 - g
+  F4 g[3] = {step(x0[1], x0[0]), step(x0[2], x0[1]), step(x0[0], x0[2])};
+  F4 l[3] = {one - g[0], one - g[1], one - g[2]};
+  F4 i1[3] = {min(g[0], l[2]), min(g[1], l[0]), min(g[2], l[1])};
+  F4 i2[3] = {max(g[0], l[2]), max(g[1], l[0]), max(g[2], l[1])};
+
+  F4 corner[4][3];
+  for (int a = 0; a < 3; a++) {
+    corner[0][a] = x0[a];
+    corner[1][a] = x0[a] - i1[a] + Cx;
+    corner[2][a] = x0[a] - i2[a] + Cy;
+    corner[3][a] = x0[a] - F4(0.5f);
+  }
+
+  // Permutations
+  ix = mod289(ix);
+  iy = mod289(iy);
+  iz = mod289(iz);
+  const F4 offX[4] = {zero, i1[0], i2[0], one};
+  const F4 offY[4] = {zero, i1[1], i2[1], one};
+  const F4 offZ[4] = {zero, i1[2], i2[2], one};
+
+  // Gradientes: 7x7 puntos sobre un cuadrado proyectados a un octaedro
+  const float n_ = 0.142857142857f; // 1.0/7.0
+  const F4 nsX(n_ * 2.0f), nsY(n_ * 0.5f - 1.0f), nsZ(n_);
+
+  F4 result;
+  for (int k = 0; k < 4; k++) {
+    F4 p = permute(permute(permute(iz + offZ[k]) + iy + offY[k]) + ix +
+                   offX[k]);
+    F4 j = p - F4(49.0f) * floor(p * nsZ * nsZ); // mod(p, 7*7)
+    F4 xFloor = floor(j * nsZ);
+    F4 yFloor = floor(j - F4(7.0f) * xFloor); // mod(j, N)
+    F4 x = xFloor * nsX + nsY;
+    F4 y = yFloor * nsX + nsY;
+    F4 h = one - abs(x) - abs(y);
+
+    F4 sh = zero - step(h, zero);
+    F4 gx = x + (floor(x) * F4(2.0f) + one) * sh;
+    F4 gy = y + (floor(y) * F4(2.0f) + one) * sh;
+    F4 gz = h;
+
+    F4 norm = taylorInvSqrt(gx * gx + gy * gy + gz * gz);
+    const F4 *c = corner[k];
+    F4 m = max(F4(0.6f) - (c[0] * c[0] + c[1] * c[1] + c[2] * c[2]), zero);
+    m = m * m;
+    result += m * m * norm * (gx * c[0] + gy * c[1] + gz * c[2]);
+  }
+  return F4(42.0f) * result;
+}
+
+float simplexNoise(float x, float y, float z) {
+  return simplexNoise(F4(x), F4(y), F4(z))[0];
+}
+
+F4 nebulaFbm(F4 x, F4 y, F4 z, float t) {
+  F4 value;
+  float amplitude = 0.5f;
+  float frequency = 1.0f;
+  for (int i = 0; i < 4; i++) {
+    F4 f(frequency);
+    value += F4(amplitude) *
+             simplexNoise(x * f, y * f + F4(t * 0.1f), z * f);
+    amplitude *= 0.5f;
+    frequency *= 2.0f;
+  }
+  return value;
+}
+
+float nebulaGatedAudio(float bass, float mids) {
+  return std::max(0.0f, mids * 2.0f + bass * 1.5f - 0.2f);
+}
+
+void nebulaColor(F4 dx, F4 dy, F4 dz, float time, float gatedAudio,
+                 F4 rgb[3]) {
+  const float deepSpace[3] = {0.0f, 0.0f, 0.02f};
+  const float nebulaBase[3] = {0.02f, 0.0f, 0.05f};
+  const float stormColor[3] = {0.3f, 0.1f, 0.4f};
+
+  const F4 baseScale(1.5f);
+  F4 baseNoise = nebulaFbm(dx * baseScale, dy * baseScale, dz * baseScale,
+                           time * 0.05f);
+  F4 cloud = smoothstep(0.4f, 0.7f, baseNoise);
+
+  F4 lightningIntensity;
+  if (gatedAudio > 0.0f) {
+    const F4 scale(8.0f), shift(time * 0.1f);
+    F4 lightningNoise = nebulaFbm(dx * scale + shift, dy * scale + shift,
+                                  dz * scale + shift, time * 0.1f);
+    lightningIntensity =
+        smoothstep(0.5f, 0.8f, lightningNoise) * F4(gatedAudio * 10.0f);
+  }
+
+  for (int c = 0; c < 3; c++) {
+    F4 base = F4(deepSpace[c]) + F4(nebulaBase[c] - deepSpace[c]) * cloud;
+    rgb[c] = base * F4(0.08f) + F4(stormColor[c]) * lightningIntensity;
+  }
+}
+
+void nebulaColor(float dx, float dy, float dz, float time, float gatedAudio,
+                 float rgb[3]) {
+  F4 lanes[3];
+  nebulaColor(F4(dx), F4(dy), F4(dz), time, gatedAudio, lanes);
+  for (int c = 0; c < 3; c++)
+    rgb[c] = lanes[c][0];
+}
+
+Mat4 skyboxModel(float angleX, float angleY) {
+  Mat4 model = transform::rotate(Mat4(), angleX, 1.0f, 0.0f, 0.0f);
+  model = transform::rotate(model, angleY, 0.0f, 1.0f, 0.0f);
+  // Cubo grande para cubrir el frustum (far plane 400)
+  return transform::scale(model, 200.0f);
+}
@@ -0,0 +1,28 @@
+#pragma once
+/*
+ * Nebula - Fondo de nebulosa en CPU
+ * Replica nebula.frag: simplex noise 3D + fbm y relampagos con el audio.
+ * Se evalua de 4 en 4 (F4); las versiones escalares usan el carril 0
+ */
+
+#include "Simd.h"
+#include "Transform.h"
+
+// snoise() de nebula.frag (simplex 3D de Ashima), rango aprox. [-1, 1]
+F4 simplexNoise(F4 x, F4 y, F4 z);
+float simplexNoise(float x, float y, float z);
+
+// fbm() de nebula.frag: 4 octavas desplazadas (0, t * 0.1, 0)
+F4 nebulaFbm(F4 x, F4 y, F4 z, float t);
+
+// Puerta de ruido del audio; 0 = sin relampagos (el fbm caro se omite)
+float nebulaGatedAudio(float bass, float mids);
+
+// Direcciones normalizadas en espacio del cubo
+void nebulaColor(F4 dx, F4 dy, F4 dz, float time, float gatedAudio,
+                 F4 rgb[3]);
+void nebulaColor(float dx, float dy, float dz, float time, float gatedAudio,
+                 float rgb[3]);
+
+// Modelo del skybox (cubo de lado 400 alrededor de la camara)
+Mat4 skyboxModel(float angleX, float angleY);
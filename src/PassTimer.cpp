@@ -0,0 +1,67 @@
+#include "PassTimer.h"
+
+#include "AudioFrame.h"
+
+#include <glad/glad.h>
+
+PassTimer::PassTimer(PassTimings &timings) : timings(timings) {
+  for (Frame &frame : frames)
+    glGenQueries((GLsizei)(MAX_PASSES * 2), frame.queries);
+}
+
+PassTimer::~PassTimer() {
+  for (Frame &frame : frames)
+    glDeleteQueries((GLsizei)(MAX_PASSES * 2), frame.queries);
+}
+
+void PassTimer::collect(Frame &frame) {
+  if (!frame.pending || frame.names.empty()) {
+    frame.pending = false;
+    return;
+  }
+  // La ultima query del frame es la ultima en completarse
+  GLint available = 0;
+  glGetQueryObjectiv(frame.queries[frame.names.size() * 2 - 1],
+                     GL_QUERY_RESULT_AVAILABLE, &available);
+  if (!available)
+    return;
+  for (size_t i = 0; i < frame.names.size(); i++) {
+    GLuint64 begin = 0, end = 0;
+    glGetQueryObjectui64v(frame.queries[2 * i], GL_QUERY_RESULT, &begin);
+    glGetQueryObjectui64v(frame.queries[2 * i + 1], GL_QUERY_RESULT, &end);
+    timings.addGpu(frame.names[i], (double)(end - begin) / 1e6);
+  }
+  frame.pending = false;
+}
+
+void PassTimer::beginFrame() {
+  for (Frame &frame : frames)
+    collect(frame);
+  current = -1;
+  if (!frames[next].pending) {
+    current = next;
+    next = (next + 1) % FRAMES;
+    frames[current].names.clear();
+    frames[current].pending = true;
+  }
+}
+
+void PassTimer::beginPass(size_t, const std::string &name) {
+  if (current >= 0) {
+    Frame &frame = frames[current];
+    if (frame.names.size() < MAX_PASSES) {
+      glQueryCounter(frame.queries[frame.names.size() * 2], GL_TIMESTAMP);
+      frame.names.push_back(name);
+    }
+  }
+  passStartNs = monotonicNowNs();
+}
+
+void PassTimer::endPass(size_t, const std::string &name) {
+  timings.addCpu(name, (monotonicNowNs() - passStartNs) / 1e6);
+  if (current >= 0) {
+    Frame &frame = frames[current];
+    if (!frame.names.empty() && frame.names.back() == name)
+      glQueryCounter(frame.queries[frame.names.size() * 2 - 1], GL_TIMESTAMP);
+  }
+}
@@ -0,0 +1,42 @@
+#pragma once
+/*
+ * PassTimer - Tiempo de CPU y GPU de cada pasada del RenderGraph
+ * GPU con pares de GL_TIMESTAMP (no se anidan con el GL_TIME_ELAPSED del
+ * pacer); los resultados se recogen frames despues, sin bloquear
+ */
+
+#include "RenderGraph.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class PassTimer : public PassProfiler {
+public:
+  explicit PassTimer(PassTimings &timings);
+  ~PassTimer();
+  PassTimer(const PassTimer &) = delete;
+  PassTimer &operator=(const PassTimer &) = delete;
+
+  // Recoge los frames terminados y elige slot para el nuevo
+  void beginFrame();
+  void beginPass(size_t pass, const std::string &name) override;
+  void endPass(size_t pass, const std::string &name) override;
+
+private:
+  static constexpr int FRAMES = 4;
+  static constexpr size_t MAX_PASSES = 32;
+
+  struct Frame {
+    unsigned int queries[MAX_PASSES * 2] = {};
+    std::vector<std::string> names;
+    bool pending = false;
+  };
+  void collect(Frame &frame);
+
+  PassTimings &timings;
+  Frame frames[FRAMES];
+  int current = -1; // -1: GPU sin medir este frame (cola llena)
+  int next = 0;
+  int64_t passStartNs = 0;
+};
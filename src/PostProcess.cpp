@@ -0,0 +1,63 @@
+#include "PostProcess.h"
+
+#include <algorithm>
+#include <cmath>
+
+const float BLOOM_WEIGHTS[BLOOM_TAPS] = {0.227027f, 0.1945946f, 0.1216216f,
+                                         0.054054f, 0.016216f};
+
+float bloomStrengthFor(float cameraDistance) {
+  float t = std::min(std::max((cameraDistance - 1.0f) / 8.0f, 0.0f), 1.0f);
+  return 1.0f + (0.5f - 1.0f) * t;
+}
+
+void combineLinear(const float hdr[3], const float bloom[3],
+                   float bloomStrength, float out[3]) {
+  const float exposure = 0.7f;
+  float mapped[3];
+  for (int c = 0; c < 3; c++)
+    mapped[c] = 1.0f - std::exp(-(hdr[c] + bloom[c] * bloomStrength) *
+                                exposure);
+
+  float luminance =
+      mapped[0] * 0.299f + mapped[1] * 0.587f + mapped[2] * 0.114f;
+  for (int c = 0; c < 3; c++) {
+    float saturated = luminance + (mapped[c] - luminance) * 1.3f;
+    out[c] = std::min(std::max(saturated, 0.0f), 1.0f);
+  }
+}
+
+void combinePixel(const float hdr[3], const float bloom[3],
+                  float bloomStrength, float out[3]) {
+  combineLinear(hdr, bloom, bloomStrength, out);
+  for (int c = 0; c < 3; c++)
+    out[c] = std::pow(out[c], 1.0f / 2.2f);
+}
+
+unsigned char toUnorm8(float value) {
+  value = std::min(std::max(value, 0.0f), 1.0f);
+  return (unsigned char)(value * 255.0f + 0.5f);
+}
+
+GammaEncoder::GammaEncoder() {
+  // Byte k a partir de pow(x, 1/2.2) * 255 + 0.5 >= k
+  thresholds[0] = -1.0f;
+  for (int k = 1; k <= 255; k++)
+    thresholds[k] = std::pow((k - 0.5f) / 255.0f, 2.2f);
+  thresholds[256] = 2.0f; // Centinela
+  int k = 0;
+  for (int i = 0; i <= COARSE; i++) {
+    float x = (float)i / COARSE;
+    while (thresholds[k + 1] <= x)
+      k++;
+    coarse[i] = (unsigned char)k;
+  }
+}
+
+unsigned char GammaEncoder::operator()(float linear) const {
+  linear = std::min(std::max(linear, 0.0f), 1.0f);
+  int k = coarse[(int)(linear * COARSE)];
+  while (thresholds[k + 1] <= linear)
+    k++;
+  return (unsigned char)k;
+}
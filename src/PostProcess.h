@@ -0,0 +1,38 @@
+#pragma once
+/*
+ * PostProcess - Constantes y combine de bloom.frag en CPU
+ */
+
+constexpr int BLOOM_TAPS = 5;
+extern const float BLOOM_WEIGHTS[BLOOM_TAPS]; // weights[] de bloom.frag
+
+// Pares de pasadas H+V del ping-pong de main.cpp
+constexpr int BLOOM_ITERATIONS = 4;
+
+// Menos bloom al alejar la camara (main.cpp)
+float bloomStrengthFor(float cameraDistance);
+
+// Pasada de combinacion: aditivo, exposure 0.7, saturacion 1.3, gamma 2.2.
+// Devuelve el color final en [0, 1]
+void combinePixel(const float hdr[3], const float bloom[3],
+                  float bloomStrength, float out[3]);
+
+// combinePixel sin la gamma: color lineal ya saturado y en [0, 1]
+void combineLinear(const float hdr[3], const float bloom[3],
+                   float bloomStrength, float out[3]);
+
+// Color final -> byte como al escribir en un framebuffer UNORM8
+unsigned char toUnorm8(float value);
+
+// toUnorm8(pow(linear, 1/2.2)) sin pow(): tabla gruesa + umbrales exactos
+// de cada byte (el combine en CPU lo hace 3 veces por pixel)
+class GammaEncoder {
+public:
+  GammaEncoder();
+  unsigned char operator()(float linear) const;
+
+private:
+  static constexpr int COARSE = 4096;
+  float thresholds[257]; // thresholds[k]: lineal minimo que da el byte k
+  unsigned char coarse[COARSE + 1];
+};
@@ -0,0 +1,152 @@
+#include "RealtimeThread.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include <avrt.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+bool parseRealtimePolicy(const std::string &name, RealtimePolicy &policy) {
+  if (name == "normal")
+    policy = RealtimePolicy::Normal;
+  else if (name == "fifo")
+    policy = RealtimePolicy::Fifo;
+  else if (name == "rr")
+    policy = RealtimePolicy::RoundRobin;
+  else
+    return false;
+  return true;
+}
+
+const char *realtimePolicyName(RealtimePolicy policy) {
+  switch (policy) {
+  case RealtimePolicy::Fifo:
+    return "fifo";
+  case RealtimePolicy::RoundRobin:
+    return "rr";
+  default:
+    return "normal";
+  }
+}
+
+void RealtimeScope::note(const std::string &what) {
+  if (!applied.empty())
+    applied += ", ";
+  applied += what;
+}
+
+#ifdef _WIN32
+
+RealtimeScope::RealtimeScope(const RealtimeOptions &options) {
+  if (options.mmcss) {
+    DWORD taskIndex = 0;
+    HANDLE task = AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+    if (task) {
+      AvSetMmThreadPriority(task, AVRT_PRIORITY_HIGH);
+      mmcssHandle = task;
+      note("MMCSS Pro Audio");
+    } else {
+      std::cerr << "MMCSS: AvSetMmThreadCharacteristics fallo ("
+                << GetLastError() << ")" << std::endl;
+      allApplied = false;
+    }
+  }
+  if (options.policy != RealtimePolicy::Normal)
+    std::cerr << "--rt-policy " << realtimePolicyName(options.policy)
+              << " no aplica en Windows (la prioridad la gestiona MMCSS)"
+              << std::endl;
+
+  if (options.cpu >= 0) {
+    DWORD_PTR mask = (DWORD_PTR)1 << options.cpu;
+    if (options.cpu < (int)(sizeof(DWORD_PTR) * 8) &&
+        SetThreadAffinityMask(GetCurrentThread(), mask) != 0) {
+      note("cpu " + std::to_string(options.cpu));
+    } else {
+      std::cerr << "Afinidad a la cpu " << options.cpu << " fallo"
+                << std::endl;
+      allApplied = false;
+    }
+  }
+  if (options.lockMemory) {
+    std::cerr << "--mlock solo esta disponible en Linux" << std::endl;
+    allApplied = false;
+  }
+}
+
+RealtimeScope::~RealtimeScope() {
+  if (mmcssHandle)
+    AvRevertMmThreadCharacteristics((HANDLE)mmcssHandle);
+}
+
+#else
+
+RealtimeScope::RealtimeScope(const RealtimeOptions &options) {
+  if (options.policy != RealtimePolicy::Normal) {
+    int policy =
+        options.policy == RealtimePolicy::Fifo ? SCHED_FIFO : SCHED_RR;
+    int requested =
+        options.priority > 0 ? options.priority : REALTIME_DEFAULT_PRIORITY;
+    sched_param param{};
+    param.sched_priority =
+        std::clamp(requested, sched_get_priority_min(policy),
+                   sched_get_priority_max(policy));
+    int err = pthread_setschedparam(pthread_self(), policy, &param);
+    std::string name = policy == SCHED_FIFO ? "SCHED_FIFO" : "SCHED_RR";
+    if (err == 0) {
+      note(name + " " + std::to_string(param.sched_priority));
+    } else {
+      // EPERM: falta CAP_SYS_NICE o 'rtprio' en /etc/security/limits.conf
+      std::cerr << name << " " << param.sched_priority << ": "
+                << std::strerror(err) << std::endl;
+      allApplied = false;
+    }
+  }
+
+  if (options.cpu >= 0) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    int err = EINVAL;
+    if (options.cpu < CPU_SETSIZE) {
+      CPU_SET(options.cpu, &set);
+      err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+    if (err == 0) {
+      note("cpu " + std::to_string(options.cpu));
+    } else {
+      std::cerr << "Afinidad a la cpu " << options.cpu << ": "
+                << std::strerror(err) << std::endl;
+      allApplied = false;
+    }
+#else
+    std::cerr << "--rt-cpu no disponible en esta plataforma" << std::endl;
+    allApplied = false;
+#endif
+  }
+
+  if (options.lockMemory) {
+    // Sin fallos de pagina en el hilo de audio; afecta a todo el proceso
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+      note("mlockall");
+    } else {
+      std::cerr << "mlockall: " << std::strerror(errno) << std::endl;
+      allApplied = false;
+    }
+  }
+}
+
+RealtimeScope::~RealtimeScope() {}
+
+#endif
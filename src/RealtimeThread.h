@@ -0,0 +1,54 @@
+#pragma once
+/*
+ * RealtimeThread - Prioridad de tiempo real para hilos de audio
+ * Windows: MMCSS ("Pro Audio") y afinidad.
+ * Linux: SCHED_FIFO/SCHED_RR, afinidad de CPU y mlockall.
+ * Lo que el sistema no permita se avisa por std::cerr y el hilo sigue con
+ * prioridad normal.
+ */
+
+#include <string>
+
+enum class RealtimePolicy {
+  Normal,    // Planificador por defecto (Windows: solo MMCSS)
+  Fifo,      // SCHED_FIFO
+  RoundRobin // SCHED_RR
+};
+
+struct RealtimeOptions {
+  RealtimePolicy policy = RealtimePolicy::Normal;
+  int priority = 0;        // 0: REALTIME_DEFAULT_PRIORITY (limitado al rango)
+  int cpu = -1;            // -1: sin afinidad
+  bool lockMemory = false; // mlockall(MCL_CURRENT | MCL_FUTURE), todo el proceso
+  bool mmcss = true;       // Windows: registrar el hilo en MMCSS
+};
+
+// Por debajo de los hilos de IRQ del kernel (50) y de JACK/PipeWire (~88)
+constexpr int REALTIME_DEFAULT_PRIORITY = 70;
+
+bool parseRealtimePolicy(const std::string &name, RealtimePolicy &policy);
+const char *realtimePolicyName(RealtimePolicy policy);
+
+// Aplica las opciones al hilo que la construye y deshace MMCSS al salir.
+// Debe vivir en el propio hilo de audio, durante todo su bucle.
+class RealtimeScope {
+public:
+  explicit RealtimeScope(const RealtimeOptions &options);
+  ~RealtimeScope();
+
+  RealtimeScope(const RealtimeScope &) = delete;
+  RealtimeScope &operator=(const RealtimeScope &) = delete;
+
+  // false si alguna de las opciones pedidas no se pudo aplicar
+  bool ok() const { return allApplied; }
+
+  // Lo que se aplico de verdad: "SCHED_FIFO 70, cpu 2, mlockall"
+  const std::string &describe() const { return applied; }
+
+private:
+  void note(const std::string &what);
+
+  bool allApplied = true;
+  std::string applied;
+  void *mmcssHandle = nullptr;
+};
@@ -0,0 +1,267 @@
+#include "RenderBench.h"
+#include "GlmTransform.h"
+#include "GpuTimer.h"
+#include "Grid.h"
+#include "Shader.h"
+#include "SplatRenderer.h"
+#include "Stats.h"
+#include "WaveLayers.h"
+
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int WARMUP_FRAMES = 5;
+constexpr int MEASURED_FRAMES = 60;
+
+// Escena fija para que ambos modos rendericen exactamente lo mismo
+constexpr float BENCH_TIME = 10.0f;
+constexpr float BENCH_BASS = 0.5f;
+constexpr float BENCH_MIDS = 0.3f;
+constexpr float BENCH_TREBLE = 0.4f;
+constexpr float CAMERA_DISTANCE = 2.5f;
+constexpr float CAMERA_ANGLE_X = 0.5f;
+
+struct BenchLayer {
+  unsigned int vao = 0, vbo = 0;
+  int count = 0;
+  float gridSize = 0.0f;
+};
+
+struct BenchTarget {
+  unsigned int fbo = 0, texture = 0;
+  int width = 0, height = 0;
+};
+
+// Misma extension de rejilla con density veces mas particulas por lado
+std::vector<BenchLayer> createLayers(int density) {
+  std::vector<BenchLayer> layers(WAVE_LAYER_COUNT);
+  for (size_t i = 0; i < WAVE_LAYER_COUNT; i++) {
+    const WaveLayerDesc &desc = WAVE_LAYERS[i];
+    int side = desc.gridCount * density;
+    std::vector<float> grid = generateGrid(side, desc.spacing / density);
+    layers[i].count = side * side;
+    layers[i].gridSize = desc.gridSize();
+
+    glGenVertexArrays(1, &layers[i].vao);
+    glGenBuffers(1, &layers[i].vbo);
+    glBindVertexArray(layers[i].vao);
+    glBindBuffer(GL_ARRAY_BUFFER, layers[i].vbo);
+    glBufferData(GL_ARRAY_BUFFER, grid.size() * sizeof(float), grid.data(),
+                 GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float),
+                          (void *)0);
+    glEnableVertexAttribArray(0);
+  }
+  return layers;
+}
+
+void destroyLayers(std::vector<BenchLayer> &layers) {
+  for (BenchLayer &layer : layers) {
+    glDeleteVertexArrays(1, &layer.vao);
+    glDeleteBuffers(1, &layer.vbo);
+  }
+  layers.clear();
+}
+
+BenchTarget createTarget(int width, int height) {
+  BenchTarget target;
+  target.width = width;
+  target.height = height;
+  glGenTextures(1, &target.texture);
+  glBindTexture(GL_TEXTURE_2D, target.texture);
+  glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA16F, width, height);
+  glGenFramebuffers(1, &target.fbo);
+  glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         target.texture, 0);
+  return target;
+}
+
+void destroyTarget(BenchTarget &target) {
+  glDeleteFramebuffers(1, &target.fbo);
+  glDeleteTextures(1, &target.texture);
+}
+
+class WaveBench {
+public:
+  bool initialize() {
+    std::string vertCode = loadShaderSource("shaders/shader.vert");
+    std::string fragCode = loadShaderSource("shaders/shader.frag");
+    particleShader = createShader(vertCode.c_str(), fragCode.c_str());
+    return splat.initialize();
+  }
+
+  ~WaveBench() { glDeleteProgram(particleShader); }
+
+  void clear(const BenchTarget &target) {
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glViewport(0, 0, target.width, target.height);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+  }
+
+  void draw(bool useSplat, const BenchTarget &target,
+            const std::vector<BenchLayer> &layers) {
+    glm::mat4 projection =
+        glm::perspective(glm::radians(45.0f),
+                         (float)target.width / (float)target.height, 0.1f,
+                         400.0f);
+
+    if (useSplat) {
+      SplatFrameUniforms frame;
+      frame.time = BENCH_TIME;
+      frame.bass = BENCH_BASS;
+      frame.mids = BENCH_MIDS;
+      frame.treble = BENCH_TREBLE;
+      std::vector<SplatLayer> splatLayers(layers.size());
+      for (size_t i = 0; i < layers.size(); i++) {
+        splatLayers[i].gridVBO = layers[i].vbo;
+        splatLayers[i].count = layers[i].count;
+        splatLayers[i].mvp =
+            projection *
+            toGlm(waveLayerView(i, CAMERA_DISTANCE, CAMERA_ANGLE_X, 0.0f));
+        splatLayers[i].intensity = WAVE_LAYERS[i].intensity;
+        splatLayers[i].gridSize = layers[i].gridSize;
+        splatLayers[i].peakExp = WAVE_LAYERS[i].peakExp;
+      }
+      splat.render(target.texture, target.width, target.height, frame,
+                   splatLayers);
+      return;
+    }
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glUseProgram(particleShader);
+    glUniform1f(glGetUniformLocation(particleShader, "time"), BENCH_TIME);
+    glUniform1f(glGetUniformLocation(particleShader, "uBass"), BENCH_BASS);
+    glUniform1f(glGetUniformLocation(particleShader, "uMids"), BENCH_MIDS);
+    glUniform1f(glGetUniformLocation(particleShader, "uTreble"),
+                BENCH_TREBLE);
+    glUniform1f(glGetUniformLocation(particleShader, "layerOffset"), 0.0f);
+    for (size_t i = 0; i < layers.size(); i++) {
+      glm::mat4 mvp = projection * toGlm(waveLayerView(i, CAMERA_DISTANCE,
+                                                       CAMERA_ANGLE_X, 0.0f));
+      glUniformMatrix4fv(glGetUniformLocation(particleShader, "mvp"), 1,
+                         GL_FALSE, glm::value_ptr(mvp));
+      glUniform1f(glGetUniformLocation(particleShader, "intensity"),
+                  WAVE_LAYERS[i].intensity);
+      glUniform1f(glGetUniformLocation(particleShader, "uGridSize"),
+                  layers[i].gridSize);
+      glUniform1f(glGetUniformLocation(particleShader, "peakExp"),
+                  WAVE_LAYERS[i].peakExp);
+      glBindVertexArray(layers[i].vao);
+      glDrawArrays(GL_POINTS, 0, layers[i].count);
+    }
+    glDisable(GL_BLEND);
+  }
+
+  Distribution time(bool useSplat, const BenchTarget &target,
+                    const std::vector<BenchLayer> &layers) {
+    GpuTimer timer;
+    std::vector<double> samples;
+    for (int frame = 0; frame < WARMUP_FRAMES + MEASURED_FRAMES; frame++) {
+      clear(target);
+      timer.begin();
+      draw(useSplat, target, layers);
+      timer.end();
+      double ms = timer.elapsedMs();
+      if (frame >= WARMUP_FRAMES)
+        samples.push_back(ms);
+    }
+    return summarize(samples);
+  }
+
+  std::vector<float> capture(bool useSplat, const BenchTarget &target,
+                             const std::vector<BenchLayer> &layers) {
+    clear(target);
+    draw(useSplat, target, layers);
+    std::vector<float> pixels((size_t)target.width * target.height * 4);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glReadPixels(0, 0, target.width, target.height, GL_RGBA, GL_FLOAT,
+                 pixels.data());
+    return pixels;
+  }
+
+private:
+  unsigned int particleShader = 0;
+  SplatRenderer splat;
+};
+
+} // namespace
+
+int runRenderBenchmark() {
+  WaveBench bench;
+  if (!bench.initialize()) {
+    std::fprintf(stderr, "Splatting shaders failed to build\n");
+    return 1;
+  }
+
+  struct Resolution {
+    const char *name;
+    int width, height;
+  };
+  const Resolution resolutions[] = {{"1080p", 1920, 1080},
+                                    {"4K", 3840, 2160}};
+
+  bool matches = true;
+  std::printf("%-6s %-10s %-8s %s\n", "res", "particles", "mode",
+              "gpu ms (waves only)");
+
+  // density 1, 2, 4 => x1, x4, x16 particulas
+  for (int density : {1, 2, 4}) {
+    std::vector<BenchLayer> layers = createLayers(density);
+    size_t particles = 0;
+    for (const BenchLayer &layer : layers)
+      particles += (size_t)layer.count;
+
+    for (const Resolution &res : resolutions) {
+      BenchTarget target = createTarget(res.width, res.height);
+      for (bool useSplat : {false, true}) {
+        Distribution d = bench.time(useSplat, target, layers);
+        std::printf("%-6s %-10zu %-8s %s\n", res.name, particles,
+                    useSplat ? "splat" : "raster",
+                    formatDistribution(d).c_str());
+      }
+
+      // Mismo aspecto: se compara tras el tone mapping del combine
+      // (bloom.frag). En HDR el rasterizado pierde precision al redondear
+      // cada blend a RGBA16F; el splatting acumula en fp32 y escribe una vez
+      std::vector<float> raster = bench.capture(false, target, layers);
+      std::vector<float> splat = bench.capture(true, target, layers);
+      auto toneMap = [](float v) { return 1.0 - std::exp(-(double)v * 0.7); };
+      double maxDiff = 0.0, sumDiff = 0.0;
+      size_t mismatched = 0, channels = 0;
+      for (size_t i = 0; i < raster.size(); i++) {
+        if (i % 4 == 3)
+          continue; // alpha no llega a pantalla
+        double diff = std::fabs(toneMap(raster[i]) - toneMap(splat[i]));
+        maxDiff = std::max(maxDiff, diff);
+        sumDiff += diff;
+        channels++;
+        if (diff > 2.0 / 255.0)
+          mismatched++;
+      }
+      std::printf("%-6s %-10zu diff   max %.4f mean %.6f mismatched %zu\n",
+                  res.name, particles, maxDiff, sumDiff / channels,
+                  mismatched);
+      if (mismatched > channels / 10000)
+        matches = false;
+
+      destroyTarget(target);
+    }
+    destroyLayers(layers);
+  }
+
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  return matches ? 0 : 1;
+}
@@ -0,0 +1,9 @@
+#pragma once
+/*
+ * RenderBench - Benchmark offscreen de las capas de ondas
+ * Compara GL_POINTS + blend aditivo con el splatting por tiles en compute
+ * (requiere un contexto GL 4.5 activo)
+ */
+
+// Devuelve 0 si ambos modos producen la misma imagen (dentro de tolerancia)
+int runRenderBenchmark();
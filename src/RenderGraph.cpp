@@ -0,0 +1,265 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+size_t targetFormatBytes(TargetFormat format) {
+  switch (format) {
+  case TargetFormat::RGBA16F:
+    return 8;
+  case TargetFormat::RGBA8:
+  case TargetFormat::R32F:
+  default:
+    return 4;
+  }
+}
+
+ResourceHandle RenderGraph::createTarget(const std::string &name,
+                                         const TargetDesc &desc) {
+  Resource resource;
+  resource.name = name;
+  resource.desc = desc;
+  resources.push_back(resource);
+  return resources.size() - 1;
+}
+
+ResourceHandle RenderGraph::importTarget(const std::string &name,
+                                         bool output) {
+  Resource resource;
+  resource.name = name;
+  resource.imported = true;
+  resource.output = output;
+  resources.push_back(resource);
+  return resources.size() - 1;
+}
+
+size_t RenderGraph::addPass(const std::string &name,
+                            std::function<void()> execute) {
+  Pass pass;
+  pass.name = name;
+  pass.execute = std::move(execute);
+  passes.push_back(std::move(pass));
+  return passes.size() - 1;
+}
+
+void RenderGraph::read(size_t pass, ResourceHandle resource) {
+  passes[pass].reads.push_back(resource);
+}
+
+void RenderGraph::write(size_t pass, ResourceHandle resource) {
+  passes[pass].writes.push_back(resource);
+}
+
+void RenderGraph::setContributes(size_t pass, bool contributes) {
+  passes[pass].contributes = contributes;
+}
+
+void RenderGraph::clear() {
+  resources.clear();
+  passes.clear();
+  liveOrder.clear();
+  physical.clear();
+}
+
+void RenderGraph::cull() {
+  // De la ultima a la primera: una pasada vive si escribe algo que una
+  // pasada viva posterior (o la salida) necesita. Su escritura satisface
+  // esa necesidad y sus lecturas pasan a ser necesarias; leer y escribir
+  // el mismo target (blend) lo mantiene necesario hacia atras
+  std::vector<bool> needed(resources.size(), false);
+  for (size_t r = 0; r < resources.size(); r++)
+    needed[r] = resources[r].output;
+
+  for (size_t i = passes.size(); i-- > 0;) {
+    Pass &pass = passes[i];
+    pass.live = false;
+    if (!pass.contributes)
+      continue;
+    for (ResourceHandle w : pass.writes)
+      pass.live = pass.live || needed[w];
+    if (!pass.live)
+      continue;
+    for (ResourceHandle w : pass.writes)
+      needed[w] = false;
+    for (ResourceHandle r : pass.reads)
+      needed[r] = true;
+  }
+
+  liveOrder.clear();
+  for (Resource &resource : resources)
+    resource.written = resource.imported;
+  for (size_t i = 0; i < passes.size(); i++) {
+    if (!passes[i].live)
+      continue;
+    liveOrder.push_back(i);
+    for (ResourceHandle w : passes[i].writes)
+      resources[w].written = true;
+  }
+}
+
+bool RenderGraph::allocate() {
+  // Vida de cada transitorio: primera y ultima pasada viva que lo toca
+  const size_t NONE = (size_t)-1;
+  std::vector<size_t> first(resources.size(), NONE), last(resources.size());
+  std::vector<bool> writtenSoFar(resources.size(), false);
+  for (size_t k = 0; k < liveOrder.size(); k++) {
+    const Pass &pass = passes[liveOrder[k]];
+    for (ResourceHandle r : pass.reads) {
+      // Leer un transitorio antes de que nadie lo escriba seria leer lo
+      // que dejo otro target en la misma memoria
+      if (!resources[r].imported && resources[r].written && !writtenSoFar[r]) {
+        std::cerr << "RenderGraph: '" << pass.name << "' lee '"
+                  << resources[r].name << "' antes de escribirlo"
+                  << std::endl;
+        return false;
+      }
+    }
+    for (ResourceHandle w : pass.writes)
+      writtenSoFar[w] = true;
+    for (const std::vector<ResourceHandle> *list : {&pass.reads, &pass.writes})
+      for (ResourceHandle r : *list) {
+        if (resources[r].imported || !resources[r].written)
+          continue;
+        if (first[r] == NONE)
+          first[r] = k;
+        last[r] = k;
+      }
+  }
+
+  // Por orden de nacimiento, primer slot compatible que ya quedo libre
+  std::vector<ResourceHandle> byFirst;
+  for (ResourceHandle r = 0; r < resources.size(); r++) {
+    resources[r].slot = -1;
+    if (first[r] != NONE)
+      byFirst.push_back(r);
+  }
+  std::stable_sort(byFirst.begin(), byFirst.end(),
+                   [&](ResourceHandle a, ResourceHandle b) {
+                     return first[a] < first[b];
+                   });
+  physical.clear();
+  std::vector<size_t> slotFreeAfter;
+  for (ResourceHandle r : byFirst) {
+    int chosen = -1;
+    for (size_t s = 0; s < physical.size() && chosen < 0; s++)
+      if (physical[s] == resources[r].desc && slotFreeAfter[s] < first[r])
+        chosen = (int)s;
+    if (chosen < 0) {
+      physical.push_back(resources[r].desc);
+      slotFreeAfter.push_back(0);
+      chosen = (int)physical.size() - 1;
+    }
+    resources[r].slot = chosen;
+    slotFreeAfter[chosen] = last[r];
+  }
+  return true;
+}
+
+bool RenderGraph::compile() {
+  for (const Pass &pass : passes)
+    for (const std::vector<ResourceHandle> *list : {&pass.reads, &pass.writes})
+      for (ResourceHandle r : *list)
+        if (r >= resources.size()) {
+          std::cerr << "RenderGraph: '" << pass.name
+                    << "' usa un recurso que no existe" << std::endl;
+          return false;
+        }
+  cull();
+  return allocate();
+}
+
+void RenderGraph::execute(PassProfiler *profiler) const {
+  for (size_t i : liveOrder) {
+    const Pass &pass = passes[i];
+    if (profiler)
+      profiler->beginPass(i, pass.name);
+    if (pass.execute)
+      pass.execute();
+    if (profiler)
+      profiler->endPass(i, pass.name);
+  }
+}
+
+std::vector<std::string> RenderGraph::orderNames() const {
+  std::vector<std::string> names;
+  for (size_t i : liveOrder)
+    names.push_back(passes[i].name);
+  return names;
+}
+
+bool RenderGraph::available(ResourceHandle resource) const {
+  return resources[resource].written;
+}
+
+int RenderGraph::slot(ResourceHandle resource) const {
+  return resources[resource].slot;
+}
+
+size_t RenderGraph::transientBytes() const {
+  size_t total = 0;
+  for (const TargetDesc &desc : physical)
+    total += desc.bytes();
+  return total;
+}
+
+size_t RenderGraph::unaliasedBytes() const {
+  size_t total = 0;
+  for (const Resource &resource : resources)
+    if (resource.slot >= 0)
+      total += resource.desc.bytes();
+  return total;
+}
+
+PassTimings::PassTimings(size_t window) : window(window) {}
+
+PassTimings::Entry &PassTimings::entry(const std::string &pass) {
+  for (Entry &e : entries)
+    if (e.name == pass)
+      return e;
+  entries.push_back(Entry());
+  entries.back().name = pass;
+  return entries.back();
+}
+
+void PassTimings::push(std::vector<double> &samples, size_t &next,
+                       double ms) {
+  if (samples.size() < window) {
+    samples.push_back(ms);
+  } else {
+    samples[next] = ms;
+    next = (next + 1) % window;
+  }
+}
+
+void PassTimings::addCpu(const std::string &pass, double ms) {
+  Entry &e = entry(pass);
+  push(e.cpuMs, e.cpuNext, ms);
+}
+
+void PassTimings::addGpu(const std::string &pass, double ms) {
+  Entry &e = entry(pass);
+  push(e.gpuMs, e.gpuNext, ms);
+}
+
+std::string PassTimings::report() const {
+  std::string out;
+  char line[160];
+  for (const Entry &e : entries) {
+    Distribution cpu = summarize(e.cpuMs);
+    Distribution gpu = summarize(e.gpuMs);
+    std::snprintf(line, sizeof(line),
+                  "  %-12s cpu mean %.3f p95 %.3f  gpu mean %.3f p95 %.3f "
+                  "ms (%zu frames)\n",
+                  e.name.c_str(), cpu.mean, cpu.p95, gpu.mean, gpu.p95,
+                  std::max(cpu.count, gpu.count));
+    out += line;
+  }
+  return out;
+}
+
+std::string formatTargetBytes(size_t bytes) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.1f MB", bytes / (1024.0 * 1024.0));
+  return buffer;
+}
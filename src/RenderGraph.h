@@ -0,0 +1,142 @@
+#pragma once
+/*
+ * RenderGraph - Grafo de pasadas de render declarativo
+ * Cada pasada declara los targets que lee y escribe. compile() descarta
+ * las que no llegan a una salida o no aportan nada, mantiene el orden de
+ * declaracion y reparte los targets transitorios en texturas fisicas
+ * compartidas cuando sus vidas no se solapan. Sin GL: el backend crea las
+ * texturas de slots() y mide cada pasada via PassProfiler.
+ */
+
+#include "Stats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+enum class TargetFormat { RGBA16F, RGBA8, R32F };
+size_t targetFormatBytes(TargetFormat format);
+
+struct TargetDesc {
+  int width = 0;
+  int height = 0;
+  TargetFormat format = TargetFormat::RGBA16F;
+
+  size_t bytes() const {
+    return (size_t)width * height * targetFormatBytes(format);
+  }
+  bool operator==(const TargetDesc &o) const {
+    return width == o.width && height == o.height && format == o.format;
+  }
+  bool operator!=(const TargetDesc &o) const { return !(*this == o); }
+};
+
+using ResourceHandle = size_t;
+
+// Ganchos alrededor de cada pasada ejecutada (tiempos CPU / GPU)
+class PassProfiler {
+public:
+  virtual ~PassProfiler() = default;
+  virtual void beginPass(size_t pass, const std::string &name) = 0;
+  virtual void endPass(size_t pass, const std::string &name) = 0;
+};
+
+class RenderGraph {
+public:
+  // Transitorio: el grafo decide su textura fisica y puede compartirla
+  ResourceHandle createTarget(const std::string &name, const TargetDesc &desc);
+  // Externo (backbuffer, caches entre frames): nunca se comparte. Los
+  // 'output' son lo que el frame tiene que producir
+  ResourceHandle importTarget(const std::string &name, bool output);
+
+  size_t addPass(const std::string &name, std::function<void()> execute);
+  void read(size_t pass, ResourceHandle resource);
+  void write(size_t pass, ResourceHandle resource);
+  // false: la pasada no aporta nada este frame (p.ej. bloom a 0) y se
+  // descarta junto con las que solo la alimentan
+  void setContributes(size_t pass, bool contributes);
+
+  // Descarta, ordena y asigna memoria; false si el grafo es invalido
+  bool compile();
+  void execute(PassProfiler *profiler = nullptr) const;
+
+  // Vacia las declaraciones (se vuelve a declarar cada frame)
+  void clear();
+
+  // Resultado de compile()
+  const std::vector<size_t> &order() const { return liveOrder; }
+  std::vector<std::string> orderNames() const;
+  bool live(size_t pass) const { return passes[pass].live; }
+  // Escrito por alguna pasada viva (o externo); si no, quien lo lea
+  // tiene que usar un valor neutro
+  bool available(ResourceHandle resource) const;
+  // Textura fisica del target transitorio; -1 si no se usa este frame
+  int slot(ResourceHandle resource) const;
+  const std::vector<TargetDesc> &slots() const { return physical; }
+  size_t transientBytes() const;
+  size_t unaliasedBytes() const; // Un target fisico por transitorio vivo
+
+  size_t passCount() const { return passes.size(); }
+  const std::string &passName(size_t pass) const { return passes[pass].name; }
+  const std::string &resourceName(ResourceHandle r) const {
+    return resources[r].name;
+  }
+
+private:
+  struct Resource {
+    std::string name;
+    TargetDesc desc;
+    bool imported = false;
+    bool output = false;
+    int slot = -1;
+    bool written = false; // Por una pasada viva
+  };
+  struct Pass {
+    std::string name;
+    std::function<void()> execute;
+    std::vector<ResourceHandle> reads;
+    std::vector<ResourceHandle> writes;
+    bool contributes = true;
+    bool live = false;
+  };
+
+  void cull();
+  bool allocate();
+
+  std::vector<Resource> resources;
+  std::vector<Pass> passes;
+  std::vector<size_t> liveOrder;
+  std::vector<TargetDesc> physical;
+};
+
+// Tiempos por pasada acumulados entre frames (ultimas 'window' muestras)
+class PassTimings {
+public:
+  explicit PassTimings(size_t window = 1024);
+
+  void addCpu(const std::string &pass, double ms);
+  void addGpu(const std::string &pass, double ms);
+  void clear() { entries.clear(); }
+
+  // Una linea por pasada, en orden de primera aparicion
+  std::string report() const;
+
+private:
+  struct Entry {
+    std::string name;
+    std::vector<double> cpuMs;
+    std::vector<double> gpuMs;
+    size_t cpuNext = 0;
+    size_t gpuNext = 0;
+  };
+  Entry &entry(const std::string &pass);
+  void push(std::vector<double> &samples, size_t &next, double ms);
+
+  size_t window;
+  std::vector<Entry> entries;
+};
+
+// "21.1 MB"
+std::string formatTargetBytes(size_t bytes);
@@ -0,0 +1,71 @@
+#include "RenderTargetPool.h"
+
+#include <glad/glad.h>
+
+RenderTargetPool::~RenderTargetPool() {
+  for (Target &target : targets)
+    release(target);
+}
+
+void RenderTargetPool::release(Target &target) {
+  if (target.fbo != 0)
+    glDeleteFramebuffers(1, &target.fbo);
+  if (target.texture != 0)
+    glDeleteTextures(1, &target.texture);
+  target = Target();
+}
+
+void RenderTargetPool::sync(const std::vector<TargetDesc> &slots) {
+  while (targets.size() > slots.size()) {
+    release(targets.back());
+    targets.pop_back();
+  }
+  targets.resize(slots.size());
+
+  for (size_t i = 0; i < slots.size(); i++) {
+    Target &target = targets[i];
+    if (target.texture != 0 && target.desc == slots[i])
+      continue;
+    release(target);
+    target.desc = slots[i];
+
+    GLenum internal = GL_RGBA16F, format = GL_RGBA, type = GL_FLOAT;
+    if (target.desc.format == TargetFormat::RGBA8) {
+      internal = GL_RGBA8;
+      type = GL_UNSIGNED_BYTE;
+    } else if (target.desc.format == TargetFormat::R32F) {
+      internal = GL_R32F;
+      format = GL_RED;
+    }
+    glGenTextures(1, &target.texture);
+    glBindTexture(GL_TEXTURE_2D, target.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, internal, target.desc.width,
+                 target.desc.height, 0, format, type, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenFramebuffers(1, &target.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           target.texture, 0);
+    created++;
+  }
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+unsigned int RenderTargetPool::texture(int slot) const {
+  return slot >= 0 && slot < (int)targets.size() ? targets[slot].texture : 0;
+}
+
+unsigned int RenderTargetPool::framebuffer(int slot) const {
+  return slot >= 0 && slot < (int)targets.size() ? targets[slot].fbo : 0;
+}
+
+size_t RenderTargetPool::bytes() const {
+  size_t total = 0;
+  for (const Target &target : targets)
+    total += target.desc.bytes();
+  return total;
+}
@@ -0,0 +1,39 @@
+#pragma once
+/*
+ * RenderTargetPool - Texturas fisicas (y su FBO) de los slots de RenderGraph
+ * Se conservan entre frames; un slot solo se recrea si cambia su
+ * descriptor (resize) y los que sobran se liberan
+ */
+
+#include "RenderGraph.h"
+
+#include <cstddef>
+#include <vector>
+
+class RenderTargetPool {
+public:
+  RenderTargetPool() = default;
+  ~RenderTargetPool();
+  RenderTargetPool(const RenderTargetPool &) = delete;
+  RenderTargetPool &operator=(const RenderTargetPool &) = delete;
+
+  void sync(const std::vector<TargetDesc> &slots);
+
+  // 0 para slot -1 (target descartado este frame)
+  unsigned int texture(int slot) const;
+  unsigned int framebuffer(int slot) const;
+
+  size_t bytes() const;
+  size_t allocations() const { return created; }
+
+private:
+  struct Target {
+    TargetDesc desc;
+    unsigned int texture = 0;
+    unsigned int fbo = 0;
+  };
+  void release(Target &target);
+
+  std::vector<Target> targets;
+  size_t created = 0;
+};
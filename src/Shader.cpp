@@ -0,0 +1,82 @@
+#include "Shader.h"
+#include "ShaderSource.h"
+
+#include <glad/glad.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+std::string readFile(const std::string &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    std::cerr << "Error abriendo: " << path << std::endl;
+    return "";
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  return buffer.str();
+}
+
+std::string loadShaderSource(const std::string &path) {
+  size_t slash = path.find_last_of("/\\");
+  std::string dir = slash == std::string::npos ? "" : path.substr(0, slash + 1);
+  return expandIncludes(readFile(path), [&dir](const std::string &name) {
+    return readFile(dir + name);
+  });
+}
+
+static unsigned int compileStage(unsigned int type, const char *code,
+                                 const char *label) {
+  int success;
+  char infoLog[512];
+
+  unsigned int shader = glCreateShader(type);
+  glShaderSource(shader, 1, &code, nullptr);
+  glCompileShader(shader);
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+  if (!success) {
+    glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+    std::cerr << label << " shader error: " << infoLog << std::endl;
+  }
+  return shader;
+}
+
+static void linkProgram(unsigned int program) {
+  int success;
+  char infoLog[512];
+
+  glLinkProgram(program);
+  glGetProgramiv(program, GL_LINK_STATUS, &success);
+  if (!success) {
+    glGetProgramInfoLog(program, 512, nullptr, infoLog);
+    std::cerr << "Shader link error: " << infoLog << std::endl;
+  }
+}
+
+unsigned int createShader(const char *vertexCode, const char *fragmentCode) {
+  unsigned int vs = compileStage(GL_VERTEX_SHADER, vertexCode, "Vertex");
+  unsigned int fs = compileStage(GL_FRAGMENT_SHADER, fragmentCode, "Fragment");
+
+  unsigned int program = glCreateProgram();
+  glAttachShader(program, vs);
+  glAttachShader(program, fs);
+  linkProgram(program);
+
+  glDeleteShader(vs);
+  glDeleteShader(fs);
+
+  return program;
+}
+
+unsigned int createComputeShader(const char *computeCode) {
+  unsigned int cs = compileStage(GL_COMPUTE_SHADER, computeCode, "Compute");
+
+  unsigned int program = glCreateProgram();
+  glAttachShader(program, cs);
+  linkProgram(program);
+
+  glDeleteShader(cs);
+
+  return program;
+}
@@ -0,0 +1,14 @@
+#pragma once
+/*
+ * Shader - Carga y compilacion de programas GLSL
+ */
+
+#include <string>
+
+std::string readFile(const std::string &path);
+
+// Lee un shader y expande '#include "x"' relativo a su directorio
+std::string loadShaderSource(const std::string &path);
+
+unsigned int createShader(const char *vertexCode, const char *fragmentCode);
+unsigned int createComputeShader(const char *computeCode);
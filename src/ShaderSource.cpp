@@ -0,0 +1,37 @@
+#include "ShaderSource.h"
+
+#include <set>
+#include <sstream>
+
+static std::string expand(
+    const std::string &source,
+    const std::function<std::string(const std::string &)> &loader,
+    std::set<std::string> &included) {
+  std::istringstream in(source);
+  std::string out;
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t pos = line.find_first_not_of(" \t");
+    if (pos != std::string::npos && line.compare(pos, 8, "#include") == 0) {
+      size_t open = line.find('"', pos);
+      size_t close =
+          open == std::string::npos ? open : line.find('"', open + 1);
+      if (close != std::string::npos) {
+        std::string name = line.substr(open + 1, close - open - 1);
+        if (included.insert(name).second)
+          out += expand(loader(name), loader, included);
+        continue;
+      }
+    }
+    out += line;
+    out += '\n';
+  }
+  return out;
+}
+
+std::string expandIncludes(
+    const std::string &source,
+    const std::function<std::string(const std::string &)> &loader) {
+  std::set<std::string> included;
+  return expand(source, loader, included);
+}
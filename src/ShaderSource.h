@@ -0,0 +1,14 @@
+#pragma once
+/*
+ * ShaderSource - Preprocesado minimo de GLSL
+ * Sustituye lineas '#include "archivo"' para compartir codigo entre shaders
+ */
+
+#include <functional>
+#include <string>
+
+// loader(nombre) devuelve el contenido del archivo incluido ("" si falta).
+// Cada archivo se incluye una sola vez (como #pragma once).
+std::string expandIncludes(
+    const std::string &source,
+    const std::function<std::string(const std::string &)> &loader);
@@ -0,0 +1,101 @@
+#include "SharedAnalysis.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+SharedAnalysisWriter::~SharedAnalysisWriter() { close(); }
+
+bool SharedAnalysisWriter::create(const std::string &shmName,
+                                  uint32_t capacity) {
+  close();
+  size_t size = AnalysisRing::bytesFor(capacity);
+
+  // Un segmento viejo de un servidor caido puede tener otro tamaño
+  shm_unlink(shmName.c_str());
+  int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    std::cerr << "shm_open(" << shmName << "): " << std::strerror(errno)
+              << std::endl;
+    return false;
+  }
+  if (ftruncate(fd, (off_t)size) != 0) {
+    std::cerr << "ftruncate: " << std::strerror(errno) << std::endl;
+    ::close(fd);
+    shm_unlink(shmName.c_str());
+    return false;
+  }
+  void *mapped =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED) {
+    std::cerr << "mmap: " << std::strerror(errno) << std::endl;
+    shm_unlink(shmName.c_str());
+    return false;
+  }
+
+  AnalysisRing::format(mapped, size, capacity);
+  name = shmName;
+  memory = mapped;
+  bytes = size;
+  writer = AnalysisRingWriter(memory);
+  return true;
+}
+
+void SharedAnalysisWriter::close() {
+  if (!memory)
+    return;
+  munmap(memory, bytes);
+  shm_unlink(name.c_str());
+  memory = nullptr;
+  bytes = 0;
+  writer = AnalysisRingWriter();
+}
+
+SharedAnalysisReader::~SharedAnalysisReader() { detach(); }
+
+bool SharedAnalysisReader::attach(const std::string &shmName) {
+  detach();
+  int fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    std::cerr << "shm_open(" << shmName << "): " << std::strerror(errno)
+              << std::endl;
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    ::close(fd);
+    return false;
+  }
+  size_t size = (size_t)info.st_size;
+  void *mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED) {
+    std::cerr << "mmap: " << std::strerror(errno) << std::endl;
+    return false;
+  }
+  if (!AnalysisRing::validate(mapped, size)) {
+    std::cerr << shmName << ": not an analysis ring" << std::endl;
+    munmap(mapped, size);
+    return false;
+  }
+
+  memory = mapped;
+  bytes = size;
+  reader = AnalysisRingReader(memory);
+  return true;
+}
+
+void SharedAnalysisReader::detach() {
+  if (!memory)
+    return;
+  munmap(const_cast<void *>(memory), bytes);
+  memory = nullptr;
+  bytes = 0;
+  reader = AnalysisRingReader();
+}
@@ -0,0 +1,75 @@
+#pragma once
+/*
+ * SharedAnalysis - AnalysisRing en memoria compartida POSIX (shm_open)
+ * Un proceso analizador publica; cada renderer lo mapea en solo lectura.
+ */
+
+#include "AnalysisRing.h"
+#include "AudioSource.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+constexpr const char *DEFAULT_ANALYSIS_SHM = "/neon-analysis";
+
+class SharedAnalysisWriter {
+public:
+  SharedAnalysisWriter() = default;
+  ~SharedAnalysisWriter();
+  SharedAnalysisWriter(const SharedAnalysisWriter &) = delete;
+  SharedAnalysisWriter &operator=(const SharedAnalysisWriter &) = delete;
+
+  // Crea (o recrea) el segmento; name empieza por '/'
+  bool create(const std::string &name, uint32_t capacity = 256);
+
+  // Desmapea y borra el nombre; los lectores ya mapeados siguen leyendo
+  void close();
+
+  uint64_t publish(const AudioFrame &frame) { return writer.publish(frame); }
+
+private:
+  std::string name;
+  void *memory = nullptr;
+  size_t bytes = 0;
+  AnalysisRingWriter writer;
+};
+
+class SharedAnalysisReader {
+public:
+  SharedAnalysisReader() = default;
+  ~SharedAnalysisReader();
+  SharedAnalysisReader(const SharedAnalysisReader &) = delete;
+  SharedAnalysisReader &operator=(const SharedAnalysisReader &) = delete;
+
+  // Mapea PROT_READ; falla si no existe o el formato no coincide
+  bool attach(const std::string &name);
+  void detach();
+  bool attached() const { return memory != nullptr; }
+
+  uint64_t latestSequence() const { return reader.latestSequence(); }
+  RingRead read(uint64_t sequence, AudioFrame &out) const {
+    return reader.read(sequence, out);
+  }
+  bool readLatest(AudioFrame &out) const { return reader.readLatest(out); }
+
+private:
+  const void *memory = nullptr;
+  size_t bytes = 0;
+  AnalysisRingReader reader;
+};
+
+// Renderer alimentado por un neon_analysisd externo
+class SharedAnalysisSource : public AudioSource {
+public:
+  bool attach(const std::string &name) { return reader.attach(name); }
+
+  AudioFrame latest() const override {
+    AudioFrame frame;
+    reader.readLatest(frame);
+    return frame;
+  }
+
+private:
+  SharedAnalysisReader reader;
+};
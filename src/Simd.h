@@ -0,0 +1,107 @@
+#pragma once
+/*
+ * Simd - Vector de 4 floats para el camino CPU (un pixel RGBA o cuatro
+ * muestras de ruido). SSE2 en x86-64 (siempre disponible); en otras CPUs
+ * cae a escalar con los mismos resultados
+ */
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NEON_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+struct F4 {
+#ifdef NEON_SIMD_SSE2
+  __m128 v;
+
+  F4() : v(_mm_setzero_ps()) {}
+  explicit F4(__m128 value) : v(value) {}
+  explicit F4(float s) : v(_mm_set1_ps(s)) {}
+  F4(float x, float y, float z, float w) : v(_mm_setr_ps(x, y, z, w)) {}
+
+  static F4 load(const float *p) { return F4(_mm_loadu_ps(p)); }
+  void store(float *p) const { _mm_storeu_ps(p, v); }
+
+  friend F4 operator+(F4 a, F4 b) { return F4(_mm_add_ps(a.v, b.v)); }
+  friend F4 operator-(F4 a, F4 b) { return F4(_mm_sub_ps(a.v, b.v)); }
+  friend F4 operator*(F4 a, F4 b) { return F4(_mm_mul_ps(a.v, b.v)); }
+  friend F4 operator/(F4 a, F4 b) { return F4(_mm_div_ps(a.v, b.v)); }
+  friend F4 sqrt(F4 a) { return F4(_mm_sqrt_ps(a.v)); }
+  friend F4 min(F4 a, F4 b) { return F4(_mm_min_ps(a.v, b.v)); }
+  friend F4 max(F4 a, F4 b) { return F4(_mm_max_ps(a.v, b.v)); }
+  friend F4 abs(F4 a) {
+    return F4(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v));
+  }
+  // floor() para |x| < 2^31 (SSE2 no tiene roundps)
+  friend F4 floor(F4 a) {
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+    __m128 fix = _mm_and_ps(_mm_cmpgt_ps(t, a.v), _mm_set1_ps(1.0f));
+    return F4(_mm_sub_ps(t, fix));
+  }
+  // step() de GLSL: 1 si x >= edge, si no 0
+  friend F4 step(F4 edge, F4 x) {
+    return F4(_mm_and_ps(_mm_cmpge_ps(x.v, edge.v), _mm_set1_ps(1.0f)));
+  }
+#else
+  float v[4];
+
+  F4() : v{0.0f, 0.0f, 0.0f, 0.0f} {}
+  explicit F4(float s) : v{s, s, s, s} {}
+  F4(float x, float y, float z, float w) : v{x, y, z, w} {}
+
+  static F4 load(const float *p) { return F4(p[0], p[1], p[2], p[3]); }
+  void store(float *p) const {
+    for (int i = 0; i < 4; i++)
+      p[i] = v[i];
+  }
+
+  template <typename Fn> static F4 map(F4 a, F4 b, Fn fn) {
+    return F4(fn(a.v[0], b.v[0]), fn(a.v[1], b.v[1]), fn(a.v[2], b.v[2]),
+              fn(a.v[3], b.v[3]));
+  }
+  friend F4 operator+(F4 a, F4 b) {
+    return map(a, b, [](float x, float y) { return x + y; });
+  }
+  friend F4 operator-(F4 a, F4 b) {
+    return map(a, b, [](float x, float y) { return x - y; });
+  }
+  friend F4 operator*(F4 a, F4 b) {
+    return map(a, b, [](float x, float y) { return x * y; });
+  }
+  friend F4 operator/(F4 a, F4 b) {
+    return map(a, b, [](float x, float y) { return x / y; });
+  }
+  friend F4 sqrt(F4 a) {
+    return map(a, a, [](float x, float) { return std::sqrt(x); });
+  }
+  friend F4 min(F4 a, F4 b) {
+    return map(a, b, [](float x, float y) { return y < x ? y : x; });
+  }
+  friend F4 max(F4 a, F4 b) {
+    return map(a, b, [](float x, float y) { return x < y ? y : x; });
+  }
+  friend F4 abs(F4 a) {
+    return map(a, a, [](float x, float) { return std::fabs(x); });
+  }
+  friend F4 floor(F4 a) {
+    return map(a, a, [](float x, float) { return std::floor(x); });
+  }
+  friend F4 step(F4 edge, F4 x) {
+    return map(edge, x, [](float e, float y) { return y >= e ? 1.0f : 0.0f; });
+  }
+#endif
+
+  F4 &operator+=(F4 b) { return *this = *this + b; }
+
+  float operator[](int lane) const {
+    float lanes[4];
+    store(lanes);
+    return lanes[lane];
+  }
+};
+
+// a + b * c (sin FMA: mismo resultado en cualquier x86-64)
+inline F4 madd(F4 a, F4 b, F4 c) { return a + b * c; }
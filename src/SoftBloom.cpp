@@ -0,0 +1,118 @@
+#include "SoftBloom.h"
+#include "PostProcess.h"
+#include "Simd.h"
+
+#include <algorithm>
+
+void FloatImage::resize(int w, int h) {
+  width = w;
+  height = h;
+  pixels.assign((size_t)w * h * 4, 0.0f);
+}
+
+namespace {
+
+constexpr int RADIUS = BLOOM_TAPS - 1;
+constexpr size_t ROW_GRAIN = 4;
+
+struct BlurWeights {
+  F4 w[BLOOM_TAPS];
+  BlurWeights() {
+    for (int i = 0; i < BLOOM_TAPS; i++)
+      w[i] = F4(BLOOM_WEIGHTS[i]);
+  }
+};
+
+// Mismo orden de sumas que el shader: centro, luego +i y -i
+inline F4 blurTaps(const float *const taps[2 * RADIUS + 1],
+                   const BlurWeights &bw) {
+  F4 result = F4::load(taps[RADIUS]) * bw.w[0];
+  for (int i = 1; i <= RADIUS; i++) {
+    result = madd(result, F4::load(taps[RADIUS + i]), bw.w[i]);
+    result = madd(result, F4::load(taps[RADIUS - i]), bw.w[i]);
+  }
+  return result;
+}
+
+void blurRow(const float *src, float *dst, int width, const BlurWeights &bw) {
+  const float *taps[2 * RADIUS + 1];
+  auto tapsAt = [&](int x, bool clampEdges) {
+    for (int i = -RADIUS; i <= RADIUS; i++) {
+      int sx = x + i;
+      if (clampEdges)
+        sx = std::min(std::max(sx, 0), width - 1);
+      taps[RADIUS + i] = src + (size_t)sx * 4;
+    }
+  };
+
+  for (int x = 0; x < width; x++) {
+    bool edge = x < RADIUS || x >= width - RADIUS;
+    tapsAt(x, edge);
+    blurTaps(taps, bw).store(dst + (size_t)x * 4);
+  }
+}
+
+void blurColumnRow(const FloatImage &src, float *dst, int y,
+                   const BlurWeights &bw) {
+  const float *rows[2 * RADIUS + 1];
+  for (int i = -RADIUS; i <= RADIUS; i++)
+    rows[RADIUS + i] = src.row(std::min(std::max(y + i, 0), src.height - 1));
+
+  const float *taps[2 * RADIUS + 1];
+  for (int x = 0; x < src.width; x++) {
+    size_t offset = (size_t)x * 4;
+    for (int i = 0; i < 2 * RADIUS + 1; i++)
+      taps[i] = rows[i] + offset;
+    blurTaps(taps, bw).store(dst + offset);
+  }
+}
+
+} // namespace
+
+void blurPass(const FloatImage &src, FloatImage &dst, bool horizontal,
+              ThreadPool &pool) {
+  static const BlurWeights bw;
+  if (dst.width != src.width || dst.height != src.height)
+    dst.resize(src.width, src.height);
+
+  pool.parallelFor((size_t)src.height, ROW_GRAIN, [&](size_t y0, size_t y1) {
+    for (size_t y = y0; y < y1; y++) {
+      if (horizontal)
+        blurRow(src.row((int)y), dst.row((int)y), src.width, bw);
+      else
+        blurColumnRow(src, dst.row((int)y), (int)y, bw);
+    }
+  });
+}
+
+void bloomBlur(const FloatImage &scene, FloatImage &ping, FloatImage &pong,
+               ThreadPool &pool) {
+  blurPass(scene, ping, true, pool);
+  blurPass(ping, pong, false, pool);
+  for (int i = 1; i < BLOOM_ITERATIONS; i++) {
+    blurPass(pong, ping, true, pool);
+    blurPass(ping, pong, false, pool);
+  }
+}
+
+void combineImage(const FloatImage &scene, const FloatImage &bloom,
+                  float bloomStrength, std::vector<uint8_t> &rgb,
+                  ThreadPool &pool) {
+  static const GammaEncoder encode;
+  const int width = scene.width, height = scene.height;
+  rgb.resize((size_t)width * height * 3);
+
+  pool.parallelFor((size_t)height, ROW_GRAIN, [&](size_t y0, size_t y1) {
+    for (size_t y = y0; y < y1; y++) {
+      const float *hdr = scene.row((int)y);
+      const float *blur = bloom.row((int)y);
+      uint8_t *out = rgb.data() + (size_t)(height - 1 - y) * width * 3;
+      for (int x = 0; x < width; x++) {
+        float color[3];
+        combineLinear(hdr + x * 4, blur + x * 4, bloomStrength, color);
+        for (int c = 0; c < 3; c++)
+          out[x * 3 + c] = encode(color[c]);
+      }
+    }
+  });
+}
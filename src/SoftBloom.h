@@ -0,0 +1,36 @@
+#pragma once
+/*
+ * SoftBloom - Blur separable y combine de bloom.frag en CPU (SSE2)
+ * Un pixel RGBA por registro; filas repartidas entre los hilos del pool
+ */
+
+#include "ThreadPool.h"
+
+#include <cstdint>
+#include <vector>
+
+// Imagen RGBA float; fila 0 abajo, como una textura GL
+struct FloatImage {
+  int width = 0;
+  int height = 0;
+  std::vector<float> pixels;
+
+  void resize(int w, int h);
+  float *row(int y) { return pixels.data() + (size_t)y * width * 4; }
+  const float *row(int y) const {
+    return pixels.data() + (size_t)y * width * 4;
+  }
+};
+
+// Pasada de blur de bloom.frag (passType 0) con GL_CLAMP_TO_EDGE
+void blurPass(const FloatImage &src, FloatImage &dst, bool horizontal,
+              ThreadPool &pool);
+
+// El ping-pong de main.cpp: BLOOM_ITERATIONS pares H+V. Resultado en pong
+void bloomBlur(const FloatImage &scene, FloatImage &ping, FloatImage &pong,
+               ThreadPool &pool);
+
+// Pasada de combinacion a RGB 8 bits, fila superior primero (PPM)
+void combineImage(const FloatImage &scene, const FloatImage &bloom,
+                  float bloomStrength, std::vector<uint8_t> &rgb,
+                  ThreadPool &pool);
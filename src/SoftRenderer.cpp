@@ -0,0 +1,313 @@
+#include "SoftRenderer.h"
+#include "Grid.h"
+#include "Nebula.h"
+#include "PostProcess.h"
+#include "Simd.h"
+#include "Starfield.h"
+#include "Transform.h"
+#include "WaveLayers.h"
+#include "WaveMath.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+constexpr float FOV_Y = 45.0f * 3.14159265358979f / 180.0f;
+constexpr float NEAR_PLANE = 0.1f;
+constexpr float FAR_PLANE = 400.0f;
+
+constexpr size_t GEOMETRY_GRAIN = 2048;
+constexpr size_t WAVE_BATCH = 256;
+constexpr size_t TILE_GRAIN = 8;
+
+double elapsedMs(std::chrono::steady_clock::time_point since) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - since)
+      .count();
+}
+
+// Mismo recorte que GL para puntos: se descarta si el vertice sale del
+// volumen de clip (igual que splat_project.comp)
+Splat projectPoint(const Mat4 &mvp, float x, float y, float z, int width,
+                   int height) {
+  Splat s;
+  Vec4 clip = mvp * Vec4{x, y, z, 1.0f};
+  if (clip.w > 0.0f && std::fabs(clip.x) <= clip.w &&
+      std::fabs(clip.y) <= clip.w && std::fabs(clip.z) <= clip.w) {
+    s.x = (clip.x / clip.w * 0.5f + 0.5f) * (float)width;
+    s.y = (clip.y / clip.w * 0.5f + 0.5f) * (float)height;
+    s.size = 1.0f; // El llamador pone max(pointSize, 1)
+  }
+  return s;
+}
+
+// Disco duro de stars.frag / brillo suave de shader.frag
+inline float splatWeight(const Splat &s, float dx, float dy) {
+  if (s.shape == SplatShape::Glow)
+    return splatGlow(dx, dy, s.size);
+  return std::sqrt(dx * dx + dy * dy) / s.size <= 0.5f ? 1.0f : 0.0f;
+}
+
+} // namespace
+
+SoftRenderer::SoftRenderer(int width, int height, unsigned threads)
+    : pool(threads), tiles(makeTileGrid(width, height)), fullWidth(width),
+      fullHeight(height) {
+  scene.resize(width, height);
+  for (size_t i = 0; i < WAVE_LAYER_COUNT; i++)
+    waveGrids.push_back(
+        generateGrid(WAVE_LAYERS[i].gridCount, WAVE_LAYERS[i].spacing));
+  starGrid = generateGrid(STAR_GRID_COUNT, STAR_SPACING);
+}
+
+void SoftRenderer::setNebulaScale(int scale) {
+  nebulaScale = std::max(scale, 1);
+}
+
+void SoftRenderer::setWindow(int width, int height, int x, int y) {
+  fullWidth = width;
+  fullHeight = height;
+  windowX = x;
+  windowY = height - (y + scene.height);
+}
+
+void SoftRenderer::drawNebula(const SoftFrame &frame) {
+  const int width = scene.width, height = scene.height;
+  const float aspect = (float)fullWidth / (float)fullHeight;
+  const float tanHalf = std::tan(FOV_Y / 2.0f);
+  const float gatedAudio = nebulaGatedAudio(frame.bass, frame.mids);
+  const float time = frame.time;
+
+  // El cubo rodea la camara: la direccion de cada pixel en espacio del
+  // cubo es el rayo de vista con la rotacion inversa (traspuesta)
+  Mat4 rotation =
+      transform::rotate(Mat4(), frame.cameraAngleX, 1.0f, 0.0f, 0.0f);
+  rotation = transform::rotate(rotation, frame.cameraAngleY, 0.0f, 1.0f, 0.0f);
+  const F4 scaleX(2.0f / (float)fullWidth), scaleY(2.0f / (float)fullHeight);
+  const float offsetX = (float)windowX, offsetY = (float)windowY;
+  const F4 one(1.0f), rayX(tanHalf * aspect), rayY(tanHalf);
+
+  // 'count' pixeles de una fila con centros wx0, wx0 + step, ... (de 4 en
+  // 4), en coordenadas de la ventana
+  auto shadeRow = [&](float wx0, float step, float wy, int count,
+                      float *out) {
+    wx0 += offsetX;
+    const F4 ry = (F4(wy + offsetY) * scaleY - one) * rayY;
+    const F4 rz(-1.0f);
+    for (int x = 0; x < count; x += 4) {
+      F4 wx = F4(wx0) + F4(step) * F4((float)x, (float)x + 1,
+                                      (float)x + 2, (float)x + 3);
+      F4 rx = (wx * scaleX - one) * rayX;
+      F4 d[3];
+      for (int i = 0; i < 3; i++)
+        d[i] = F4(rotation.at(0, i)) * rx + F4(rotation.at(1, i)) * ry +
+               F4(rotation.at(2, i)) * rz;
+      F4 len = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+      F4 rgb[3];
+      nebulaColor(d[0] / len, d[1] / len, d[2] / len, time, gatedAudio, rgb);
+
+      float lanes[3][4];
+      for (int c = 0; c < 3; c++)
+        rgb[c].store(lanes[c]);
+      for (int lane = 0; lane < 4 && x + lane < count; lane++) {
+        float *pixel = out + (size_t)(x + lane) * 4;
+        F4(lanes[0][lane], lanes[1][lane], lanes[2][lane], 1.0f).store(pixel);
+      }
+    }
+  };
+
+  if (nebulaScale == 1) {
+    pool.parallelFor((size_t)height, 4, [&](size_t y0, size_t y1) {
+      for (size_t y = y0; y < y1; y++)
+        shadeRow(0.5f, 1.0f, y + 0.5f, width, scene.row((int)y));
+    });
+    return;
+  }
+
+  // Rejilla gruesa con muestras en los centros de bloque + bilineal
+  const int s = nebulaScale;
+  const int nx = (width + s - 1) / s + 1, ny = (height + s - 1) / s + 1;
+  if (nebula.width != nx || nebula.height != ny)
+    nebula.resize(nx, ny);
+  pool.parallelFor((size_t)ny, 2, [&](size_t y0, size_t y1) {
+    for (size_t y = y0; y < y1; y++)
+      shadeRow(0.5f * s, (float)s, (y + 0.5f) * s, nx, nebula.row((int)y));
+  });
+
+  pool.parallelFor((size_t)height, 8, [&](size_t y0, size_t y1) {
+    for (size_t y = y0; y < y1; y++) {
+      float fy = std::max((y + 0.5f) / s - 0.5f, 0.0f);
+      int iy = std::min((int)fy, ny - 2);
+      F4 ty(fy - iy), sy(1.0f - (fy - iy));
+      const float *r0 = nebula.row(iy), *r1 = nebula.row(iy + 1);
+      float *out = scene.row((int)y);
+      for (int x = 0; x < width; x++) {
+        float fx = std::max((x + 0.5f) / s - 0.5f, 0.0f);
+        int ix = std::min((int)fx, nx - 2);
+        F4 tx(fx - ix), sx(1.0f - (fx - ix));
+        F4 top = F4::load(r1 + ix * 4) * sx + F4::load(r1 + ix * 4 + 4) * tx;
+        F4 bottom =
+            F4::load(r0 + ix * 4) * sx + F4::load(r0 + ix * 4 + 4) * tx;
+        (bottom * sy + top * ty).store(out + x * 4);
+      }
+    }
+  });
+}
+
+void SoftRenderer::buildSplats(const SoftFrame &frame) {
+  const int width = scene.width, height = scene.height;
+  const bool fullWindow = width == fullWidth && height == fullHeight;
+  const Mat4 projection =
+      fullWindow ? transform::perspective(FOV_Y, (float)width / (float)height,
+                                          NEAR_PLANE, FAR_PLANE)
+                 : transform::offCenterPerspective(
+                       FOV_Y, fullWidth, fullHeight, windowX, windowY, width,
+                       height, NEAR_PLANE, FAR_PLANE);
+
+  const size_t starCount = starGrid.size() / 2;
+  size_t total = starCount * STAR_PANEL_COUNT;
+  for (const std::vector<float> &grid : waveGrids)
+    total += grid.size() / 2;
+  splats.resize(total);
+
+  // Orden de dibujado de main.cpp: paneles de estrellas y luego far, main,
+  // near. Cada splat tiene indice fijo, asi el binning no depende de hilos
+  size_t base = 0;
+  for (size_t panel = 0; panel < STAR_PANEL_COUNT; panel++) {
+    Mat4 mvp = projection * starPanelView(panel, frame.cameraAngleX,
+                                          frame.cameraAngleY);
+    Splat *out = splats.data() + base;
+    pool.parallelFor(starCount, GEOMETRY_GRAIN, [&](size_t b, size_t e) {
+      for (size_t i = b; i < e; i++) {
+        StarSprite star = evaluateStar(starGrid[2 * i], starGrid[2 * i + 1],
+                                       frame.time, frame.bass, frame.treble);
+        Splat s = projectPoint(mvp, star.x, star.y, 0.0f, width, height);
+        if (s.size > 0.0f) {
+          s.size = std::max(star.size, 1.0f);
+          float rgb[3];
+          starColor(star.brightness, rgb);
+          s.r = rgb[0];
+          s.g = rgb[1];
+          s.b = rgb[2];
+        }
+        s.shape = SplatShape::Disc;
+        out[i] = s;
+      }
+    });
+    base += starCount;
+  }
+
+  for (size_t layer = 0; layer < WAVE_LAYER_COUNT; layer++) {
+    const WaveLayerDesc &desc = WAVE_LAYERS[layer];
+    const std::vector<float> &grid = waveGrids[layer];
+    const size_t count = grid.size() / 2;
+    Mat4 mvp = projection * waveLayerView(layer, frame.cameraDistance,
+                                          frame.cameraAngleX,
+                                          frame.cameraAngleY);
+    WaveParams params;
+    params.time = frame.time;
+    params.gridSize = desc.gridSize();
+    params.bass = frame.bass;
+    params.mids = frame.mids;
+    params.treble = frame.treble;
+    ParticleStyle style;
+    style.intensity = desc.intensity;
+    style.peakExp = desc.peakExp;
+
+    Splat *out = splats.data() + base;
+    pool.parallelFor(count, GEOMETRY_GRAIN, [&](size_t b, size_t e) {
+      WavePoint points[WAVE_BATCH];
+      for (size_t batch = b; batch < e; batch += WAVE_BATCH) {
+        size_t n = std::min(WAVE_BATCH, e - batch);
+        evaluateWaveGrid(grid.data() + 2 * batch, n, params, points);
+        for (size_t i = 0; i < n; i++) {
+          const WavePoint &p = points[i];
+          Splat s = projectPoint(mvp, p.x, p.y, p.z, width, height);
+          if (s.size > 0.0f) {
+            ParticleLook look = particleAppearance(p, params, style);
+            s.size = std::max(look.size, 1.0f);
+            s.r = look.r;
+            s.g = look.g;
+            s.b = look.b;
+          }
+          out[batch + i] = s;
+        }
+      }
+    });
+    base += count;
+  }
+}
+
+void SoftRenderer::rasterTiles() {
+  const int width = scene.width, height = scene.height;
+  const int tileSize = tiles.tileSize;
+
+  // Un tile = un hilo: cada pixel suma sus splats en orden de dibujado
+  // (como el blend GL_ONE, GL_ONE) sin atomics
+  pool.parallelFor((size_t)tiles.count(), TILE_GRAIN, [&](size_t b,
+                                                            size_t e) {
+    for (size_t t = b; t < e; t++) {
+      const int tileX0 = (int)(t % tiles.tilesX) * tileSize;
+      const int tileY0 = (int)(t / tiles.tilesX) * tileSize;
+      const int tileX1 = std::min(tileX0 + tileSize, width) - 1;
+      const int tileY1 = std::min(tileY0 + tileSize, height) - 1;
+
+      const uint32_t begin = bins.offsets[t];
+      const uint32_t end = begin + bins.counts[t];
+      for (uint32_t k = begin; k < end; k++) {
+        const Splat &s = splats[bins.indices[k]];
+        const float radius = s.size * 0.5f;
+        int px0 = std::max((int)std::ceil(s.x - radius - 0.5f), tileX0);
+        int py0 = std::max((int)std::ceil(s.y - radius - 0.5f), tileY0);
+        int px1 = std::min((int)std::floor(s.x + radius - 0.5f), tileX1);
+        int py1 = std::min((int)std::floor(s.y + radius - 0.5f), tileY1);
+
+        const F4 color(s.r, s.g, s.b, 0.0f);
+        for (int py = py0; py <= py1; py++) {
+          float dy = py + 0.5f - s.y;
+          float *row = scene.row(py);
+          for (int px = px0; px <= px1; px++) {
+            float w = splatWeight(s, px + 0.5f - s.x, dy);
+            if (w <= 0.0f)
+              continue;
+            float *pixel = row + px * 4;
+            madd(F4::load(pixel), color, F4(w)).store(pixel);
+          }
+        }
+      }
+    }
+  });
+}
+
+void SoftRenderer::render(const SoftFrame &frame) {
+  using clock = std::chrono::steady_clock;
+
+  // Skybox sin blend: sobrescribe todo el sceneColorBuffer
+  auto start = clock::now();
+  drawNebula(frame);
+  stageTimes.nebulaMs = elapsedMs(start);
+
+  start = clock::now();
+  buildSplats(frame);
+  stageTimes.geometryMs = elapsedMs(start);
+
+  start = clock::now();
+  binSplats(splats.data(), splats.size(), scene.width, scene.height, tiles,
+            bins);
+  stageTimes.binMs = elapsedMs(start);
+
+  start = clock::now();
+  rasterTiles();
+  stageTimes.rasterMs = elapsedMs(start);
+
+  start = clock::now();
+  bloomBlur(scene, ping, pong, pool);
+  stageTimes.bloomMs = elapsedMs(start);
+
+  start = clock::now();
+  combineImage(scene, pong, bloomStrengthFor(frame.cameraDistance), rgb,
+               pool);
+  stageTimes.combineMs = elapsedMs(start);
+}
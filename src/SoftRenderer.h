@@ -0,0 +1,89 @@
+#pragma once
+/*
+ * SoftRenderer - Pipeline completo de main.cpp en CPU (nodos sin GPU)
+ * Nebulosa, estrellas y las tres capas Gerstner como point sprites en un
+ * splatter por tiles multihilo, acumulacion aditiva en float, bloom
+ * separable SSE2 y el mismo combine que bloom.frag.
+ * Determinista: la imagen no depende del numero de hilos
+ */
+
+#include "SoftBloom.h"
+#include "SplatBinning.h"
+#include "ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Lo que main.cpp pasa como uniforms en un frame
+struct SoftFrame {
+  float time = 0.0f; // accumulatedTime
+  float bass = 0.0f;
+  float mids = 0.0f;
+  float treble = 0.0f;
+  float cameraDistance = 2.5f;
+  float cameraAngleX = 0.5f;
+  float cameraAngleY = 0.0f;
+};
+
+struct SoftStageTimes {
+  double nebulaMs = 0.0;
+  double geometryMs = 0.0; // Ondas + estrellas + proyeccion
+  double binMs = 0.0;
+  double rasterMs = 0.0;
+  double bloomMs = 0.0;
+  double combineMs = 0.0;
+  double totalMs() const {
+    return nebulaMs + geometryMs + binMs + rasterMs + bloomMs + combineMs;
+  }
+};
+
+class SoftRenderer {
+public:
+  // threads = 0: todos los nucleos
+  SoftRenderer(int width, int height, unsigned threads = 0);
+
+  // La nebulosa es de baja frecuencia: se evalua 1 de cada scale x scale
+  // pixeles y se interpola (1 = exacto por pixel)
+  void setNebulaScale(int scale);
+
+  // Tile de una pared (VideoWall): la imagen es la ventana (x, y), con y
+  // desde arriba, de una camara de fullWidth x fullHeight. Por defecto la
+  // ventana es la imagen entera
+  void setWindow(int fullWidth, int fullHeight, int x, int y);
+
+  void render(const SoftFrame &frame);
+
+  int width() const { return scene.width; }
+  int height() const { return scene.height; }
+  unsigned threads() const { return pool.size(); }
+
+  // RGB 8 bits, fila superior primero
+  const std::vector<uint8_t> &image() const { return rgb; }
+  // HDR antes del bloom (sceneColorBuffer), fila 0 abajo
+  const FloatImage &hdr() const { return scene; }
+
+  const SoftStageTimes &times() const { return stageTimes; }
+  size_t splatCount() const { return splats.size(); }
+
+private:
+  void drawNebula(const SoftFrame &frame);
+  void buildSplats(const SoftFrame &frame);
+  void rasterTiles();
+
+  ThreadPool pool;
+  TileGrid tiles;
+  int nebulaScale = 1;
+  // Ventana en la imagen completa; y desde abajo como la proyeccion
+  int fullWidth, fullHeight;
+  int windowX = 0, windowY = 0;
+
+  std::vector<std::vector<float>> waveGrids;
+  std::vector<float> starGrid;
+
+  FloatImage scene, ping, pong, nebula;
+  std::vector<Splat> splats;
+  TileBins bins;
+  std::vector<uint8_t> rgb;
+  SoftStageTimes stageTimes;
+};
@@ -0,0 +1,42 @@
+#include "Spectrogram.h"
+
+#include <algorithm>
+
+SpectrogramHistory::SpectrogramHistory(size_t bins, size_t rows)
+    : binCount(bins), rowCount(rows), headRow(rows - 1),
+      texels(bins * rows, 0.0f) {}
+
+size_t SpectrogramHistory::push(const float *row) {
+  headRow = (headRow + 1) % rowCount;
+  std::copy(row, row + binCount, texels.begin() + headRow * binCount);
+  total++;
+  return headRow;
+}
+
+size_t SpectrogramHistory::rowForAge(size_t age) const {
+  return (headRow + rowCount - age % rowCount) % rowCount;
+}
+
+const float *SpectrogramHistory::row(size_t index) const {
+  return texels.data() + index * binCount;
+}
+
+float SpectrogramHistory::sample(size_t age, size_t bin) const {
+  return row(rowForAge(age))[bin];
+}
+
+size_t SpectrogramClock::advance(uint64_t timestampNs, size_t maxRows) {
+  if (anchorNs == 0) {
+    anchorNs = timestampNs;
+    return 1;
+  }
+  if (timestampNs < anchorNs)
+    return 0;
+  uint64_t rows = (timestampNs - anchorNs) / SPECTROGRAM_ROW_NS;
+  if (rows > maxRows) {
+    anchorNs = timestampNs; // Hueco largo: la historia entera es nueva
+    return maxRows;
+  }
+  anchorNs += rows * SPECTROGRAM_ROW_NS;
+  return (size_t)rows;
+}
@@ -0,0 +1,58 @@
+#pragma once
+/*
+ * Spectrogram - Historial circular de filas de espectro
+ * Misma disposicion que la textura (fila = un analisis, columna = bin):
+ * la GPU recibe solo las filas nuevas con glTexSubImage2D
+ */
+
+#include "AudioFrame.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ~2.7 s de historia a 1024 muestras / 48 kHz por fila
+constexpr size_t SPECTROGRAM_ROWS = 128;
+constexpr uint64_t SPECTROGRAM_ROW_NS = 1024ull * 1000000000ull / 48000;
+
+class SpectrogramHistory {
+public:
+  explicit SpectrogramHistory(size_t bins = SPECTRUM_BINS,
+                              size_t rows = SPECTROGRAM_ROWS);
+
+  // Copia bins() valores como fila mas reciente; devuelve su indice
+  size_t push(const float *row);
+
+  size_t bins() const { return binCount; }
+  size_t rows() const { return rowCount; }
+  size_t head() const { return headRow; } // Fila mas reciente
+  uint64_t pushes() const { return total; }
+
+  // Indice de la fila de hace age analisis (0 = la mas reciente)
+  size_t rowForAge(size_t age) const;
+  const float *row(size_t index) const;
+  float sample(size_t age, size_t bin) const;
+
+  // rows() x bins(), fila a fila (tal cual la textura)
+  const std::vector<float> &data() const { return texels; }
+
+private:
+  size_t binCount;
+  size_t rowCount;
+  size_t headRow;
+  uint64_t total = 0;
+  std::vector<float> texels;
+};
+
+// Filas que tocan a cada analisis segun su timestamp: la historia avanza una
+// fila por SPECTROGRAM_ROW_NS sea cual sea el ritmo del motor (FFT un
+// analisis por fila, filterbank muchos). Si un frame se salto analisis, el
+// ultimo se repite para que la edad de cada fila siga siendo tiempo real.
+class SpectrogramClock {
+public:
+  // Filas a añadir por un analisis nuevo (1 el primero, como mucho maxRows)
+  size_t advance(uint64_t timestampNs, size_t maxRows);
+
+private:
+  uint64_t anchorNs = 0; // Instante de la ultima fila añadida
+};
@@ -0,0 +1,68 @@
+#include "SpectrogramTexture.h"
+
+#include <glad/glad.h>
+
+#include <chrono>
+
+SpectrogramTexture::~SpectrogramTexture() { glDeleteTextures(1, &textureId); }
+
+void SpectrogramTexture::initialize(size_t bins, size_t rows) {
+  binCount = bins;
+  rowCount = rows;
+  glGenTextures(1, &textureId);
+  glBindTexture(GL_TEXTURE_2D, textureId);
+  glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32F, (GLsizei)bins, (GLsizei)rows);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+  std::vector<float> zeros(bins * rows, 0.0f);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, (GLsizei)bins, (GLsizei)rows,
+                  GL_RED, GL_FLOAT, zeros.data());
+}
+
+size_t SpectrogramTexture::update(const SpectrogramHistory &history) {
+  auto start = std::chrono::steady_clock::now();
+  uint64_t fresh = history.pushes() - uploadedPushes;
+  head = history.head();
+  if (fresh == 0)
+    return 0;
+
+  glBindTexture(GL_TEXTURE_2D, textureId);
+  if (fresh >= rowCount) {
+    // Solo tras un parón largo: el ring entero cambio
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, (GLsizei)binCount,
+                    (GLsizei)rowCount, GL_RED, GL_FLOAT,
+                    history.data().data());
+    fullUploadCount++;
+  } else {
+    for (uint64_t age = fresh; age-- > 0;) {
+      size_t row = history.rowForAge((size_t)age);
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, (GLint)row, (GLsizei)binCount, 1,
+                      GL_RED, GL_FLOAT, history.row(row));
+    }
+    rowUploads += fresh;
+  }
+  uploadedPushes = history.pushes();
+
+  uploadUs.push_back(std::chrono::duration<double, std::micro>(
+                         std::chrono::steady_clock::now() - start)
+                         .count());
+  return (size_t)fresh;
+}
+
+void SpectrogramTexture::apply(unsigned int program,
+                               const AudioHistoryParams &params) const {
+  glActiveTexture(GL_TEXTURE0 + SPECTROGRAM_TEXTURE_UNIT);
+  glBindTexture(GL_TEXTURE_2D, textureId);
+  glActiveTexture(GL_TEXTURE0);
+  glUniform1i(glGetUniformLocation(program, "uSpectrogram"),
+              SPECTROGRAM_TEXTURE_UNIT);
+  glUniform1f(glGetUniformLocation(program, "uSpectrogramHead"), (float)head);
+  glUniform1f(glGetUniformLocation(program, "uSpectrogramRows"),
+              (float)rowCount);
+  glUniform1f(glGetUniformLocation(program, "uHistoryOrigin"), params.origin);
+  glUniform1f(glGetUniformLocation(program, "uHistoryRowsPerUnit"),
+              params.rowsPerUnit);
+}
@@ -0,0 +1,55 @@
+#pragma once
+/*
+ * SpectrogramTexture - Copia en GPU de SpectrogramHistory (GL_R32F)
+ * Cada frame sube solo las filas nuevas (glTexSubImage2D de una fila);
+ * GL_REPEAT en T deja que los shaders lean el ring por edad sin saltos
+ */
+
+#include "Spectrogram.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Unidad de textura reservada al historial (0 y 1 los usa el bloom)
+constexpr int SPECTROGRAM_TEXTURE_UNIT = 2;
+
+// Propagacion del audio por distancia a la camara (particle.glsl)
+struct AudioHistoryParams {
+  float origin = 1.0f;      // Distancia que ve el audio actual
+  float rowsPerUnit = 0.0f; // Filas de retraso por unidad (0 = apagado)
+};
+
+class SpectrogramTexture {
+public:
+  SpectrogramTexture() = default;
+  ~SpectrogramTexture();
+  SpectrogramTexture(const SpectrogramTexture &) = delete;
+  SpectrogramTexture &operator=(const SpectrogramTexture &) = delete;
+
+  void initialize(size_t bins = SPECTRUM_BINS,
+                  size_t rows = SPECTROGRAM_ROWS);
+
+  // Sube las filas añadidas desde la ultima llamada; devuelve cuantas
+  size_t update(const SpectrogramHistory &history);
+
+  // Enlaza la textura y fija uSpectrogram* / uHistory* en program (en uso)
+  void apply(unsigned int program, const AudioHistoryParams &params) const;
+
+  unsigned int texture() const { return textureId; }
+
+  // Coste CPU de cada update() que subio filas, en microsegundos
+  const std::vector<double> &uploadMicros() const { return uploadUs; }
+  uint64_t rowsUploaded() const { return rowUploads; }
+  uint64_t fullUploads() const { return fullUploadCount; }
+
+private:
+  unsigned int textureId = 0;
+  size_t binCount = 0;
+  size_t rowCount = 0;
+  size_t head = 0;
+  uint64_t uploadedPushes = 0;
+  uint64_t rowUploads = 0;
+  uint64_t fullUploadCount = 0;
+  std::vector<double> uploadUs;
+};
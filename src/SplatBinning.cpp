@@ -0,0 +1,84 @@
+#include "SplatBinning.h"
+
+#include <algorithm>
+#include <cmath>
+
+TileGrid makeTileGrid(int width, int height, int tileSize) {
+  TileGrid grid;
+  grid.tileSize = tileSize;
+  grid.tilesX = (width + tileSize - 1) / tileSize;
+  grid.tilesY = (height + tileSize - 1) / tileSize;
+  return grid;
+}
+
+TileRange splatTileRange(float cx, float cy, float size, int width,
+                         int height, const TileGrid &grid) {
+  TileRange range;
+  if (size <= 0.0f)
+    return range;
+
+  // Pixeles con centro (i + 0.5) dentro del radio size/2
+  float radius = size * 0.5f;
+  int px0 = (int)std::ceil(cx - radius - 0.5f);
+  int py0 = (int)std::ceil(cy - radius - 0.5f);
+  int px1 = (int)std::floor(cx + radius - 0.5f);
+  int py1 = (int)std::floor(cy + radius - 0.5f);
+
+  px0 = std::max(px0, 0);
+  py0 = std::max(py0, 0);
+  px1 = std::min(px1, width - 1);
+  py1 = std::min(py1, height - 1);
+  if (px0 > px1 || py0 > py1)
+    return range;
+
+  range.x0 = px0 / grid.tileSize;
+  range.y0 = py0 / grid.tileSize;
+  range.x1 = px1 / grid.tileSize;
+  range.y1 = py1 / grid.tileSize;
+  return range;
+}
+
+float splatGlow(float dx, float dy, float size) {
+  float dist = std::sqrt(dx * dx + dy * dy) / size;
+  if (dist > 0.5f)
+    return 0.0f;
+  // smoothstep(0.0, 0.5, dist)
+  float t = std::min(std::max(dist / 0.5f, 0.0f), 1.0f);
+  return 1.0f - t * t * (3.0f - 2.0f * t);
+}
+
+int maxTilesPerSplat(float maxSize, int tileSize) {
+  // Un intervalo de 'maxSize' pixeles cruza como mucho ceil(size/tile) + 1
+  int perAxis = (int)std::ceil(maxSize / (float)tileSize) + 1;
+  return perAxis * perAxis;
+}
+
+void binSplats(const Splat *splats, size_t count, int width, int height,
+               const TileGrid &grid, TileBins &bins) {
+  bins.counts.assign(grid.count(), 0);
+  bins.offsets.assign(grid.count(), 0);
+
+  for (size_t i = 0; i < count; i++) {
+    TileRange r = splatTileRange(splats[i].x, splats[i].y, splats[i].size,
+                                 width, height, grid);
+    for (int ty = r.y0; ty <= r.y1; ty++)
+      for (int tx = r.x0; tx <= r.x1; tx++)
+        bins.counts[ty * grid.tilesX + tx]++;
+  }
+
+  uint32_t running = 0;
+  for (int t = 0; t < grid.count(); t++) {
+    bins.offsets[t] = running;
+    running += bins.counts[t];
+  }
+
+  bins.indices.resize(running);
+  std::vector<uint32_t> cursor = bins.offsets;
+  for (size_t i = 0; i < count; i++) {
+    TileRange r = splatTileRange(splats[i].x, splats[i].y, splats[i].size,
+                                 width, height, grid);
+    for (int ty = r.y0; ty <= r.y1; ty++)
+      for (int tx = r.x0; tx <= r.x1; tx++)
+        bins.indices[cursor[ty * grid.tilesX + tx]++] = (uint32_t)i;
+  }
+}
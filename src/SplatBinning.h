@@ -0,0 +1,61 @@
+#pragma once
+/*
+ * SplatBinning - Reparto de point sprites en tiles de pantalla
+ * Misma logica que splat_project/splat_scatter.comp (referencia CPU)
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+constexpr int SPLAT_TILE_SIZE = 16; // Igual que TILE_SIZE en los shaders
+
+struct TileGrid {
+  int tilesX = 0;
+  int tilesY = 0;
+  int tileSize = SPLAT_TILE_SIZE;
+  int count() const { return tilesX * tilesY; }
+};
+
+TileGrid makeTileGrid(int width, int height, int tileSize = SPLAT_TILE_SIZE);
+
+// Rango inclusivo de tiles; vacio si x0 > x1 o y0 > y1
+struct TileRange {
+  int x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+  bool empty() const { return x0 > x1 || y0 > y1; }
+  int count() const { return empty() ? 0 : (x1 - x0 + 1) * (y1 - y0 + 1); }
+};
+
+// Tiles cuyos centros de pixel pueden recibir brillo de un punto de
+// tamaño 'size' (gl_PointSize) centrado en (cx, cy) en coordenadas de ventana
+TileRange splatTileRange(float cx, float cy, float size, int width,
+                         int height, const TileGrid &grid);
+
+// Falloff de shader.frag: 1 - smoothstep(0, 0.5, dist) dentro del circulo
+float splatGlow(float dx, float dy, float size);
+
+// Cota de tiles tocados por un punto de tamaño <= maxSize
+int maxTilesPerSplat(float maxSize, int tileSize = SPLAT_TILE_SIZE);
+
+// Perfil del punto: Glow = shader.frag (ondas); Disc = stars.frag, cuyo
+// alpha no llega al color con blend GL_ONE, GL_ONE
+enum class SplatShape : uint8_t { Glow, Disc };
+
+// Punto ya proyectado a ventana
+struct Splat {
+  float x = 0.0f;
+  float y = 0.0f;
+  float size = 0.0f; // 0 = recortado
+  float r = 0.0f, g = 0.0f, b = 0.0f;
+  SplatShape shape = SplatShape::Glow;
+};
+
+// Listas por tile (count + prefix sum + scatter, como en GPU)
+struct TileBins {
+  std::vector<uint32_t> counts;
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> indices;
+};
+
+void binSplats(const Splat *splats, size_t count, int width, int height,
+               const TileGrid &grid, TileBins &bins);
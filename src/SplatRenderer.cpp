@@ -0,0 +1,174 @@
+#include "SplatRenderer.h"
+#include "Shader.h"
+#include "SplatBinning.h"
+
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+
+// std430: vec4 centerSize + vec4 color
+static constexpr size_t SPLAT_STRIDE = 8 * sizeof(float);
+
+// gl_PointSize maximo de shader.vert: (7 + 2 * treble) * intensity
+static float maxPointSize(float intensity) { return 9.0f * intensity; }
+
+static unsigned int loadCompute(const std::string &path) {
+  std::string code = loadShaderSource(path);
+  return createComputeShader(code.c_str());
+}
+
+SplatRenderer::~SplatRenderer() {
+  glDeleteProgram(projectProgram);
+  glDeleteProgram(scanProgram);
+  glDeleteProgram(scatterProgram);
+  glDeleteProgram(rasterProgram);
+  unsigned int buffers[] = {splatBuffer, tileCountBuffer, tileOffsetBuffer,
+                            tileCursorBuffer, tileListBuffer};
+  glDeleteBuffers(5, buffers);
+}
+
+bool SplatRenderer::initialize(const std::string &shaderDir) {
+  projectProgram = loadCompute(shaderDir + "splat_project.comp");
+  scanProgram = loadCompute(shaderDir + "splat_scan.comp");
+  scatterProgram = loadCompute(shaderDir + "splat_scatter.comp");
+  rasterProgram = loadCompute(shaderDir + "splat_raster.comp");
+
+  glCreateBuffers(1, &splatBuffer);
+  glCreateBuffers(1, &tileCountBuffer);
+  glCreateBuffers(1, &tileOffsetBuffer);
+  glCreateBuffers(1, &tileCursorBuffer);
+  glCreateBuffers(1, &tileListBuffer);
+
+  int linked[4];
+  glGetProgramiv(projectProgram, GL_LINK_STATUS, &linked[0]);
+  glGetProgramiv(scanProgram, GL_LINK_STATUS, &linked[1]);
+  glGetProgramiv(scatterProgram, GL_LINK_STATUS, &linked[2]);
+  glGetProgramiv(rasterProgram, GL_LINK_STATUS, &linked[3]);
+  return linked[0] && linked[1] && linked[2] && linked[3];
+}
+
+void SplatRenderer::ensureCapacity(int tileCount, size_t particles,
+                                   size_t listEntries) {
+  // Solo crecen: evita reasignar en cada resize
+  if (tileCount > tileCapacity) {
+    tileCapacity = tileCount;
+    GLsizeiptr bytes = (GLsizeiptr)tileCapacity * sizeof(GLuint);
+    glNamedBufferData(tileCountBuffer, bytes, nullptr, GL_DYNAMIC_COPY);
+    glNamedBufferData(tileOffsetBuffer, bytes, nullptr, GL_DYNAMIC_COPY);
+    glNamedBufferData(tileCursorBuffer, bytes, nullptr, GL_DYNAMIC_COPY);
+  }
+  if (particles > particleCapacity) {
+    particleCapacity = particles;
+    glNamedBufferData(splatBuffer, (GLsizeiptr)(particles * SPLAT_STRIDE),
+                      nullptr, GL_DYNAMIC_COPY);
+  }
+  if (listEntries > listCapacity) {
+    listCapacity = listEntries;
+    glNamedBufferData(tileListBuffer,
+                      (GLsizeiptr)(listEntries * sizeof(GLuint)), nullptr,
+                      GL_DYNAMIC_COPY);
+  }
+}
+
+void SplatRenderer::render(unsigned int sceneTexture, int width, int height,
+                           const SplatFrameUniforms &frame,
+                           const std::vector<SplatLayer> &layers) {
+  TileGrid grid = makeTileGrid(width, height);
+
+  size_t total = 0;
+  size_t listEntries = 0;
+  for (const SplatLayer &layer : layers) {
+    total += (size_t)layer.count;
+    listEntries += (size_t)layer.count *
+                   maxTilesPerSplat(maxPointSize(layer.intensity));
+  }
+  if (total == 0)
+    return;
+  ensureCapacity(grid.count(), total, listEntries);
+
+  GLuint zero = 0;
+  glClearNamedBufferSubData(tileCountBuffer, GL_R32UI, 0,
+                            (GLsizeiptr)grid.count() * sizeof(GLuint),
+                            GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, splatBuffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, tileCountBuffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, tileOffsetBuffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, tileCursorBuffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, tileListBuffer);
+
+  auto setTileUniforms = [&](unsigned int program) {
+    glUniform2i(glGetUniformLocation(program, "uViewport"), width, height);
+    glUniform1i(glGetUniformLocation(program, "uTilesX"), grid.tilesX);
+  };
+
+  // 1. Proyeccion + conteo por tile (un dispatch por capa)
+  glUseProgram(projectProgram);
+  setTileUniforms(projectProgram);
+  glUniform1f(glGetUniformLocation(projectProgram, "time"), frame.time);
+  glUniform1f(glGetUniformLocation(projectProgram, "uBass"), frame.bass);
+  glUniform1f(glGetUniformLocation(projectProgram, "uMids"), frame.mids);
+  glUniform1f(glGetUniformLocation(projectProgram, "uTreble"), frame.treble);
+  if (frame.history)
+    frame.history->apply(projectProgram, frame.historyParams);
+  else
+    glUniform1f(glGetUniformLocation(projectProgram, "uHistoryRowsPerUnit"),
+                0.0f);
+
+  int mvpLoc = glGetUniformLocation(projectProgram, "mvp");
+  int layerOffsetLoc = glGetUniformLocation(projectProgram, "layerOffset");
+  int intensityLoc = glGetUniformLocation(projectProgram, "intensity");
+  int gridSizeLoc = glGetUniformLocation(projectProgram, "uGridSize");
+  int peakExpLoc = glGetUniformLocation(projectProgram, "peakExp");
+  int baseLoc = glGetUniformLocation(projectProgram, "uParticleBase");
+  int countLoc = glGetUniformLocation(projectProgram, "uParticleCount");
+
+  GLuint base = 0;
+  for (const SplatLayer &layer : layers) {
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, layer.gridVBO);
+    glUniformMatrix4fv(mvpLoc, 1, GL_FALSE, glm::value_ptr(layer.mvp));
+    glUniform1f(layerOffsetLoc, layer.layerOffset);
+    glUniform1f(intensityLoc, layer.intensity);
+    glUniform1f(gridSizeLoc, layer.gridSize);
+    glUniform1f(peakExpLoc, layer.peakExp);
+    glUniform1ui(baseLoc, base);
+    glUniform1ui(countLoc, (GLuint)layer.count);
+    glDispatchCompute(((GLuint)layer.count + 255) / 256, 1, 1);
+    base += (GLuint)layer.count;
+  }
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+  // 2. Prefix sum de los conteos
+  glUseProgram(scanProgram);
+  setTileUniforms(scanProgram);
+  glUniform1ui(glGetUniformLocation(scanProgram, "uTileCount"),
+               (GLuint)grid.count());
+  glDispatchCompute(1, 1, 1);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+  // 3. Scatter de indices a las listas de cada tile
+  glUseProgram(scatterProgram);
+  setTileUniforms(scatterProgram);
+  glUniform1ui(glGetUniformLocation(scatterProgram, "uParticleCount"),
+               (GLuint)total);
+  glUniform1ui(glGetUniformLocation(scatterProgram, "uListCapacity"),
+               (GLuint)listCapacity);
+  glDispatchCompute(((GLuint)total + 255) / 256, 1, 1);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+  // 4. Un workgroup por tile: acumula y escribe cada pixel una vez
+  glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+  glUseProgram(rasterProgram);
+  setTileUniforms(rasterProgram);
+  glUniform1ui(glGetUniformLocation(rasterProgram, "uListCapacity"),
+               (GLuint)listCapacity);
+  glBindImageTexture(0, sceneTexture, 0, GL_FALSE, 0, GL_READ_WRITE,
+                     GL_RGBA16F);
+  glDispatchCompute((GLuint)grid.tilesX, (GLuint)grid.tilesY, 1);
+
+  // El blur lee la escena como textura; el siguiente frame limpia los
+  // contadores escritos con atomics
+  glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT |
+                  GL_BUFFER_UPDATE_BARRIER_BIT);
+}
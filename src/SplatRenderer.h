@@ -0,0 +1,67 @@
+#pragma once
+/*
+ * SplatRenderer - Rasterizado por tiles en compute para las capas de ondas
+ * Alternativa a GL_POINTS + blend aditivo: reparte las particulas en tiles
+ * de 16x16, acumula el falloff en el workgroup y escribe cada pixel una vez
+ */
+
+#include "SpectrogramTexture.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Uniforms comunes a todas las capas (mismos que shader.vert)
+struct SplatFrameUniforms {
+  float time = 0.0f;
+  float bass = 0.0f;
+  float mids = 0.0f;
+  float treble = 0.0f;
+  const SpectrogramTexture *history = nullptr; // nullptr: sin propagacion
+  AudioHistoryParams historyParams;
+};
+
+struct SplatLayer {
+  unsigned int gridVBO = 0; // Pares (x, z) de generateGrid()
+  int count = 0;
+  glm::mat4 mvp{1.0f};
+  float layerOffset = 0.0f;
+  float intensity = 1.0f;
+  float gridSize = 1.0f;
+  float peakExp = 1.0f;
+};
+
+class SplatRenderer {
+public:
+  SplatRenderer() = default;
+  ~SplatRenderer();
+  SplatRenderer(const SplatRenderer &) = delete;
+  SplatRenderer &operator=(const SplatRenderer &) = delete;
+
+  bool initialize(const std::string &shaderDir = "shaders/");
+
+  // Suma las capas sobre sceneTexture (GL_RGBA16F, width x height)
+  void render(unsigned int sceneTexture, int width, int height,
+              const SplatFrameUniforms &frame,
+              const std::vector<SplatLayer> &layers);
+
+private:
+  void ensureCapacity(int tileCount, size_t particles, size_t listEntries);
+
+  unsigned int projectProgram = 0;
+  unsigned int scanProgram = 0;
+  unsigned int scatterProgram = 0;
+  unsigned int rasterProgram = 0;
+
+  unsigned int splatBuffer = 0;
+  unsigned int tileCountBuffer = 0;
+  unsigned int tileOffsetBuffer = 0;
+  unsigned int tileCursorBuffer = 0;
+  unsigned int tileListBuffer = 0;
+
+  int tileCapacity = 0;
+  size_t particleCapacity = 0;
+  size_t listCapacity = 0;
+};
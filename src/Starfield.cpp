@@ -0,0 +1,65 @@
+#include "Starfield.h"
+
+#include <cmath>
+
+static float fract(float x) { return x - std::floor(x); }
+
+static float mix(float a, float b, float t) { return a + (b - a) * t; }
+
+float starHash(float x, float y) {
+  return fract(std::sin(x * 127.1f + y * 311.7f) * 43758.5453f);
+}
+
+StarSprite evaluateStar(float px, float py, float time, float bass,
+                        float treble) {
+  StarSprite star;
+  // Jitter para romper la rejilla y deriva lenta
+  star.x = px + (starHash(px, py) - 0.5f) * 1.5f;
+  star.y = py + (starHash(px * 1.5f, py * 1.5f) - 0.5f) * 1.5f;
+  star.y -= time * 0.03f;
+
+  float baseSize = 1.0f + starHash(px * 2.0f, py * 2.0f);
+
+  // Destellos
+  float starId = starHash(px * 7.0f, py * 7.0f);
+  float sparkThreshold = 0.97f - treble * 0.05f;
+  float sparkPhase = std::sin(time * (2.0f + starId * 4.0f) + starId * 100.0f);
+  float isSparking =
+      (starId >= sparkThreshold && sparkPhase >= 0.6f) ? 1.0f : 0.0f;
+  float sparkBoost = isSparking * (0.5f + bass * 0.5f);
+
+  star.size = baseSize + sparkBoost * 1.5f;
+  star.brightness =
+      0.1f + starHash(px * 3.0f, py * 3.0f) * 0.15f + sparkBoost * 0.4f;
+  return star;
+}
+
+void starColor(float brightness, float rgb[3]) {
+  const float coolBlue[3] = {0.4f, 0.6f, 1.0f};
+  const float magenta[3] = {0.8f, 0.3f, 0.9f};
+  const float white[3] = {1.0f, 0.95f, 1.0f};
+  for (int c = 0; c < 3; c++) {
+    float color = mix(coolBlue[c], magenta[c], brightness * 0.5f);
+    color = mix(color, white[c], brightness * 0.3f);
+    rgb[c] = color * brightness;
+  }
+}
+
+Mat4 starPanelView(size_t panel, float angleX, float angleY) {
+  const float d = STAR_PANEL_DISTANCE;
+  const float halfPi = 1.57079632679489661923f;
+  Mat4 view = transform::rotate(Mat4(), angleX, 1.0f, 0.0f, 0.0f);
+  view = transform::rotate(view, angleY, 0.0f, 1.0f, 0.0f);
+  switch (panel) {
+  case 0: // Front
+    return transform::translate(view, 0.0f, 0.0f, -d);
+  case 1: // Back
+    return transform::translate(view, 0.0f, 0.0f, d);
+  case 2: // East
+    view = transform::translate(view, d, 0.0f, 0.0f);
+    return transform::rotate(view, halfPi, 0.0f, 1.0f, 0.0f);
+  default: // West
+    view = transform::translate(view, -d, 0.0f, 0.0f);
+    return transform::rotate(view, -halfPi, 0.0f, 1.0f, 0.0f);
+  }
+}
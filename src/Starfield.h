@@ -0,0 +1,31 @@
+#pragma once
+/*
+ * Starfield - Estrellas de fondo en CPU
+ * Replica stars.vert/stars.frag y los 4 paneles que dibuja main.cpp
+ */
+
+#include "Transform.h"
+
+#include <cstddef>
+
+constexpr int STAR_GRID_COUNT = 70; // 4900 estrellas por panel
+constexpr float STAR_SPACING = 1.8f;
+constexpr float STAR_PANEL_DISTANCE = 62.0f;
+constexpr size_t STAR_PANEL_COUNT = 4; // front, back, east, west
+
+// hash() de stars.vert: fract(sin(dot(p, (127.1, 311.7))) * 43758.5453)
+float starHash(float x, float y);
+
+struct StarSprite {
+  float x = 0.0f, y = 0.0f; // Posicion en el plano del panel (z = 0)
+  float size = 0.0f;        // gl_PointSize
+  float brightness = 0.0f;  // starBrightness
+};
+
+StarSprite evaluateStar(float px, float py, float time, float bass,
+                        float treble);
+
+// stars.frag: disco duro (blend GL_ONE, GL_ONE ignora el alpha)
+void starColor(float brightness, float rgb[3]);
+
+Mat4 starPanelView(size_t panel, float angleX, float angleY);
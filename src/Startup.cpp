@@ -0,0 +1,172 @@
+#include "Startup.h"
+
+#include "AudioFrame.h"
+#include "Grid.h"
+#include "Starfield.h"
+
+#include <algorithm>
+#include <cstdio>
+
+StartupTimeline::StartupTimeline(int64_t originNs) : origin(originNs) {}
+
+void StartupTimeline::record(const std::string &lane, const std::string &name,
+                             int64_t startNs, int64_t endNs) {
+  StartupStageTime stage;
+  stage.lane = lane;
+  stage.name = name;
+  stage.startMs = (startNs - origin) / 1e6;
+  stage.endMs = (endNs - origin) / 1e6;
+  std::lock_guard<std::mutex> lock(mutex);
+  entries.push_back(stage);
+}
+
+void StartupTimeline::mark(const std::string &milestone, int64_t nowNs) {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const auto &m : milestones)
+    if (m.first == milestone)
+      return;
+  milestones.emplace_back(milestone, (nowNs - origin) / 1e6);
+}
+
+double StartupTimeline::milestoneMs(const std::string &milestone) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const auto &m : milestones)
+    if (m.first == milestone)
+      return m.second;
+  return -1.0;
+}
+
+std::vector<StartupStageTime> StartupTimeline::stages() const {
+  std::vector<StartupStageTime> sorted;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    sorted = entries;
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const StartupStageTime &a, const StartupStageTime &b) {
+                     return a.startMs < b.startMs;
+                   });
+  return sorted;
+}
+
+double StartupTimeline::serialMs() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  double total = 0.0;
+  for (const StartupStageTime &stage : entries)
+    total += stage.endMs - stage.startMs;
+  return total;
+}
+
+std::string StartupTimeline::report() const {
+  std::vector<StartupStageTime> sorted = stages();
+  std::vector<std::pair<std::string, double>> marks;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    marks = milestones;
+  }
+
+  std::string out = "Startup:";
+  char line[160];
+  double wallMs = 0.0;
+  for (size_t i = 0; i < marks.size(); i++) {
+    std::snprintf(line, sizeof(line), "%s %s %.1f ms", i ? "," : "",
+                  marks[i].first.c_str(), marks[i].second);
+    out += line;
+    wallMs = std::max(wallMs, marks[i].second);
+  }
+  if (marks.empty())
+    out += " no frame yet";
+  out += "\n";
+
+  for (const StartupStageTime &stage : sorted) {
+    std::snprintf(line, sizeof(line), "  %-8s %-16s %8.1f -> %8.1f ms\n",
+                  stage.lane.c_str(), stage.name.c_str(), stage.startMs,
+                  stage.endMs);
+    out += line;
+    wallMs = std::max(wallMs, stage.endMs);
+  }
+  std::snprintf(line, sizeof(line), "  %.1f ms of work in %.1f ms\n",
+                serialMs(), wallMs);
+  out += line;
+  return out;
+}
+
+StartupScope::StartupScope(StartupTimeline &timeline, const std::string &lane,
+                           const std::string &name)
+    : timeline(timeline), lane(lane), name(name), startNs(monotonicNowNs()) {}
+
+StartupScope::~StartupScope() {
+  timeline.record(lane, name, startNs, monotonicNowNs());
+}
+
+StartupLoader::~StartupLoader() {
+  // Los hilos usan el timeline: que terminen antes de que desaparezca
+  if (shaderFuture.valid())
+    shaderFuture.wait();
+  if (gridFuture.valid())
+    gridFuture.wait();
+}
+
+void StartupLoader::start(const ShaderSourceLoader &load,
+                          const std::string &shaderDir,
+                          StartupTimeline &timeline) {
+  this->timeline = &timeline;
+  StartupTimeline *t = &timeline;
+
+  shaderFuture = std::async(std::launch::async, [load, shaderDir, t] {
+    StartupScope scope(*t, "shaders", "read_shaders");
+    auto program = [&](const std::string &vert, const std::string &frag) {
+      ShaderProgramSource source;
+      source.vertex = load(shaderDir + vert);
+      source.fragment = load(shaderDir + frag);
+      return source;
+    };
+    StartupShaderSources sources;
+    sources.particle = program("shader.vert", "shader.frag");
+    sources.bloom = program("bloom.vert", "bloom.frag");
+    sources.stars = program("stars.vert", "stars.frag");
+    sources.nebula = program("nebula.vert", "nebula.frag");
+    return sources;
+  });
+
+  gridFuture = std::async(std::launch::async, [t] {
+    StartupScope scope(*t, "grids", "build_grids");
+    StartupGrids grids;
+    for (size_t i = 0; i < WAVE_LAYER_COUNT; i++)
+      grids.waves[i] =
+          generateGrid(WAVE_LAYERS[i].gridCount, WAVE_LAYERS[i].spacing);
+    grids.stars = generateGrid(STAR_GRID_COUNT, STAR_SPACING);
+    return grids;
+  });
+}
+
+const StartupShaderSources &StartupLoader::shaders() {
+  if (!shadersTaken) {
+    StartupScope scope(*timeline, "main", "wait_shaders");
+    shaderSources = shaderFuture.get();
+    shadersTaken = true;
+  }
+  return shaderSources;
+}
+
+const StartupGrids &StartupLoader::grids() {
+  if (!gridsTaken) {
+    StartupScope scope(*timeline, "main", "wait_grids");
+    gridData = gridFuture.get();
+    gridsTaken = true;
+  }
+  return gridData;
+}
+
+void StartupSequence::add(const std::string &name, std::function<void()> step) {
+  steps.emplace_back(name, std::move(step));
+}
+
+bool StartupSequence::runNext(StartupTimeline &timeline) {
+  if (done())
+    return false;
+  const auto &step = steps[next++];
+  StartupScope scope(timeline, "main", step.first);
+  step.second();
+  return true;
+}
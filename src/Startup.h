@@ -0,0 +1,128 @@
+#pragma once
+/*
+ * Startup - Arranque concurrente y tiempo hasta el primer frame
+ * StartupLoader lee los shaders y genera las rejillas en dos hilos
+ * mientras el hilo principal crea la ventana y el contexto GL.
+ * StartupSequence deja para los primeros frames lo que el primero no
+ * necesita (un paso por frame) y StartupTimeline anota cada etapa por
+ * hilo para el informe. Sin GL: el loader recibe la funcion de lectura.
+ */
+
+#include "WaveLayers.h"
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct StartupStageTime {
+  std::string lane; // Hilo: main, shaders, grids...
+  std::string name;
+  double startMs = 0.0; // Desde el origen del timeline
+  double endMs = 0.0;
+};
+
+// Etapas de todos los hilos y los hitos (primer frame...) del arranque
+class StartupTimeline {
+public:
+  explicit StartupTimeline(int64_t originNs);
+
+  void record(const std::string &lane, const std::string &name,
+              int64_t startNs, int64_t endNs);
+  // Solo cuenta la primera vez
+  void mark(const std::string &milestone, int64_t nowNs);
+  // -1 si aun no ha pasado
+  double milestoneMs(const std::string &milestone) const;
+
+  // Por orden de inicio
+  std::vector<StartupStageTime> stages() const;
+  // Suma de todas las etapas (lo que costaria en serie)
+  double serialMs() const;
+  int64_t originNs() const { return origin; }
+
+  // "Startup: first present ... ms, first frame ... ms, complete ... ms"
+  // y una linea por etapa
+  std::string report() const;
+
+private:
+  int64_t origin;
+  mutable std::mutex mutex;
+  std::vector<StartupStageTime> entries;
+  std::vector<std::pair<std::string, double>> milestones;
+};
+
+// Anota una etapa desde su construccion hasta su destruccion
+class StartupScope {
+public:
+  StartupScope(StartupTimeline &timeline, const std::string &lane,
+               const std::string &name);
+  ~StartupScope();
+
+  StartupScope(const StartupScope &) = delete;
+  StartupScope &operator=(const StartupScope &) = delete;
+
+private:
+  StartupTimeline &timeline;
+  std::string lane;
+  std::string name;
+  int64_t startNs;
+};
+
+struct ShaderProgramSource {
+  std::string vertex;
+  std::string fragment;
+};
+
+struct StartupShaderSources {
+  ShaderProgramSource particle; // shader.vert / shader.frag
+  ShaderProgramSource bloom;
+  ShaderProgramSource stars;
+  ShaderProgramSource nebula;
+};
+
+struct StartupGrids {
+  std::vector<float> waves[WAVE_LAYER_COUNT];
+  std::vector<float> stars;
+};
+
+// path -> fuente (loadShaderSource en la app, ficheros falsos en tests)
+using ShaderSourceLoader = std::function<std::string(const std::string &)>;
+
+class StartupLoader {
+public:
+  ~StartupLoader();
+
+  // Lanza los dos hilos; shaderDir termina en '/'
+  void start(const ShaderSourceLoader &load, const std::string &shaderDir,
+             StartupTimeline &timeline);
+
+  // Bloquean hasta tener el resultado; la espera se anota en 'main'
+  const StartupShaderSources &shaders();
+  const StartupGrids &grids();
+
+private:
+  StartupTimeline *timeline = nullptr;
+  std::future<StartupShaderSources> shaderFuture;
+  std::future<StartupGrids> gridFuture;
+  StartupShaderSources shaderSources;
+  StartupGrids gridData;
+  bool shadersTaken = false;
+  bool gridsTaken = false;
+};
+
+// Trabajo del hilo GL aplazado a los primeros frames, en orden
+class StartupSequence {
+public:
+  void add(const std::string &name, std::function<void()> step);
+
+  // Ejecuta el siguiente paso (anotado en 'main'); false si no quedaba
+  bool runNext(StartupTimeline &timeline);
+  bool done() const { return next == steps.size(); }
+  size_t remaining() const { return steps.size() - next; }
+
+private:
+  std::vector<std::pair<std::string, std::function<void()>>> steps;
+  size_t next = 0;
+};
@@ -0,0 +1,41 @@
+#include "Stats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+
+double percentileSorted(const std::vector<double> &samples, double p) {
+  if (samples.empty())
+    return 0.0;
+  double rank = p / 100.0 * (double)(samples.size() - 1);
+  size_t lo = (size_t)rank;
+  size_t hi = std::min(lo + 1, samples.size() - 1);
+  double frac = rank - (double)lo;
+  return samples[lo] + (samples[hi] - samples[lo]) * frac;
+}
+
+Distribution summarize(std::vector<double> samples) {
+  Distribution d;
+  d.count = samples.size();
+  if (samples.empty())
+    return d;
+
+  std::sort(samples.begin(), samples.end());
+  d.mean = std::accumulate(samples.begin(), samples.end(), 0.0) /
+           (double)samples.size();
+  d.min = samples.front();
+  d.max = samples.back();
+  d.p50 = percentileSorted(samples, 50.0);
+  d.p95 = percentileSorted(samples, 95.0);
+  d.p99 = percentileSorted(samples, 99.0);
+  return d;
+}
+
+std::string formatDistribution(const Distribution &d, int precision) {
+  char buffer[160];
+  std::snprintf(buffer, sizeof(buffer),
+                "mean %.*f p50 %.*f p95 %.*f p99 %.*f max %.*f", precision,
+                d.mean, precision, d.p50, precision, d.p95, precision, d.p99,
+                precision, d.max);
+  return buffer;
+}
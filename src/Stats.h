@@ -0,0 +1,26 @@
+#pragma once
+/*
+ * Stats - Resumen de distribuciones (tiempos de frame, latencias, ...)
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct Distribution {
+  size_t count = 0;
+  double mean = 0.0;
+  double min = 0.0;
+  double p50 = 0.0;
+  double p95 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+};
+
+// Percentil con interpolacion lineal; samples debe estar ordenado
+double percentileSorted(const std::vector<double> &samples, double p);
+
+Distribution summarize(std::vector<double> samples);
+
+// "mean 1.23 p50 1.20 p95 1.80 p99 2.10 max 3.00"
+std::string formatDistribution(const Distribution &d, int precision = 3);
@@ -0,0 +1,75 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threads) {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned i = 1; i < threads; i++)
+    workers.emplace_back([this] { workerLoop(); });
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (std::thread &worker : workers)
+    worker.join();
+}
+
+void ThreadPool::runChunks() {
+  for (;;) {
+    size_t begin = nextIndex.fetch_add(jobGrain, std::memory_order_relaxed);
+    if (begin >= jobCount)
+      return;
+    (*job)(begin, std::min(begin + jobGrain, jobCount));
+  }
+}
+
+void ThreadPool::workerLoop() {
+  uint64_t seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [&] { return stopping || generation != seen; });
+      if (stopping)
+        return;
+      seen = generation;
+    }
+    runChunks();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--active == 0)
+        done.notify_one();
+    }
+  }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain,
+                             const std::function<void(size_t, size_t)> &fn) {
+  if (count == 0)
+    return;
+  grain = std::max<size_t>(grain, 1);
+  if (workers.empty() || count <= grain) {
+    fn(0, count);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = &fn;
+    jobCount = count;
+    jobGrain = grain;
+    nextIndex.store(0, std::memory_order_relaxed);
+    active = (unsigned)workers.size();
+    generation++;
+  }
+  wake.notify_all();
+  runChunks();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [&] { return active == 0; });
+  job = nullptr;
+}
@@ -0,0 +1,50 @@
+#pragma once
+/*
+ * ThreadPool - Workers persistentes para el renderer CPU
+ * parallelFor reparte [0, count) en bloques de 'grain'; el hilo que llama
+ * tambien trabaja. Cada indice lo procesa un solo hilo, asi el resultado
+ * no depende del numero de hilos
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+  // threads = 0: std::thread::hardware_concurrency()
+  explicit ThreadPool(unsigned threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Hilos que trabajan en parallelFor (incluido el que llama)
+  unsigned size() const { return (unsigned)workers.size() + 1; }
+
+  // fn(begin, end) por bloque; bloquea hasta terminar todos
+  void parallelFor(size_t count, size_t grain,
+                   const std::function<void(size_t, size_t)> &fn);
+
+private:
+  void workerLoop();
+  void runChunks();
+
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  uint64_t generation = 0;
+  unsigned active = 0;
+  bool stopping = false;
+
+  const std::function<void(size_t, size_t)> *job = nullptr;
+  size_t jobCount = 0;
+  size_t jobGrain = 1;
+  std::atomic<size_t> nextIndex{0};
+};
@@ -0,0 +1,105 @@
+#include "Transform.h"
+
+#include <cmath>
+
+Mat4 operator*(const Mat4 &a, const Mat4 &b) {
+  Mat4 r;
+  for (int col = 0; col < 4; col++)
+    for (int row = 0; row < 4; row++)
+      r.at(row, col) = a.at(row, 0) * b.at(0, col) +
+                       a.at(row, 1) * b.at(1, col) +
+                       a.at(row, 2) * b.at(2, col) +
+                       a.at(row, 3) * b.at(3, col);
+  return r;
+}
+
+Vec4 operator*(const Mat4 &a, const Vec4 &v) {
+  Vec4 r;
+  r.x = a.m[0] * v.x + a.m[4] * v.y + a.m[8] * v.z + a.m[12] * v.w;
+  r.y = a.m[1] * v.x + a.m[5] * v.y + a.m[9] * v.z + a.m[13] * v.w;
+  r.z = a.m[2] * v.x + a.m[6] * v.y + a.m[10] * v.z + a.m[14] * v.w;
+  r.w = a.m[3] * v.x + a.m[7] * v.y + a.m[11] * v.z + a.m[15] * v.w;
+  return r;
+}
+
+namespace transform {
+
+Mat4 perspective(float fovy, float aspect, float zNear, float zFar) {
+  const float tanHalf = std::tan(fovy / 2.0f);
+  Mat4 r;
+  for (float &v : r.m)
+    v = 0.0f;
+  r.at(0, 0) = 1.0f / (aspect * tanHalf);
+  r.at(1, 1) = 1.0f / tanHalf;
+  r.at(2, 2) = -(zFar + zNear) / (zFar - zNear);
+  r.at(3, 2) = -1.0f;
+  r.at(2, 3) = -(2.0f * zFar * zNear) / (zFar - zNear);
+  return r;
+}
+
+Mat4 frustum(float left, float right, float bottom, float top, float zNear,
+             float zFar) {
+  Mat4 r;
+  for (float &v : r.m)
+    v = 0.0f;
+  r.at(0, 0) = 2.0f * zNear / (right - left);
+  r.at(1, 1) = 2.0f * zNear / (top - bottom);
+  r.at(0, 2) = (right + left) / (right - left);
+  r.at(1, 2) = (top + bottom) / (top - bottom);
+  r.at(2, 2) = -(zFar + zNear) / (zFar - zNear);
+  r.at(3, 2) = -1.0f;
+  r.at(2, 3) = -(2.0f * zFar * zNear) / (zFar - zNear);
+  return r;
+}
+
+Mat4 offCenterPerspective(float fovy, int fullWidth, int fullHeight, int x,
+                          int y, int width, int height, float zNear,
+                          float zFar) {
+  const float top = zNear * std::tan(fovy / 2.0f);
+  const float right = top * (float)fullWidth / (float)fullHeight;
+  auto edgeX = [&](int px) { return right * (2.0f * px / fullWidth - 1.0f); };
+  auto edgeY = [&](int py) { return top * (2.0f * py / fullHeight - 1.0f); };
+  return frustum(edgeX(x), edgeX(x + width), edgeY(y), edgeY(y + height),
+                 zNear, zFar);
+}
+
+Mat4 translate(const Mat4 &m, float x, float y, float z) {
+  Mat4 t;
+  t.at(0, 3) = x;
+  t.at(1, 3) = y;
+  t.at(2, 3) = z;
+  return m * t;
+}
+
+Mat4 rotate(const Mat4 &m, float angle, float ax, float ay, float az) {
+  const float c = std::cos(angle);
+  const float s = std::sin(angle);
+  const float len = std::sqrt(ax * ax + ay * ay + az * az);
+  ax /= len;
+  ay /= len;
+  az /= len;
+  const float tx = (1.0f - c) * ax, ty = (1.0f - c) * ay,
+              tz = (1.0f - c) * az;
+
+  Mat4 r;
+  r.at(0, 0) = c + tx * ax;
+  r.at(1, 0) = tx * ay + s * az;
+  r.at(2, 0) = tx * az - s * ay;
+  r.at(0, 1) = ty * ax - s * az;
+  r.at(1, 1) = c + ty * ay;
+  r.at(2, 1) = ty * az + s * ax;
+  r.at(0, 2) = tz * ax + s * ay;
+  r.at(1, 2) = tz * ay - s * ax;
+  r.at(2, 2) = c + tz * az;
+  return m * r;
+}
+
+Mat4 scale(const Mat4 &m, float s) {
+  Mat4 r;
+  r.at(0, 0) = s;
+  r.at(1, 1) = s;
+  r.at(2, 2) = s;
+  return m * r;
+}
+
+} // namespace transform
@@ -0,0 +1,44 @@
+#pragma once
+/*
+ * Transform - Matrices 4x4 del nucleo portable (sin glm)
+ * Column-major y mismas formulas que glm::perspective/translate/rotate/
+ * scale, para que el renderer CPU y el de GL vean la misma camara
+ */
+
+struct Vec4 {
+  float x = 0.0f, y = 0.0f, z = 0.0f, w = 0.0f;
+};
+
+struct Mat4 {
+  float m[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+  // m[col * 4 + row], igual que glm::value_ptr
+  float &at(int row, int col) { return m[col * 4 + row]; }
+  float at(int row, int col) const { return m[col * 4 + row]; }
+};
+
+Mat4 operator*(const Mat4 &a, const Mat4 &b);
+Vec4 operator*(const Mat4 &a, const Vec4 &v);
+
+namespace transform {
+
+// fovy en radianes, proyeccion OpenGL (z en [-w, w])
+Mat4 perspective(float fovy, float aspect, float zNear, float zFar);
+
+// glm::frustum: volumen descentrado, bordes en el near plane
+Mat4 frustum(float left, float right, float bottom, float top, float zNear,
+             float zFar);
+
+// La parte (x, y, width, height) de la imagen fullWidth x fullHeight que
+// veria perspective(fovy, fullWidth / fullHeight); en pixeles, y hacia
+// arriba como glViewport
+Mat4 offCenterPerspective(float fovy, int fullWidth, int fullHeight, int x,
+                          int y, int width, int height, float zNear,
+                          float zFar);
+
+// m * T, m * R, m * S (post-multiplican, como glm)
+Mat4 translate(const Mat4 &m, float x, float y, float z);
+Mat4 rotate(const Mat4 &m, float angle, float ax, float ay, float az);
+Mat4 scale(const Mat4 &m, float s);
+
+} // namespace transform
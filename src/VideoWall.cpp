@@ -0,0 +1,90 @@
+#include "VideoWall.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+bool parseWallGrid(const char *text, int &columns, int &rows) {
+  int c = 0, r = 0;
+  char tail = 0;
+  if (std::sscanf(text, "%dx%d%c", &c, &r, &tail) != 2 || c < 1 || r < 1)
+    return false;
+  columns = c;
+  rows = r;
+  return true;
+}
+
+WallRect wallTileRect(const WallLayout &layout, int tile) {
+  const int column = tile % layout.columns, row = tile / layout.columns;
+  // Reparto entero: columnas/filas de 1 px de diferencia si no divide
+  auto edge = [](int total, int parts, int i) {
+    return (int)((int64_t)total * i / parts);
+  };
+  WallRect rect;
+  rect.x = edge(layout.width, layout.columns, column);
+  rect.y = edge(layout.height, layout.rows, row);
+  rect.width = edge(layout.width, layout.columns, column + 1) - rect.x;
+  rect.height = edge(layout.height, layout.rows, row + 1) - rect.y;
+  return rect;
+}
+
+WallRect wallRenderRect(const WallLayout &layout, int tile) {
+  WallRect core = wallTileRect(layout, tile);
+  WallRect rect;
+  rect.x = std::max(core.x - layout.guard, 0);
+  rect.y = std::max(core.y - layout.guard, 0);
+  rect.width =
+      std::min(core.x + core.width + layout.guard, layout.width) - rect.x;
+  rect.height =
+      std::min(core.y + core.height + layout.guard, layout.height) - rect.y;
+  return rect;
+}
+
+Mat4 wallProjection(const WallLayout &layout, const WallRect &render,
+                    float fovy, float zNear, float zFar) {
+  // La proyeccion cuenta y desde abajo
+  const int bottom = layout.height - (render.y + render.height);
+  return transform::offCenterPerspective(fovy, layout.width, layout.height,
+                                         render.x, bottom, render.width,
+                                         render.height, zNear, zFar);
+}
+
+std::vector<uint8_t> cropRGB(const std::vector<uint8_t> &rgb, int width,
+                             const WallRect &rect) {
+  std::vector<uint8_t> out((size_t)rect.width * rect.height * 3);
+  for (int y = 0; y < rect.height; y++)
+    std::memcpy(out.data() + (size_t)y * rect.width * 3,
+                rgb.data() + ((size_t)(rect.y + y) * width + rect.x) * 3,
+                (size_t)rect.width * 3);
+  return out;
+}
+
+void pasteRGB(std::vector<uint8_t> &rgb, int width, const WallRect &rect,
+              const std::vector<uint8_t> &tile) {
+  for (int y = 0; y < rect.height; y++)
+    std::memcpy(rgb.data() + ((size_t)(rect.y + y) * width + rect.x) * 3,
+                tile.data() + (size_t)y * rect.width * 3,
+                (size_t)rect.width * 3);
+}
+
+WallClock::WallClock(double fps)
+    : stepSeconds((float)(1.0 / fps)), stepNs((int64_t)(1e9 / fps)) {}
+
+WallFrame WallClock::next(const AudioFrame &audio, float cameraDistance,
+                          float cameraAngleX, float cameraAngleY) {
+  // Speed modulation de main.cpp con delta fijo
+  float audioIntensity = std::min(audio.mids + audio.treble * 0.5f, 0.7f);
+  accumulated += stepSeconds * (1.0f + audioIntensity * 2.0f);
+  index++;
+
+  WallFrame frame;
+  frame.index = index;
+  frame.time = accumulated;
+  frame.cameraDistance = cameraDistance;
+  frame.cameraAngleX = cameraAngleX;
+  frame.cameraAngleY = cameraAngleY;
+  frame.audio = audio;
+  frame.audio.sequence = index;
+  frame.audio.timestampNs = (int64_t)index * stepNs;
+  return frame;
+}
@@ -0,0 +1,95 @@
+#pragma once
+/*
+ * VideoWall - Pared de pantallas renderizada por varios procesos
+ * Cada tile dibuja su rectangulo de una camara virtual comun con una
+ * proyeccion descentrada, mas una banda de guarda para que el bloom y
+ * los sprites que cruzan el borde salgan igual que en el render completo.
+ * WallClock sustituye el tiempo integrado con glfwGetTime(): el lider lo
+ * avanza un paso fijo por frame y publica el resultado (WallSync).
+ */
+
+#include "AudioFrame.h"
+#include "PostProcess.h"
+#include "Transform.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Alcance del bloom por eje: BLOOM_ITERATIONS pasadas de BLOOM_TAPS - 1 px
+constexpr int BLOOM_REACH = BLOOM_ITERATIONS * (BLOOM_TAPS - 1);
+// GL y SoftRenderer descartan un punto por su centro: un sprite cuyo
+// centro cae fuera aun pinta hasta su radio dentro (capa main con agudos
+// a tope: (7 + 2) * 1.8 = 16.2 px de diametro, mas medio pixel)
+constexpr int MAX_POINT_RADIUS = 9;
+constexpr int WALL_GUARD_BAND = BLOOM_REACH + MAX_POINT_RADIUS + 1;
+
+// Pixeles con y desde arriba, como el PPM y el orden de los tiles
+struct WallRect {
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+};
+
+struct WallLayout {
+  int width = 1280; // Resolucion de la pared entera
+  int height = 720;
+  int columns = 1;
+  int rows = 1;
+  int guard = WALL_GUARD_BAND;
+
+  int tiles() const { return columns * rows; }
+};
+
+// "3x2" -> 3 columnas, 2 filas
+bool parseWallGrid(const char *text, int &columns, int &rows);
+
+// Lo que muestra el tile (fila a fila desde arriba a la izquierda)
+WallRect wallTileRect(const WallLayout &layout, int tile);
+// El tile mas la banda de guarda, recortado a la pared: en los bordes
+// de la pared el clamp del blur es el mismo que en el render completo
+WallRect wallRenderRect(const WallLayout &layout, int tile);
+
+// Proyeccion del rectangulo 'render' de la camara de la pared
+Mat4 wallProjection(const WallLayout &layout, const WallRect &render,
+                    float fovy, float zNear, float zFar);
+
+// Copia 'rect' (relativo a la imagen) de una imagen RGB de 'width' px
+std::vector<uint8_t> cropRGB(const std::vector<uint8_t> &rgb, int width,
+                             const WallRect &rect);
+// Pega 'tile' (rect.width x rect.height) en una imagen de 'width' px
+void pasteRGB(std::vector<uint8_t> &rgb, int width, const WallRect &rect,
+              const std::vector<uint8_t> &tile);
+
+// Lo que todos los tiles necesitan para dibujar el frame 'index'. POD:
+// va tal cual a memoria compartida
+struct WallFrame {
+  uint64_t index = 0; // 1, 2, 3...
+  float time = 0.0f;  // accumulatedTime
+  float cameraDistance = 2.5f;
+  float cameraAngleX = 0.5f;
+  float cameraAngleY = 0.0f;
+  // Envolventes del lider; sequence = index y timestampNs del reloj de
+  // simulacion para que el espectrograma avance igual en todos
+  AudioFrame audio;
+};
+
+// Tiempo de simulacion determinista: paso fijo por frame con la misma
+// modulacion por audio que main.cpp
+class WallClock {
+public:
+  explicit WallClock(double fps = 60.0);
+
+  WallFrame next(const AudioFrame &audio, float cameraDistance,
+                 float cameraAngleX, float cameraAngleY);
+
+  uint64_t frames() const { return index; }
+  float time() const { return accumulated; }
+
+private:
+  float stepSeconds;
+  int64_t stepNs;
+  uint64_t index = 0;
+  float accumulated = 0.0f;
+};
@@ -0,0 +1,190 @@
+#include "WallSync.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "WallSync needs lock-free 64-bit atomics across processes");
+
+WallSync::~WallSync() { close(); }
+
+bool WallSync::create(const std::string &shmName, int tileCount) {
+  close();
+  if (tileCount < 1 || tileCount > MAX_WALL_TILES) {
+    std::cerr << "WallSync: " << tileCount << " tiles (max "
+              << MAX_WALL_TILES << ")" << std::endl;
+    return false;
+  }
+  size_t size = sizeof(wall_sync::Header);
+
+  // Un segmento viejo de un lider caido puede tener otro formato
+  shm_unlink(shmName.c_str());
+  int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    std::cerr << "shm_open(" << shmName << "): " << std::strerror(errno)
+              << std::endl;
+    return false;
+  }
+  if (ftruncate(fd, (off_t)size) != 0) {
+    std::cerr << "ftruncate: " << std::strerror(errno) << std::endl;
+    ::close(fd);
+    shm_unlink(shmName.c_str());
+    return false;
+  }
+  void *mapped =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED) {
+    std::cerr << "mmap: " << std::strerror(errno) << std::endl;
+    shm_unlink(shmName.c_str());
+    return false;
+  }
+
+  // ftruncate deja todo a cero: los tiles ven magic 0 hasta el final
+  header = new (mapped) wall_sync::Header;
+  header->version = wall_sync::VERSION;
+  header->tiles = (uint32_t)tileCount;
+  header->published.store(0, std::memory_order_relaxed);
+  header->finished.store(0, std::memory_order_relaxed);
+  for (std::atomic<uint64_t> &ready : header->ready)
+    ready.store(0, std::memory_order_relaxed);
+  header->magic.store(wall_sync::MAGIC, std::memory_order_release);
+
+  name = shmName;
+  memory = mapped;
+  bytes = size;
+  tileIndex = 0;
+  owner = true;
+  return true;
+}
+
+bool WallSync::attach(const std::string &shmName, int tile,
+                      double timeoutMs) {
+  close();
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::duration<double, std::milli>(timeoutMs);
+  const size_t size = sizeof(wall_sync::Header);
+  while (true) {
+    int fd = shm_open(shmName.c_str(), O_RDWR, 0);
+    if (fd >= 0) {
+      struct stat info;
+      void *mapped = MAP_FAILED;
+      if (fstat(fd, &info) == 0 && (size_t)info.st_size == size)
+        mapped =
+            mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      ::close(fd);
+      if (mapped != MAP_FAILED) {
+        auto *h = static_cast<wall_sync::Header *>(mapped);
+        if (h->magic.load(std::memory_order_acquire) == wall_sync::MAGIC &&
+            h->version == wall_sync::VERSION) {
+          if (tile < 1 || tile >= (int)h->tiles) {
+            std::cerr << "WallSync: tile " << tile << " fuera de la pared de "
+                      << h->tiles << std::endl;
+            munmap(mapped, size);
+            return false;
+          }
+          memory = mapped;
+          bytes = size;
+          header = h;
+          tileIndex = tile;
+          return true;
+        }
+        munmap(mapped, size);
+      }
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      std::cerr << "WallSync: no hay lider en " << shmName << std::endl;
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+}
+
+void WallSync::close() {
+  if (!memory)
+    return;
+  munmap(memory, bytes);
+  if (owner)
+    shm_unlink(name.c_str());
+  memory = nullptr;
+  header = nullptr;
+  bytes = 0;
+  owner = false;
+}
+
+template <typename Done>
+bool WallSync::waitUntil(Done done, double timeoutMs) const {
+  // Unos giros para el caso normal (todos a la vez) y luego a dormir a
+  // intervalos cortos: la espera tipica es menor que un frame
+  for (int i = 0; i < 64; i++) {
+    if (done())
+      return true;
+    std::this_thread::yield();
+  }
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::duration<double, std::milli>(timeoutMs);
+  while (!done()) {
+    if (std::chrono::steady_clock::now() >= deadline)
+      return false;
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  return true;
+}
+
+bool WallSync::allReady(uint64_t index) const {
+  for (uint32_t t = 0; t < header->tiles; t++)
+    if (header->ready[t].load(std::memory_order_acquire) < index)
+      return false;
+  return true;
+}
+
+bool WallSync::publish(const WallFrame &frame, double timeoutMs) {
+  if (!owner)
+    return false;
+  if (!waitUntil([&] { return allReady(frame.index - 1); }, timeoutMs)) {
+    std::cerr << "WallSync: algun tile no termino el frame "
+              << frame.index - 1 << std::endl;
+    return false;
+  }
+  // Con todos en index - 1 nadie lee ya el slot de index - 2
+  header->frames[frame.index % wall_sync::SLOTS] = frame;
+  header->published.store(frame.index, std::memory_order_release);
+  return true;
+}
+
+bool WallSync::waitFrame(uint64_t index, WallFrame &out, double timeoutMs) {
+  bool arrived = waitUntil(
+      [&] {
+        return header->published.load(std::memory_order_acquire) >= index ||
+               header->finished.load(std::memory_order_acquire) != 0;
+      },
+      timeoutMs);
+  if (!arrived || header->published.load(std::memory_order_acquire) < index)
+    return false;
+  out = header->frames[index % wall_sync::SLOTS];
+  return out.index == index;
+}
+
+bool WallSync::readyAndWait(uint64_t index, double timeoutMs) {
+  header->ready[tileIndex].store(index, std::memory_order_release);
+  if (!waitUntil([&] { return allReady(index); }, timeoutMs)) {
+    std::cerr << "WallSync: algun tile no termino el frame " << index
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void WallSync::finish() {
+  if (owner)
+    header->finished.store(1, std::memory_order_release);
+}
@@ -0,0 +1,80 @@
+#pragma once
+/*
+ * WallSync - Frame lock de los tiles de una pared (POSIX shm)
+ * El tile 0 lidera: crea el segmento, avanza el WallClock y publica cada
+ * WallFrame. Cada tile espera el frame N, lo dibuja, marca N como listo
+ * y no presenta hasta que todos lo han marcado. El lider no publica N + 1
+ * hasta entonces, asi dos slots bastan y nadie lee un frame a medias.
+ */
+
+#include "VideoWall.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+constexpr const char *DEFAULT_WALL_SHM = "/neon-wall";
+constexpr int MAX_WALL_TILES = 64;
+// Un tile que no llega en este tiempo se da por caido
+constexpr double WALL_TIMEOUT_MS = 10000.0;
+
+namespace wall_sync {
+
+constexpr uint32_t MAGIC = 0x4E47574C; // "NGWL"
+constexpr uint32_t VERSION = 1;
+constexpr int SLOTS = 2;
+
+struct Header {
+  std::atomic<uint32_t> magic; // Lo ultimo que escribe el lider
+  uint32_t version;
+  uint32_t tiles;
+  alignas(64) std::atomic<uint64_t> published; // Ultimo WallFrame::index
+  std::atomic<uint32_t> finished;              // El lider no publica mas
+  alignas(64) std::atomic<uint64_t> ready[MAX_WALL_TILES];
+  WallFrame frames[SLOTS]; // frames[index % SLOTS]
+};
+
+} // namespace wall_sync
+
+class WallSync {
+public:
+  WallSync() = default;
+  ~WallSync();
+  WallSync(const WallSync &) = delete;
+  WallSync &operator=(const WallSync &) = delete;
+
+  // Lider (tile 0): crea (o recrea) el segmento; name empieza por '/'
+  bool create(const std::string &name, int tiles);
+  // Resto de tiles: reintenta hasta que el lider lo haya creado
+  bool attach(const std::string &name, int tile, double timeoutMs);
+  // El lider borra el nombre; los tiles mapeados siguen leyendo
+  void close();
+
+  int tiles() const { return header ? (int)header->tiles : 0; }
+  int tile() const { return tileIndex; }
+
+  // Lider: espera a que todos hayan dibujado index - 1 y publica
+  bool publish(const WallFrame &frame, double timeoutMs);
+  // Espera el frame 'index'; false si el lider termino o no llega
+  bool waitFrame(uint64_t index, WallFrame &out, double timeoutMs);
+  // Marca 'index' como dibujado y espera a los demas (swap lock)
+  bool readyAndWait(uint64_t index, double timeoutMs);
+  // Lider: avisa a los tiles de que no hay mas frames
+  void finish();
+  bool finished() const {
+    return header && header->finished.load(std::memory_order_acquire) != 0;
+  }
+
+private:
+  // Hasta que done() o timeout; false si vence
+  template <typename Done> bool waitUntil(Done done, double timeoutMs) const;
+  bool allReady(uint64_t index) const;
+
+  std::string name;
+  void *memory = nullptr;
+  size_t bytes = 0;
+  wall_sync::Header *header = nullptr;
+  int tileIndex = 0;
+  bool owner = false;
+};
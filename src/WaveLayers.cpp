@@ -0,0 +1,30 @@
+#include "WaveLayers.h"
+
+const WaveLayerDesc WAVE_LAYERS[WAVE_LAYER_COUNT] = {
+    {"far", 100, 0.25f, 0.6f, 10.0f},
+    {"main", 200, 0.03f, 1.8f, 1.0f},
+    {"near", 300, 0.015f, 0.5f, 1.0f},
+};
+
+Mat4 waveLayerView(size_t layer, float cameraDistance, float angleX,
+                   float angleY) {
+  float x = 0.0f, y, z;
+  switch (layer) {
+  case 0: // Far Layer
+    y = -1.0f;
+    z = -cameraDistance - 0.5f;
+    break;
+  case 1: // Main Layer
+    y = 0.0f;
+    z = -cameraDistance;
+    break;
+  default: // Near Layer
+    y = 0.3f;
+    z = -1.2f;
+    break;
+  }
+  Mat4 view = transform::translate(Mat4(), x, y, z);
+  view = transform::rotate(view, angleX, 1.0f, 0.0f, 0.0f);
+  view = transform::rotate(view, angleY, 0.0f, 1.0f, 0.0f);
+  return view;
+}
@@ -0,0 +1,24 @@
+#pragma once
+/*
+ * WaveLayers - Las tres capas de particulas Gerstner (far, main, near)
+ */
+
+#include "Transform.h"
+
+#include <cstddef>
+
+struct WaveLayerDesc {
+  const char *name;
+  int gridCount; // Particulas por lado
+  float spacing;
+  float intensity;
+  float peakExp;
+  float gridSize() const { return gridCount * spacing; }
+};
+
+// Orden de dibujado: far, main, near
+constexpr size_t WAVE_LAYER_COUNT = 3;
+extern const WaveLayerDesc WAVE_LAYERS[WAVE_LAYER_COUNT];
+
+Mat4 waveLayerView(size_t layer, float cameraDistance, float angleX,
+                   float angleY);
@@ -0,0 +1,145 @@
+#include "WaveMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Parametros de las ondas (ver shader.vert)
+static constexpr float AMPLITUDE = 0.15f;
+static constexpr float FREQUENCY = 3.0f;
+static constexpr float SPEED = 1.5f;
+static constexpr float STEEPNESS = 0.5f;
+static constexpr float DRIFT_SPEED = 0.4f;
+
+// mod() de GLSL: x - y * floor(x / y)
+static float glslMod(float x, float y) { return x - y * std::floor(x / y); }
+
+namespace {
+struct WaveConstants {
+  float dir1x, dir1y, dir2x, dir2y;
+  WaveConstants() {
+    float l1 = std::sqrt(1.0f * 1.0f + 0.5f * 0.5f);
+    float l2 = std::sqrt(0.7f * 0.7f + 1.0f * 1.0f);
+    dir1x = 1.0f / l1;
+    dir1y = 0.5f / l1;
+    dir2x = -0.7f / l2;
+    dir2y = 1.0f / l2;
+  }
+};
+const WaveConstants waveDirs;
+
+// Parte de la onda que solo depende de los uniforms
+struct FrameTerms {
+  float amp;
+  float phaseT1;
+  float phaseT2;
+  float halfGrid;
+};
+
+FrameTerms frameTerms(const WaveParams &params) {
+  float bassPunch = params.bass * 0.4f;
+  float audioEnergy = (bassPunch * 0.8f) + (params.mids * 0.2f);
+  float audioAmp = audioEnergy * 0.5f;
+  FrameTerms f;
+  f.amp = AMPLITUDE + audioAmp;
+  f.phaseT1 = params.time * SPEED;
+  f.phaseT2 = params.time * SPEED * 0.8f;
+  f.halfGrid = params.gridSize * 0.5f;
+  return f;
+}
+
+WavePoint evaluate(float px, float pz, const WaveParams &params,
+                   const FrameTerms &f) {
+  const float gridSize = params.gridSize;
+  float dx = glslMod(px + f.halfGrid, gridSize) - f.halfGrid;
+  float dz =
+      glslMod(pz + params.time * DRIFT_SPEED + f.halfGrid, gridSize) -
+      f.halfGrid;
+
+  // Wave 1
+  float phase1 = (waveDirs.dir1x * dx + waveDirs.dir1y * dz) * FREQUENCY -
+                 f.phaseT1;
+  float c1 = std::cos(phase1);
+  float wave1 = std::sin(phase1) * f.amp;
+
+  // Wave 2 (crossed)
+  float phase2 = (waveDirs.dir2x * dx + waveDirs.dir2y * dz) * FREQUENCY *
+                     1.3f -
+                 f.phaseT2;
+  float c2 = std::cos(phase2);
+  float wave2 = std::sin(phase2) * f.amp * 0.6f;
+
+  float s1 = STEEPNESS * f.amp * c1;
+  float s2 = STEEPNESS * f.amp * 0.6f * c2;
+
+  WavePoint p;
+  p.x = dx + s1 * waveDirs.dir1x + s2 * waveDirs.dir2x;
+  p.y = wave1 + wave2;
+  p.z = dz + s1 * waveDirs.dir1y + s2 * waveDirs.dir2y;
+  return p;
+}
+} // namespace
+
+WavePoint gerstnerWave(float px, float pz, const WaveParams &params) {
+  return evaluate(px, pz, params, frameTerms(params));
+}
+
+void evaluateWaveGrid(const float *grid, size_t count,
+                      const WaveParams &params, WavePoint *out) {
+  const FrameTerms f = frameTerms(params);
+  for (size_t i = 0; i < count; i++) {
+    out[i] = evaluate(grid[2 * i], grid[2 * i + 1], params, f);
+  }
+}
+
+static float smoothstep(float edge0, float edge1, float x) {
+  float t = std::min(std::max((x - edge0) / (edge1 - edge0), 0.0f), 1.0f);
+  return t * t * (3.0f - 2.0f * t);
+}
+
+static float mix(float a, float b, float t) { return a + (b - a) * t; }
+
+ParticleLook particleAppearance(const WavePoint &wavePos,
+                                const WaveParams &params,
+                                const ParticleStyle &style) {
+  const float maxExpectedAmp = 0.4f;
+  float rawHeight = (wavePos.y - style.layerOffset + maxExpectedAmp) /
+                    (2.0f * maxExpectedAmp);
+  float heightFactor = std::pow(std::min(std::max(rawHeight, 0.001f), 1.0f),
+                                style.peakExp);
+
+  float sparkleBoost = params.treble * 2.0f;
+  float maxSize = ((style.peakExp > 1.5f) ? 7.0f : 6.0f) + sparkleBoost;
+  ParticleLook look;
+  look.size = mix(2.0f, maxSize, heightFactor) * style.intensity;
+
+  // Far: > 10.0, Main: > 5.0, Near: < 5.0
+  bool isFarLayer = params.gridSize > 10.0f;
+  bool isMainLayer = params.gridSize > 5.0f && !isFarLayer;
+
+  float tone = isFarLayer ? 1.0f : 0.85f;
+  float cyan[3] = {0.1f * tone, 0.6f * tone, 0.9f * tone};
+  float magenta[3] = {1.3f * tone, 0.1f * tone, 1.3f * tone};
+  const float pastelPink[3] = {1.0f, 0.8f, 1.0f};
+  for (float &c : magenta)
+    c += params.treble * 0.2f;
+
+  float colorMix = smoothstep(0.35f, 0.75f, rawHeight);
+  float foamMix = 0.0f;
+  if (isMainLayer)
+    foamMix = smoothstep(0.93f, 1.0f, rawHeight);
+  else if (!isFarLayer)
+    foamMix = smoothstep(0.93f, 1.0f, rawHeight) * 0.3f;
+
+  float pulse = isFarLayer ? params.bass * 0.8f : params.bass * 0.15f;
+  float dynamicIntensity = style.intensity * (1.0f + pulse);
+
+  float color[3];
+  for (int c = 0; c < 3; c++) {
+    float base = mix(cyan[c], magenta[c], colorMix);
+    color[c] = mix(base, pastelPink[c], foamMix) * dynamicIntensity;
+  }
+  look.r = color[0];
+  look.g = color[1];
+  look.b = color[2];
+  return look;
+}
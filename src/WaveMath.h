@@ -0,0 +1,47 @@
+#pragma once
+/*
+ * WaveMath - Evaluacion de ondas Gerstner en CPU
+ * Replica gerstnerWave() y particleAppearance() de particle.glsl
+ * (mismas constantes)
+ */
+
+#include <cstddef>
+
+struct WavePoint {
+  float x = 0.0f;
+  float y = 0.0f;
+  float z = 0.0f;
+};
+
+// Uniforms que afectan a la posicion en shader.vert
+struct WaveParams {
+  float time = 0.0f;
+  float gridSize = 1.0f; // uGridSize
+  float bass = 0.0f;
+  float mids = 0.0f;
+  float treble = 0.0f; // Solo afecta a particleAppearance
+};
+
+// Uniforms por capa que solo afectan al aspecto
+struct ParticleStyle {
+  float intensity = 1.0f;
+  float peakExp = 1.0f;
+  float layerOffset = 0.0f;
+};
+
+// gl_PointSize y color de una particula
+struct ParticleLook {
+  float size = 0.0f;
+  float r = 0.0f, g = 0.0f, b = 0.0f;
+};
+
+WavePoint gerstnerWave(float px, float pz, const WaveParams &params);
+
+// grid: pares (x, z) como los genera generateGrid()
+void evaluateWaveGrid(const float *grid, size_t count,
+                      const WaveParams &params, WavePoint *out);
+
+// wavePos ya incluye layerOffset (como en shader.vert)
+ParticleLook particleAppearance(const WavePoint &wavePos,
+                                const WaveParams &params,
+                                const ParticleStyle &style);
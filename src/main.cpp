@@ -8,10 +8,43 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "AudioSource.h"
+#include "BandEngine.h"
+#include "FrameGraph.h"
+#include "FramePacer.h"
+#ifdef _WIN32
 #include "AudioCapture.h" // Modulo de audio
-#include <fstream>
+#endif
+#ifdef NEON_HAS_SHARED_ANALYSIS
+#include "SharedAnalysis.h"
+#endif
+#ifdef NEON_HAS_WALL_SYNC
+#include "WallSync.h"
+#endif
+#include "GlmTransform.h"
+#include "GpuTimer.h"
+#include "IdleThrottle.h"
+#include "Nebula.h"
+#include "PassTimer.h"
+#include "PostProcess.h"
+#include "RealtimeThread.h"
+#include "RenderBench.h"
+#include "RenderGraph.h"
+#include "RenderTargetPool.h"
+#include "Shader.h"
+#include "Spectrogram.h"
+#include "SpectrogramTexture.h"
+#include "SplatRenderer.h"
+#include "Starfield.h"
+#include "Startup.h"
+#include "Stats.h"
+#include "VideoWall.h"
+#include "WaveLayers.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
-#include <sstream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -20,18 +53,15 @@ unsigned int currentWidth = 1280;
 unsigned int currentHeight = 720;
 bool needsResize = false;
 
-// Framebuffers globales
-unsigned int sceneFBO = 0, sceneColorBuffer = 0;
-unsigned int pingpongFBO[2] = {0, 0};
-unsigned int pingpongBuffer[2] = {0, 0};
+// Nebulosa cacheada para los frames idle (solo si el modo idle esta activo).
+// Escena y bloom son targets del RenderGraph (RenderTargetPool)
+bool nebulaCacheEnabled = true;
+unsigned int nebulaFBO = 0, nebulaColorBuffer = 0;
 
 // Prototipos
 void framebufferSizeCallback(GLFWwindow *window, int width, int height);
 void processInput(GLFWwindow *window);
-std::string readFile(const std::string &path);
-unsigned int createShader(const char *vertexCode, const char *fragmentCode);
-std::vector<float> generateGrid(int size, float spacing);
-void createFramebuffers(unsigned int width, unsigned int height);
+void createNebulaCache(unsigned int width, unsigned int height);
 void setupQuad(unsigned int &quadVAO, unsigned int &quadVBO);
 void setupSkybox(unsigned int &skyboxVAO, unsigned int &skyboxVBO);
 
@@ -47,147 +77,314 @@ float lastFrameTime = 0.0f;
 
 bool mousePressed = false;
 
+// Entrada desde el ultimo frame (despierta del modo idle) y peticiones de
+// redibujado de la ventana (expose)
+bool inputActivity = false;
+bool refreshRequested = false;
+
+// Waves: GL_POINTS con blend aditivo o splatting por tiles en compute
+enum class RenderMode { Raster, Splat };
+RenderMode renderMode = RenderMode::Raster;
+
 void scrollCallback(GLFWwindow *window, double xoffset, double yoffset) {
   cameraDistance -= (float)yoffset * 0.3f;
   cameraDistance = glm::clamp(cameraDistance, 0.5f, 10.0f);
+  inputActivity = true;
+}
+
+void keyCallback(GLFWwindow *window, int key, int scancode, int action,
+                 int mods) {
+  inputActivity = true;
+}
+
+void cursorPosCallback(GLFWwindow *window, double x, double y) {
+  inputActivity = true;
+}
+
+void mouseButtonCallback(GLFWwindow *window, int button, int action,
+                         int mods) {
+  inputActivity = true;
+}
+
+void windowRefreshCallback(GLFWwindow *window) { refreshRequested = true; }
+
+// Captura local en Windows; con --attach, analisis compartido por N renderers
+std::unique_ptr<AudioSource>
+createAudioSource(const std::string &attachName,
+                  const RealtimeOptions &realtime, AnalysisEngine engine) {
+  if (!attachName.empty()) {
+#ifdef NEON_HAS_SHARED_ANALYSIS
+    auto shared = std::make_unique<SharedAnalysisSource>();
+    if (!shared->attach(attachName))
+      return nullptr;
+    return shared;
+#else
+    std::cerr << "--attach no disponible en esta plataforma" << std::endl;
+    return nullptr;
+#endif
+  }
+#ifdef _WIN32
+  return std::make_unique<AudioCapture>(realtime, engine);
+#else
+  return std::make_unique<SilentAudioSource>();
+#endif
 }
 
-int main() {
-  if (!glfwInit()) {
-    std::cerr << "Error iniciando GLFW" << std::endl;
+int main(int argc, char **argv) {
+  // Origen del tiempo hasta el primer frame
+  StartupTimeline startup(monotonicNowNs());
+  bool benchRender = false;
+  std::string attachName; // Servidor neon_analysisd (memoria compartida)
+  PacingConfig pacing;
+  bool swapIntervalSet = false, framesInFlightSet = false;
+  bool benchPacing = false; // Recorre los modos de pacing y sale
+  // Propagacion del audio: ~8 filas (170 ms) de retraso por unidad
+  AudioHistoryParams historyParams;
+  historyParams.rowsPerUnit = 8.0f;
+  RealtimeOptions realtime; // Hilo de captura local (MMCSS por defecto)
+  AnalysisEngine engine = AnalysisEngine::FFT;
+  IdleConfig idleConfig; // Silencio + camara quieta: --idle-fps
+  float bloomScale = 1.0f; // 0: sin bloom (el grafo descarta el blur)
+  // Pared de video: esta ventana es el tile wallTile de columns x rows
+  WallLayout wallLayout;
+  int wallTile = -1;
+  std::string wallSyncName = "/neon-wall";
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--splat") == 0)
+      renderMode = RenderMode::Splat;
+    else if (std::strcmp(argv[i], "--bench-render") == 0)
+      benchRender = true;
+    else if (std::strcmp(argv[i], "--attach") == 0 && i + 1 < argc)
+      attachName = argv[++i];
+    else if (std::strcmp(argv[i], "--pacing") == 0 && i + 1 < argc) {
+      PacingMode mode;
+      if (!parsePacingMode(argv[++i], mode)) {
+        std::cerr << "--pacing: default | low-latency | deadline" << std::endl;
+        return -1;
+      }
+      PacingConfig preset = pacingPreset(mode);
+      preset.swapInterval =
+          swapIntervalSet ? pacing.swapInterval : preset.swapInterval;
+      preset.framesInFlight =
+          framesInFlightSet ? pacing.framesInFlight : preset.framesInFlight;
+      pacing = preset;
+    } else if (std::strcmp(argv[i], "--swap-interval") == 0 && i + 1 < argc) {
+      pacing.swapInterval = std::atoi(argv[++i]);
+      swapIntervalSet = true;
+    } else if (std::strcmp(argv[i], "--frames-in-flight") == 0 &&
+               i + 1 < argc) {
+      pacing.framesInFlight = clampFramesInFlight(std::atoi(argv[++i]));
+      framesInFlightSet = true;
+    } else if (std::strcmp(argv[i], "--bench-pacing") == 0)
+      benchPacing = true;
+    else if (std::strcmp(argv[i], "--history-rate") == 0 && i + 1 < argc)
+      historyParams.rowsPerUnit = (float)std::atof(argv[++i]);
+    else if (std::strcmp(argv[i], "--rt-policy") == 0 && i + 1 < argc) {
+      if (!parseRealtimePolicy(argv[++i], realtime.policy)) {
+        std::cerr << "--rt-policy: normal | fifo | rr" << std::endl;
+        return -1;
+      }
+    } else if (std::strcmp(argv[i], "--rt-priority") == 0 && i + 1 < argc)
+      realtime.priority = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--rt-cpu") == 0 && i + 1 < argc)
+      realtime.cpu = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--mlock") == 0)
+      realtime.lockMemory = true;
+    else if (std::strcmp(argv[i], "--no-mmcss") == 0)
+      realtime.mmcss = false;
+    else if (std::strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+      if (!parseAnalysisEngine(argv[++i], engine)) {
+        std::cerr << "--engine: fft | filterbank" << std::endl;
+        return -1;
+      }
+    } else if (std::strcmp(argv[i], "--idle-fps") == 0 && i + 1 < argc)
+      idleConfig.idleFps = std::max(0.0, std::atof(argv[++i]));
+    else if (std::strcmp(argv[i], "--idle-after") == 0 && i + 1 < argc)
+      idleConfig.enterAfterMs = std::max(0.0, std::atof(argv[++i]) * 1000.0);
+    else if (std::strcmp(argv[i], "--bloom") == 0 && i + 1 < argc)
+      bloomScale = std::max(0.0f, (float)std::atof(argv[++i]));
+    else if (std::strcmp(argv[i], "--wall") == 0 && i + 1 < argc) {
+      if (!parseWallGrid(argv[++i], wallLayout.columns, wallLayout.rows)) {
+        std::cerr << "--wall: COLUMNASxFILAS, p.ej. 3x2" << std::endl;
+        return -1;
+      }
+    } else if (std::strcmp(argv[i], "--tile") == 0 && i + 1 < argc)
+      wallTile = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--guard") == 0 && i + 1 < argc)
+      wallLayout.guard = std::max(0, std::atoi(argv[++i]));
+    else if (std::strcmp(argv[i], "--wall-sync") == 0 && i + 1 < argc)
+      wallSyncName = argv[++i];
+  }
+  const bool wall = wallTile >= 0;
+  if (wall && wallTile >= wallLayout.tiles()) {
+    std::cerr << "--tile: 0.." << wallLayout.tiles() - 1 << std::endl;
+    return -1;
+  }
+  // Todos los tiles dibujan todos los frames: sin modo idle
+  if (wall)
+    idleConfig.idleFps = 0.0;
+  // El benchmark de pacing mide frames a ritmo normal
+  if (benchPacing)
+    idleConfig.idleFps = 0.0;
+  nebulaCacheEnabled = idleConfig.idleFps > 0.0;
+
+  // Fuentes de shaders y rejillas en dos hilos mientras se crea el
+  // contexto; el resto del arranque se anota en 'startup'
+  StartupLoader assets;
+  if (!benchRender)
+    assets.start(loadShaderSource, "shaders/", startup);
+
+  // Audio antes que la ventana: el hilo de captura inicializa el
+  // dispositivo (o se conecta al servidor) en paralelo
+  std::unique_ptr<AudioSource> audioSource;
+  {
+    StartupScope scope(startup, "main", "audio_start");
+    // En la pared solo el lider escucha; los demas reciben su analisis
+    if (wall && wallTile != 0)
+      audioSource = std::make_unique<SilentAudioSource>();
+    else
+      audioSource = createAudioSource(attachName, realtime, engine);
+    if (audioSource && !benchRender)
+      audioSource->start();
+  }
+  if (!audioSource)
+    return -1;
+
+#ifdef NEON_HAS_WALL_SYNC
+  // El lider crea el frame lock; los demas esperan a que exista
+  WallSync wallSync;
+  if (wall) {
+    StartupScope scope(startup, "main", "wall_sync");
+    if (!(wallTile == 0
+              ? wallSync.create(wallSyncName, wallLayout.tiles())
+              : wallSync.attach(wallSyncName, wallTile, WALL_TIMEOUT_MS)))
+      return -1;
+  }
+#else
+  if (wall) {
+    std::cerr << "--wall necesita memoria compartida POSIX" << std::endl;
     return -1;
   }
+#endif
+
+  GLFWwindow *window = nullptr;
+  {
+    StartupScope scope(startup, "main", "window");
+    if (!glfwInit()) {
+      std::cerr << "Error iniciando GLFW" << std::endl;
+      return -1;
+    }
 
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
-  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    if (benchRender)
+      glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
-  GLFWwindow *window = glfwCreateWindow(currentWidth, currentHeight,
-                                        "Neon Gerstner", nullptr, nullptr);
+    window = glfwCreateWindow(currentWidth, currentHeight, "Neon Gerstner",
+                              nullptr, nullptr);
+  }
   if (!window) {
     std::cerr << "Error creando ventana" << std::endl;
     glfwTerminate();
     return -1;
   }
 
-  // Iniciar captura de audio
-  AudioCapture audioCapture;
-  audioCapture.start();
-
   lastFrameTime = (float)glfwGetTime();
 
-  glfwMakeContextCurrent(window);
-  glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
-  glfwSetScrollCallback(window, scrollCallback);
-
-  if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-    std::cerr << "Error iniciando GLAD" << std::endl;
-    return -1;
+  {
+    StartupScope scope(startup, "main", "gl_context");
+    glfwMakeContextCurrent(window);
+    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetCursorPosCallback(window, cursorPosCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetWindowRefreshCallback(window, windowRefreshCallback);
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+      std::cerr << "Error iniciando GLAD" << std::endl;
+      return -1;
+    }
   }
 
   std::cout << "OpenGL: " << glGetString(GL_VERSION) << std::endl;
   std::cout << "GPU: " << glGetString(GL_RENDERER) << std::endl;
 
+  if (benchRender) {
+    // Benchmark offscreen: rasterizado vs splatting a 1080p y 4K
+    int result = runRenderBenchmark();
+    glfwTerminate();
+    return result;
+  }
+
+  // Primer present: el fondo del combine en lugar de un backbuffer sin
+  // inicializar mientras se compilan los shaders
+  glClearColor(0.01f, 0.01f, 0.01f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT);
+  glfwSwapBuffers(window);
+  startup.mark("first present", monotonicNowNs());
+
   // Additive blending for glow effect
   glBlendFunc(GL_ONE, GL_ONE);
   glEnable(GL_PROGRAM_POINT_SIZE);
 
-  // Shaders
-  std::string vertCode = readFile("shaders/shader.vert");
-  std::string fragCode = readFile("shaders/shader.frag");
-  unsigned int particleShader =
-      createShader(vertCode.c_str(), fragCode.c_str());
-
-  std::string bloomVertCode = readFile("shaders/bloom.vert");
-  std::string bloomFragCode = readFile("shaders/bloom.frag");
-  unsigned int bloomShader =
-      createShader(bloomVertCode.c_str(), bloomFragCode.c_str());
-
-  // Star background shader
-  std::string starVertCode = readFile("shaders/stars.vert");
-  std::string starFragCode = readFile("shaders/stars.frag");
-  unsigned int starShader =
-      createShader(starVertCode.c_str(), starFragCode.c_str());
-
-  // Nebula background shader
-  std::string nebulaVertCode = readFile("shaders/nebula.vert");
-  std::string nebulaFragCode = readFile("shaders/nebula.frag");
-  unsigned int nebulaShader =
-      createShader(nebulaVertCode.c_str(), nebulaFragCode.c_str());
-
-  // Main Layer
-  std::vector<float> mainGrid = generateGrid(200, 0.03f);
-  int mainCount = 200 * 200;
-  unsigned int mainVAO, mainVBO;
-  glGenVertexArrays(1, &mainVAO);
-  glGenBuffers(1, &mainVBO);
-  glBindVertexArray(mainVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, mainVBO);
-  glBufferData(GL_ARRAY_BUFFER, mainGrid.size() * sizeof(float),
-               mainGrid.data(), GL_STATIC_DRAW);
-  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void *)0);
-  glEnableVertexAttribArray(0);
-
-  // Near Layer
-  std::vector<float> nearGrid = generateGrid(300, 0.015f);
-  int nearCount = 300 * 300;
-  unsigned int nearVAO, nearVBO;
-  glGenVertexArrays(1, &nearVAO);
-  glGenBuffers(1, &nearVBO);
-  glBindVertexArray(nearVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, nearVBO);
-  glBufferData(GL_ARRAY_BUFFER, nearGrid.size() * sizeof(float),
-               nearGrid.data(), GL_STATIC_DRAW);
-  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void *)0);
-  glEnableVertexAttribArray(0);
-
-  // Far Layer
-  std::vector<float> farGrid = generateGrid(100, 0.25f);
-  int farCount = 100 * 100;
-  unsigned int farVAO, farVBO;
-  glGenVertexArrays(1, &farVAO);
-  glGenBuffers(1, &farVBO);
-  glBindVertexArray(farVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, farVBO);
-  glBufferData(GL_ARRAY_BUFFER, farGrid.size() * sizeof(float), farGrid.data(),
-               GL_STATIC_DRAW);
-  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void *)0);
-  glEnableVertexAttribArray(0);
-
-  // === STARFIELD BACKGROUND (4900 stars, 4-panel enclosure) ===
-  std::vector<float> starGrid = generateGrid(70, 1.8f); // Denser spacing
-  int starCount = 70 * 70;
-  unsigned int starVAO, starVBO;
-  glGenVertexArrays(1, &starVAO);
-  glGenBuffers(1, &starVBO);
-  glBindVertexArray(starVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, starVBO);
-  glBufferData(GL_ARRAY_BUFFER, starGrid.size() * sizeof(float),
-               starGrid.data(), GL_STATIC_DRAW);
-  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void *)0);
-  glEnableVertexAttribArray(0);
-  std::cout << "Starfield: " << starCount << " stars" << std::endl;
-
-  createFramebuffers(currentWidth, currentHeight);
-
+  // Shaders del primer frame: nebulosa y combine. Estrellas y ondas se
+  // compilan en los frames siguientes (startupSteps)
+  const StartupShaderSources &shaderSources = assets.shaders();
+  unsigned int bloomShader = 0, nebulaShader = 0;
+  {
+    StartupScope scope(startup, "main", "core_shaders");
+    bloomShader = createShader(shaderSources.bloom.vertex.c_str(),
+                               shaderSources.bloom.fragment.c_str());
+    nebulaShader = createShader(shaderSources.nebula.vertex.c_str(),
+                                shaderSources.nebula.fragment.c_str());
+  }
+  unsigned int particleShader = 0, starShader = 0;
+
+  // Wave Layers (far, main, near)
+  unsigned int waveVAO[WAVE_LAYER_COUNT] = {}, waveVBO[WAVE_LAYER_COUNT] = {};
+  int waveCount[WAVE_LAYER_COUNT] = {};
+  SplatRenderer splatRenderer;
+
+  // Starfield (4900 stars, 4-panel enclosure)
+  unsigned int starVAO = 0, starVBO = 0;
+  int starCount = 0;
+
+  // Ritmo de frame: swap interval, frames en vuelo y lectura del audio
+  const PacingMode benchModes[] = {PacingMode::Default, PacingMode::LowLatency,
+                                   PacingMode::Deadline};
+  const int benchWarmupFrames = 30, benchMeasuredFrames = 300;
+  int benchModeIndex = 0, benchFrame = 0;
+  if (benchPacing)
+    pacing = pacingPreset(benchModes[0]);
+  auto pacer = std::make_unique<FramePacer>();
+  SpectrogramHistory spectrogram;
+  auto spectrogramTexture = std::make_unique<SpectrogramTexture>();
   unsigned int quadVAO, quadVBO;
-  setupQuad(quadVAO, quadVBO);
-
   unsigned int skyboxVAO, skyboxVBO;
-  setupSkybox(skyboxVAO, skyboxVBO);
+  {
+    StartupScope scope(startup, "main", "frame_resources");
+    pacer->configure(window, pacing);
 
-  // Uniforms
-  int timeLoc = glGetUniformLocation(particleShader, "time");
-  int mvpLoc = glGetUniformLocation(particleShader, "mvp");
-  int layerOffsetLoc = glGetUniformLocation(particleShader, "layerOffset");
-  int intensityLoc = glGetUniformLocation(particleShader, "intensity");
-  int gridSizeLoc = glGetUniformLocation(particleShader, "uGridSize");
-  int peakExpLoc = glGetUniformLocation(particleShader, "peakExp");
+    // Historial de espectro: ring en CPU + textura que recibe solo filas
+    // nuevas
+    spectrogramTexture->initialize(spectrogram.bins(), spectrogram.rows());
+
+    createNebulaCache(currentWidth, currentHeight);
+    setupQuad(quadVAO, quadVBO);
+    setupSkybox(skyboxVAO, skyboxVBO);
+  }
+  std::cout << "Pacing: " << pacingModeName(pacing.mode) << std::endl;
+  SpectrogramClock spectrogramClock;
+  uint64_t lastAudioSequence = 0;
+
+  // Uniforms (estrellas y ondas al compilar sus programas)
+  int timeLoc = -1, mvpLoc = -1, layerOffsetLoc = -1, intensityLoc = -1;
+  int gridSizeLoc = -1, peakExpLoc = -1;
 
   // Audio uniforms
-  int bassLoc = glGetUniformLocation(particleShader, "uBass");
-  int midsLoc = glGetUniformLocation(particleShader, "uMids");
-  int trebleLoc = glGetUniformLocation(particleShader, "uTreble");
+  int bassLoc = -1, midsLoc = -1, trebleLoc = -1;
 
   int sceneLoc = glGetUniformLocation(bloomShader, "scene");
   int bloomBlurLoc = glGetUniformLocation(bloomShader, "bloomBlur");
@@ -196,10 +393,7 @@ int main() {
   int bloomStrengthLoc = glGetUniformLocation(bloomShader, "bloomStrength");
 
   // Star shader uniforms
-  int starTimeLoc = glGetUniformLocation(starShader, "time");
-  int starMvpLoc = glGetUniformLocation(starShader, "mvp");
-  int starBassLoc = glGetUniformLocation(starShader, "uBass");
-  int starTrebleLoc = glGetUniformLocation(starShader, "uTreble");
+  int starTimeLoc = -1, starMvpLoc = -1, starBassLoc = -1, starTrebleLoc = -1;
 
   // Nebula shader uniforms
   int nebulaTimeLoc = glGetUniformLocation(nebulaShader, "time");
@@ -207,236 +401,531 @@ int main() {
   int nebulaMidsLoc = glGetUniformLocation(nebulaShader, "uMids");
   int nebulaMvpLoc = glGetUniformLocation(nebulaShader, "mvp");
 
-  while (!glfwWindowShouldClose(window)) {
-    processInput(window);
-
-    if (needsResize) {
-      createFramebuffers(currentWidth, currentHeight);
-      needsResize = false;
+  // Arranque progresivo: un paso por frame tras el primero. Hasta que
+  // terminan, el grafo descarta sus pasadas
+  bool starsReady = false, wavesReady = false;
+  StartupSequence startupSteps;
+  startupSteps.add("stars", [&] {
+    starShader = createShader(shaderSources.stars.vertex.c_str(),
+                              shaderSources.stars.fragment.c_str());
+    starTimeLoc = glGetUniformLocation(starShader, "time");
+    starMvpLoc = glGetUniformLocation(starShader, "mvp");
+    starBassLoc = glGetUniformLocation(starShader, "uBass");
+    starTrebleLoc = glGetUniformLocation(starShader, "uTreble");
+
+    const std::vector<float> &starGrid = assets.grids().stars;
+    starCount = STAR_GRID_COUNT * STAR_GRID_COUNT;
+    glGenVertexArrays(1, &starVAO);
+    glGenBuffers(1, &starVBO);
+    glBindVertexArray(starVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, starVBO);
+    glBufferData(GL_ARRAY_BUFFER, starGrid.size() * sizeof(float),
+                 starGrid.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float),
+                          (void *)0);
+    glEnableVertexAttribArray(0);
+    std::cout << "Starfield: " << starCount << " stars" << std::endl;
+    starsReady = true;
+  });
+  startupSteps.add("particle_shader", [&] {
+    particleShader = createShader(shaderSources.particle.vertex.c_str(),
+                                  shaderSources.particle.fragment.c_str());
+    timeLoc = glGetUniformLocation(particleShader, "time");
+    mvpLoc = glGetUniformLocation(particleShader, "mvp");
+    layerOffsetLoc = glGetUniformLocation(particleShader, "layerOffset");
+    intensityLoc = glGetUniformLocation(particleShader, "intensity");
+    gridSizeLoc = glGetUniformLocation(particleShader, "uGridSize");
+    peakExpLoc = glGetUniformLocation(particleShader, "peakExp");
+    bassLoc = glGetUniformLocation(particleShader, "uBass");
+    midsLoc = glGetUniformLocation(particleShader, "uMids");
+    trebleLoc = glGetUniformLocation(particleShader, "uTreble");
+  });
+  startupSteps.add("waves", [&] {
+    const StartupGrids &grids = assets.grids();
+    glGenVertexArrays(WAVE_LAYER_COUNT, waveVAO);
+    glGenBuffers(WAVE_LAYER_COUNT, waveVBO);
+    for (size_t i = 0; i < WAVE_LAYER_COUNT; i++) {
+      const WaveLayerDesc &desc = WAVE_LAYERS[i];
+      const std::vector<float> &grid = grids.waves[i];
+      waveCount[i] = desc.gridCount * desc.gridCount;
+      glBindVertexArray(waveVAO[i]);
+      glBindBuffer(GL_ARRAY_BUFFER, waveVBO[i]);
+      glBufferData(GL_ARRAY_BUFFER, grid.size() * sizeof(float), grid.data(),
+                   GL_STATIC_DRAW);
+      glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float),
+                            (void *)0);
+      glEnableVertexAttribArray(0);
     }
 
-    // === RENDERIZAR ESCENA ===
-    glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+    // Compute splatting (alternativa a GL_POINTS para las ondas)
+    if (renderMode == RenderMode::Splat && !splatRenderer.initialize()) {
+      std::cerr << "Splatting no disponible, usando rasterizado" << std::endl;
+      renderMode = RenderMode::Raster;
+    }
+    std::cout << "Waves: "
+              << (renderMode == RenderMode::Splat ? "compute splatting"
+                                                  : "rasterized points")
+              << std::endl;
+    wavesReady = true;
+  });
+  // Un tile que mostrara las ondas un frame antes que su vecino se
+  // notaria en la pared: todo listo antes del primer frame
+  if (wall)
+    while (startupSteps.runNext(startup)) {
+    }
+  bool startupReported = false;
+
+  // bloomBlur del combine cuando el grafo descarta el blur
+  unsigned int blackTexture = 0;
+  const float black[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+  glGenTextures(1, &blackTexture);
+  glBindTexture(GL_TEXTURE_2D, blackTexture);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, 1, 1, 0, GL_RGBA, GL_FLOAT,
+               black);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+  // Lo que se dibuja (area: tile + guarda) y lo que se ve (core); sin
+  // pared ambos son la ventana
+  WallRect wallCore, wallArea;
+
+  // Combine Pass: escena + bloom al framebuffer de la ventana
+  auto combinePass = [&](unsigned int sceneTexture,
+                         unsigned int bloomTexture) {
+    glDisable(GL_BLEND);
+    glUseProgram(bloomShader);
+    glBindVertexArray(quadVAO);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glViewport(0, 0, currentWidth, currentHeight);
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClearColor(0.01f, 0.01f, 0.01f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
+    // La banda de guarda de un tile cae fuera de la ventana
+    glViewport(wallArea.x - wallCore.x,
+               wallCore.y + wallCore.height - (wallArea.y + wallArea.height),
+               wallArea.width, wallArea.height);
 
-    glEnable(GL_BLEND);
-
-    glUseProgram(particleShader);
-    glUseProgram(particleShader);
-
-    // Calcular tiempo variable basado en musica
-    float currentFrameTime = (float)glfwGetTime();
-    float deltaTime = currentFrameTime - lastFrameTime;
-    lastFrameTime = currentFrameTime;
-
-    // Speed modulation
-    float audioIntensity =
-        audioCapture.getMids() + (audioCapture.getTreble() * 0.5f);
-    audioIntensity = std::min(audioIntensity, 0.7f);
-    float speedMultiplier = 1.0f + (audioIntensity * 2.0f);
-    accumulatedTime += deltaTime * speedMultiplier;
-
-    glUniform1f(timeLoc, accumulatedTime);
-
-    // Audio uniforms
-    float bass = audioCapture.getBass();
-    float mids = audioCapture.getMids();
-    float treble = audioCapture.getTreble();
+    glUniform1i(passTypeLoc, 1);
 
-    glUniform1f(bassLoc, bass);
-    glUniform1f(midsLoc, mids);
-    glUniform1f(trebleLoc, treble);
+    glUniform1f(bloomStrengthLoc,
+                bloomScale * bloomStrengthFor(cameraDistance));
 
-    glm::mat4 projection = glm::perspective(
-        glm::radians(45.0f), (float)currentWidth / (float)currentHeight, 0.1f,
-        400.0f);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, sceneTexture);
+    glUniform1i(sceneLoc, 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, bloomTexture);
+    glUniform1i(bloomBlurLoc, 1);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glActiveTexture(GL_TEXTURE0);
+  };
+
+  // Modo idle: sin audio ni entrada se dibuja a --idle-fps y se esperan
+  // eventos entre frames. Los frames idle no pasan por el pacer (sus
+  // muestras son del ritmo normal); su GPU se mide con un timer propio
+  idleConfig.activePeriodMs = pacer->periodMs();
+  IdleThrottle idle(idleConfig);
+  auto idleGpuTimer = std::make_unique<GpuTimer>();
+  size_t gpuSamplesSeen = 0;
+  if (idle.enabled())
+    std::cout << "Idle: " << idleConfig.idleFps << " fps after "
+              << idleConfig.enterAfterMs / 1000.0 << " s of silence"
+              << std::endl;
+  idle.reset(monotonicNowNs() / 1e6);
+
+  // Grafo del frame: se declara cada frame (FrameGraph.cpp), compile()
+  // descarta lo que no llega a pantalla y reparte escena / ping-pong en
+  // las texturas del pool. PassTimer mide CPU y GPU por pasada
+  RenderGraph graph;
+  auto targetPool = std::make_unique<RenderTargetPool>();
+  PassTimings passTimings;
+  auto passTimer = std::make_unique<PassTimer>(passTimings);
+  FrameGraphTargets targets;
+  // Lo que uso el ultimo combine: el Present idle lo recompone
+  unsigned int lastSceneTexture = 0, lastBloomTexture = blackTexture;
+
+  // Estado del frame que leen las pasadas
+  double nowMs = 0.0;
+  float bass = 0.0f, mids = 0.0f, treble = 0.0f;
+  glm::mat4 projection(1.0f);
+  bool cachedNebula = false;
+#ifdef NEON_HAS_WALL_SYNC
+  WallClock wallClock(1000.0 / pacer->periodMs());
+  uint64_t wallFrameIndex = 0;
+#endif
+
+  auto targetFBO = [&](ResourceHandle target) {
+    return targetPool->framebuffer(graph.slot(target));
+  };
+  auto targetTexture = [&](ResourceHandle target) {
+    return targetPool->texture(graph.slot(target));
+  };
+
+  FrameGraphCallbacks passes;
+  passes.nebula = [&] {
+    glBindFramebuffer(GL_FRAMEBUFFER, targetFBO(targets.scene));
+    glViewport(0, 0, wallArea.width, wallArea.height);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
 
     // Skybox Background
     glDisable(GL_BLEND);
     glDepthMask(GL_FALSE);
-    glUseProgram(nebulaShader);
-    glUniform1f(nebulaTimeLoc, accumulatedTime);
-    glUniform1f(nebulaBassLoc, bass);
-    glUniform1f(nebulaMidsLoc, mids);
-    glBindVertexArray(skyboxVAO);
-
-    // Skybox render loop
-    glm::mat4 skyboxModel = glm::mat4(1.0f);
-    skyboxModel =
-        glm::rotate(skyboxModel, cameraAngleX, glm::vec3(1.0f, 0.0f, 0.0f));
-    skyboxModel =
-        glm::rotate(skyboxModel, cameraAngleY, glm::vec3(0.0f, 1.0f, 0.0f));
-    skyboxModel = glm::scale(
-        skyboxModel,
-        glm::vec3(200.0f)); // Large cube to cover frustum (far plane 400)
-    glUniformMatrix4fv(nebulaMvpLoc, 1, GL_FALSE,
-                       glm::value_ptr(projection * skyboxModel));
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-
+    // En idle la nebulosa se dibuja en su cache solo de vez en cuando
+    if (!cachedNebula || idle.refreshNebula(nowMs)) {
+      if (cachedNebula)
+        glBindFramebuffer(GL_FRAMEBUFFER, nebulaFBO);
+      glUseProgram(nebulaShader);
+      glUniform1f(nebulaTimeLoc, accumulatedTime);
+      glUniform1f(nebulaBassLoc, bass);
+      glUniform1f(nebulaMidsLoc, mids);
+      glBindVertexArray(skyboxVAO);
+
+      // Skybox render loop
+      glUniformMatrix4fv(
+          nebulaMvpLoc, 1, GL_FALSE,
+          glm::value_ptr(projection *
+                         toGlm(skyboxModel(cameraAngleX, cameraAngleY))));
+      glDrawArrays(GL_TRIANGLES, 0, 36);
+    }
+    if (cachedNebula) {
+      glBindFramebuffer(GL_READ_FRAMEBUFFER, nebulaFBO);
+      glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetFBO(targets.scene));
+      glBlitFramebuffer(0, 0, wallArea.width, wallArea.height, 0, 0,
+                        wallArea.width, wallArea.height, GL_COLOR_BUFFER_BIT,
+                        GL_NEAREST);
+      glBindFramebuffer(GL_FRAMEBUFFER, targetFBO(targets.scene));
+    }
     glDepthMask(GL_TRUE);
-    glEnable(GL_BLEND);
+  };
 
+  passes.stars = [&] {
     // Starfield Background
+    glEnable(GL_BLEND);
     glUseProgram(starShader);
     glUniform1f(starTimeLoc, accumulatedTime);
     glUniform1f(starBassLoc, bass);
     glUniform1f(starTrebleLoc, treble);
     glBindVertexArray(starVAO);
 
-    // Starfield grid dimensions
-    float gridHalf = 62.0f;
-    float starDist = gridHalf;
-
-    // Front layer
-    glm::mat4 starView = glm::mat4(1.0f);
-    starView = glm::rotate(starView, cameraAngleX, glm::vec3(1.0f, 0.0f, 0.0f));
-    starView = glm::rotate(starView, cameraAngleY, glm::vec3(0.0f, 1.0f, 0.0f));
-    starView = glm::translate(starView, glm::vec3(0.0f, 0.0f, -starDist));
-    glUniformMatrix4fv(starMvpLoc, 1, GL_FALSE,
-                       glm::value_ptr(projection * starView));
-    glDrawArrays(GL_POINTS, 0, starCount);
-
-    // Back layer
-    starView = glm::mat4(1.0f);
-    starView = glm::rotate(starView, cameraAngleX, glm::vec3(1.0f, 0.0f, 0.0f));
-    starView = glm::rotate(starView, cameraAngleY, glm::vec3(0.0f, 1.0f, 0.0f));
-    starView = glm::translate(starView, glm::vec3(0.0f, 0.0f, starDist));
-    glUniformMatrix4fv(starMvpLoc, 1, GL_FALSE,
-                       glm::value_ptr(projection * starView));
-    glDrawArrays(GL_POINTS, 0, starCount);
-
-    // East layer
-    starView = glm::mat4(1.0f);
-    starView = glm::rotate(starView, cameraAngleX, glm::vec3(1.0f, 0.0f, 0.0f));
-    starView = glm::rotate(starView, cameraAngleY, glm::vec3(0.0f, 1.0f, 0.0f));
-    starView = glm::translate(starView, glm::vec3(starDist, 0.0f, 0.0f));
-    starView = glm::rotate(starView, glm::half_pi<float>(),
-                           glm::vec3(0.0f, 1.0f, 0.0f));
-    glUniformMatrix4fv(starMvpLoc, 1, GL_FALSE,
-                       glm::value_ptr(projection * starView));
-    glDrawArrays(GL_POINTS, 0, starCount);
-
-    // West layer
-    starView = glm::mat4(1.0f);
-    starView = glm::rotate(starView, cameraAngleX, glm::vec3(1.0f, 0.0f, 0.0f));
-    starView = glm::rotate(starView, cameraAngleY, glm::vec3(0.0f, 1.0f, 0.0f));
-    starView = glm::translate(starView, glm::vec3(-starDist, 0.0f, 0.0f));
-    starView = glm::rotate(starView, -glm::half_pi<float>(),
-                           glm::vec3(0.0f, 1.0f, 0.0f));
-    glUniformMatrix4fv(starMvpLoc, 1, GL_FALSE,
-                       glm::value_ptr(projection * starView));
-    glDrawArrays(GL_POINTS, 0, starCount);
-
-    // Render Waves
+    // 4 paneles alrededor de la camara (front, back, east, west)
+    for (size_t panel = 0; panel < STAR_PANEL_COUNT; panel++) {
+      glm::mat4 starView =
+          toGlm(starPanelView(panel, cameraAngleX, cameraAngleY));
+      glUniformMatrix4fv(starMvpLoc, 1, GL_FALSE,
+                         glm::value_ptr(projection * starView));
+      glDrawArrays(GL_POINTS, 0, starCount);
+    }
+  };
+
+  passes.waves = [&](size_t i) {
+    glEnable(GL_BLEND);
     glUseProgram(particleShader);
+    glUniform1f(timeLoc, accumulatedTime);
+    glUniform1f(bassLoc, bass);
+    glUniform1f(midsLoc, mids);
+    glUniform1f(trebleLoc, treble);
+    spectrogramTexture->apply(particleShader, historyParams);
 
-    // Far Layer
-    glm::mat4 farView = glm::mat4(1.0f);
-    farView =
-        glm::translate(farView, glm::vec3(0.0f, -1.0f, -cameraDistance - 0.5f));
-    farView = glm::rotate(farView, cameraAngleX, glm::vec3(1.0f, 0.0f, 0.0f));
-    farView = glm::rotate(farView, cameraAngleY, glm::vec3(0.0f, 1.0f, 0.0f));
-    glUniformMatrix4fv(mvpLoc, 1, GL_FALSE,
-                       glm::value_ptr(projection * farView));
-    glUniform1f(layerOffsetLoc, 0.0f);
-    glUniform1f(intensityLoc, 0.6f);
-    glUniform1f(gridSizeLoc, 100.0f * 0.25f);
-    glUniform1f(peakExpLoc, 10.0f);
-    glBindVertexArray(farVAO);
-    glDrawArrays(GL_POINTS, 0, farCount);
-
-    // Main Layer
-    glm::mat4 mainView = glm::mat4(1.0f);
-    mainView = glm::translate(mainView, glm::vec3(0.0f, 0.0f, -cameraDistance));
-    mainView = glm::rotate(mainView, cameraAngleX, glm::vec3(1.0f, 0.0f, 0.0f));
-    mainView = glm::rotate(mainView, cameraAngleY, glm::vec3(0.0f, 1.0f, 0.0f));
-    glUniformMatrix4fv(mvpLoc, 1, GL_FALSE,
-                       glm::value_ptr(projection * mainView));
+    glm::mat4 view =
+        toGlm(waveLayerView(i, cameraDistance, cameraAngleX, cameraAngleY));
+    glUniformMatrix4fv(mvpLoc, 1, GL_FALSE, glm::value_ptr(projection * view));
     glUniform1f(layerOffsetLoc, 0.0f);
-    glUniform1f(intensityLoc, 1.8f);
-    glUniform1f(gridSizeLoc, 200.0f * 0.03f);
-    glUniform1f(peakExpLoc, 1.0f);
-    glBindVertexArray(mainVAO);
-    glDrawArrays(GL_POINTS, 0, mainCount);
-
-    // Near Layer
-    glm::mat4 nearView = glm::mat4(1.0f);
-    nearView = glm::translate(nearView, glm::vec3(0.0f, 0.3f, -1.2f));
-    nearView = glm::rotate(nearView, cameraAngleX, glm::vec3(1.0f, 0.0f, 0.0f));
-    nearView = glm::rotate(nearView, cameraAngleY, glm::vec3(0.0f, 1.0f, 0.0f));
-    glUniformMatrix4fv(mvpLoc, 1, GL_FALSE,
-                       glm::value_ptr(projection * nearView));
-    glUniform1f(layerOffsetLoc, 0.0f);
-    glUniform1f(intensityLoc, 0.5f);
-    glUniform1f(gridSizeLoc, 300.0f * 0.015f);
-    glUniform1f(peakExpLoc, 1.0f);
-    glBindVertexArray(nearVAO);
-    glDrawArrays(GL_POINTS, 0, nearCount);
+    glUniform1f(intensityLoc, WAVE_LAYERS[i].intensity);
+    glUniform1f(gridSizeLoc, WAVE_LAYERS[i].gridSize());
+    glUniform1f(peakExpLoc, WAVE_LAYERS[i].peakExp);
+    glBindVertexArray(waveVAO[i]);
+    glDrawArrays(GL_POINTS, 0, waveCount[i]);
+  };
+
+  passes.splat = [&] {
+    SplatFrameUniforms frame;
+    frame.time = accumulatedTime;
+    frame.bass = bass;
+    frame.mids = mids;
+    frame.treble = treble;
+    frame.history = spectrogramTexture.get();
+    frame.historyParams = historyParams;
+
+    std::vector<SplatLayer> splatLayers(WAVE_LAYER_COUNT);
+    for (size_t i = 0; i < WAVE_LAYER_COUNT; i++) {
+      splatLayers[i].gridVBO = waveVBO[i];
+      splatLayers[i].count = waveCount[i];
+      splatLayers[i].mvp =
+          projection *
+          toGlm(waveLayerView(i, cameraDistance, cameraAngleX, cameraAngleY));
+      splatLayers[i].intensity = WAVE_LAYERS[i].intensity;
+      splatLayers[i].gridSize = WAVE_LAYERS[i].gridSize();
+      splatLayers[i].peakExp = WAVE_LAYERS[i].peakExp;
+    }
+    splatRenderer.render(targetTexture(targets.scene), wallArea.width,
+                         wallArea.height, frame, splatLayers);
+  };
 
-    // Blur Pass
+  passes.blur = [&](ResourceHandle from, ResourceHandle to, bool horizontal) {
+    // El quad cubre el target entero: no hace falta limpiarlo
     glDisable(GL_BLEND);
     glUseProgram(bloomShader);
     glUniform1i(passTypeLoc, 0);
-
-    glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[0]);
-    glClear(GL_COLOR_BUFFER_BIT);
-    glUniform1i(horizontalLoc, 1);
+    glBindFramebuffer(GL_FRAMEBUFFER, targetFBO(to));
+    glUniform1i(horizontalLoc, horizontal ? 1 : 0);
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, sceneColorBuffer);
+    glBindTexture(GL_TEXTURE_2D, targetTexture(from));
     glUniform1i(sceneLoc, 0);
     glBindVertexArray(quadVAO);
     glDrawArrays(GL_TRIANGLES, 0, 6);
+  };
 
-    glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[1]);
-    glClear(GL_COLOR_BUFFER_BIT);
-    glUniform1i(horizontalLoc, 0);
-    glBindTexture(GL_TEXTURE_2D, pingpongBuffer[0]);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+  passes.combine = [&] {
+    lastSceneTexture = targetTexture(targets.scene);
+    lastBloomTexture = graph.available(targets.bloomResult)
+                           ? targetTexture(targets.bloomResult)
+                           : blackTexture;
+    combinePass(lastSceneTexture, lastBloomTexture);
+  };
 
-    for (int i = 0; i < 3; i++) {
-      glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[0]);
-      glUniform1i(horizontalLoc, 1);
-      glBindTexture(GL_TEXTURE_2D, pingpongBuffer[1]);
-      glDrawArrays(GL_TRIANGLES, 0, 6);
+  while (!glfwWindowShouldClose(window)) {
+    processInput(window);
 
-      glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[1]);
-      glUniform1i(horizontalLoc, 0);
-      glBindTexture(GL_TEXTURE_2D, pingpongBuffer[0]);
-      glDrawArrays(GL_TRIANGLES, 0, 6);
+    if (needsResize) {
+      createNebulaCache(currentWidth, currentHeight);
+      idle.invalidateCache();
+      needsResize = false;
     }
 
-    // Combine Pass
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glViewport(0, 0, currentWidth, currentHeight);
-    glClearColor(0.01f, 0.01f, 0.01f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+    nowMs = monotonicNowNs() / 1e6;
+    if (inputActivity)
+      idle.input(nowMs);
+    if (refreshRequested)
+      idle.requestPresent();
+    inputActivity = refreshRequested = false;
+    idle.audio(audioSource->latest(), nowMs);
+
+    IdleAction action = idle.next(nowMs);
+    if (action == IdleAction::Wait) {
+      // Vuelve con cualquier evento o a la rodaja (un periodo normal)
+      glfwWaitEventsTimeout(idle.waitMs(nowMs) / 1000.0);
+      continue;
+    }
+    if (action == IdleAction::Present) {
+      // Expose en idle: escena y bloom del ultimo frame siguen en sus FBO
+      int64_t presentStartNs = monotonicNowNs();
+      idleGpuTimer->begin();
+      combinePass(lastSceneTexture, lastBloomTexture);
+      idleGpuTimer->end();
+      idle.recordCpu(action, (monotonicNowNs() - presentStartNs) / 1e6);
+      glfwSwapBuffers(window);
+      idle.recordGpu(action, idleGpuTimer->elapsedMs());
+      glfwPollEvents();
+      continue;
+    }
+    bool activeFrame = action == IdleAction::Render;
+    // Sin esto el primer frame tras idle mediria toda la pausa
+    if (idle.resumed())
+      pacer->resume();
+
+    // Modo default: se lee antes de esperar, el frame envejece en la cola.
+    // Con lateAudio se lee tras las esperas, justo antes de grabar comandos
+    AudioFrame audio;
+    auto sampleAudio = [&] {
+      audio = audioSource->latest();
+      pacer->audioSampled(audio);
+    };
+    if (!activeFrame) {
+      audio = audioSource->latest();
+      idleGpuTimer->begin();
+    } else {
+      if (!pacer->config().lateAudio)
+        sampleAudio();
+      pacer->beginFrame();
+      if (pacer->config().lateAudio)
+        sampleAudio();
+    }
+    int64_t frameStartNs = monotonicNowNs();
+
+#ifdef NEON_HAS_WALL_SYNC
+    // Pared: el lider fija tiempo, camara y audio del frame y los tiles
+    // dibujan exactamente eso
+    WallFrame wallFrame;
+    if (wall && wallTile == 0) {
+      wallFrame = wallClock.next(audio, cameraDistance, cameraAngleX,
+                                 cameraAngleY);
+      if (!wallSync.publish(wallFrame, WALL_TIMEOUT_MS))
+        break;
+    } else if (wall &&
+               !wallSync.waitFrame(wallFrameIndex + 1, wallFrame,
+                                   WALL_TIMEOUT_MS)) {
+      if (!wallSync.finished())
+        std::cerr << "Tile " << wallTile << ": el lider no responde"
+                  << std::endl;
+      break;
+    }
+    if (wall) {
+      wallFrameIndex = wallFrame.index;
+      audio = wallFrame.audio;
+      cameraDistance = wallFrame.cameraDistance;
+      cameraAngleX = wallFrame.cameraAngleX;
+      cameraAngleY = wallFrame.cameraAngleY;
+    }
+#endif
+
+    // Filas al ritmo de SPECTROGRAM_ROW_NS con el ultimo analisis, sea
+    // cual sea el motor (FFT por bloque o filterbank cada 32 muestras)
+    if (audio.sequence > lastAudioSequence) {
+      size_t fresh =
+          spectrogramClock.advance(audio.timestampNs, spectrogram.rows());
+      for (size_t i = 0; i < fresh; i++)
+        spectrogram.push(audio.spectrum);
+      lastAudioSequence = audio.sequence;
+    }
+    spectrogramTexture->update(spectrogram);
 
-    glUniform1i(passTypeLoc, 1);
+    // Calcular tiempo variable basado en musica
+    float currentFrameTime = (float)glfwGetTime();
+    float deltaTime = currentFrameTime - lastFrameTime;
+    lastFrameTime = currentFrameTime;
 
-    float t = glm::clamp((cameraDistance - 1.0f) / 8.0f, 0.0f, 1.0f);
-    float dynamicBloom = glm::mix(1.0f, 0.5f, t);
-    glUniform1f(bloomStrengthLoc, dynamicBloom);
+    // Speed modulation
+    float audioIntensity = audio.mids + (audio.treble * 0.5f);
+    audioIntensity = std::min(audioIntensity, 0.7f);
+    float speedMultiplier = 1.0f + (audioIntensity * 2.0f);
+    accumulatedTime += deltaTime * speedMultiplier;
+#ifdef NEON_HAS_WALL_SYNC
+    if (wall)
+      accumulatedTime = wallFrame.time; // Paso fijo de WallClock
+#endif
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, sceneColorBuffer);
-    glUniform1i(sceneLoc, 0);
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, pingpongBuffer[1]);
-    glUniform1i(bloomBlurLoc, 1);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    // Audio uniforms
+    bass = audio.bass;
+    mids = audio.mids;
+    treble = audio.treble;
+
+    if (wall) {
+      // Cada tile mide lo que su ventana: la pared es columns x rows de ellas
+      WallLayout layout = wallLayout;
+      layout.width = layout.columns * (int)currentWidth;
+      layout.height = layout.rows * (int)currentHeight;
+      wallCore = wallTileRect(layout, wallTile);
+      wallArea = wallRenderRect(layout, wallTile);
+      projection = toGlm(
+          wallProjection(layout, wallArea, glm::radians(45.0f), 0.1f, 400.0f));
+    } else {
+      wallCore = wallArea = WallRect{0, 0, (int)currentWidth,
+                                     (int)currentHeight};
+      projection = glm::perspective(glm::radians(45.0f),
+                                    (float)currentWidth / (float)currentHeight,
+                                    0.1f, 400.0f);
+    }
+    cachedNebula = !activeFrame && nebulaFBO != 0;
+
+    // === RENDERIZAR FRAME ===
+    FrameGraphSettings frameSettings;
+    frameSettings.width = wallArea.width;
+    frameSettings.height = wallArea.height;
+    frameSettings.splat = renderMode == RenderMode::Splat;
+    frameSettings.stars = starsReady;
+    frameSettings.waves = wavesReady;
+    frameSettings.bloomStrength =
+        bloomScale * bloomStrengthFor(cameraDistance);
+    graph.clear();
+    targets = declareFrameGraph(graph, frameSettings, passes);
+    if (!graph.compile())
+      break;
+    targetPool->sync(graph.slots());
+    passTimer->beginFrame();
+    graph.execute(passTimer.get());
+
+    double frameCpuMs = (monotonicNowNs() - frameStartNs) / 1e6;
+    if (!activeFrame) {
+      idleGpuTimer->end();
+      idle.recordCpu(action, frameCpuMs);
+      glfwSwapBuffers(window);
+      // Bloquea hasta la GPU: en idle no hay otro frame en cola
+      idle.recordGpu(action, idleGpuTimer->elapsedMs());
+    } else {
+      idle.recordCpu(action, frameCpuMs);
+      pacer->endFrame();
+#ifdef NEON_HAS_WALL_SYNC
+      // Swap lock: ningun tile presenta el frame hasta que todos lo tienen
+      if (wall && !wallSync.readyAndWait(wallFrameIndex, WALL_TIMEOUT_MS))
+        break;
+#endif
+      glfwSwapBuffers(window);
+      pacer->afterSwap();
+      // GPU de los frames normales: las queries que el pacer ya recogio
+      const std::vector<double> &gpuMs = pacer->samples().gpuMs;
+      if (gpuMs.size() < gpuSamplesSeen)
+        gpuSamplesSeen = 0; // resetSamples()
+      for (; gpuSamplesSeen < gpuMs.size(); gpuSamplesSeen++)
+        idle.recordGpu(action, gpuMs[gpuSamplesSeen]);
+    }
 
-    glfwSwapBuffers(window);
+    if (!startupReported) {
+      int64_t nowNs = monotonicNowNs();
+      startup.mark("first frame", nowNs);
+      if (audio.sequence != 0)
+        startup.mark("first audio", nowNs);
+      if (startupSteps.done()) {
+        startup.mark("complete", nowNs);
+        std::cout << startup.report();
+        startupReported = true;
+      } else {
+        // Lo que el primer frame no necesitaba, un paso tras cada frame
+        startupSteps.runNext(startup);
+      }
+    }
     glfwPollEvents();
+
+    if (benchPacing && ++benchFrame == benchWarmupFrames) {
+      pacer->resetSamples();
+    } else if (benchPacing &&
+               benchFrame == benchWarmupFrames + benchMeasuredFrames) {
+      std::cout << pacer->report();
+      benchFrame = 0;
+      if (++benchModeIndex == 3)
+        glfwSetWindowShouldClose(window, true);
+      else
+        pacer->configure(window, pacingPreset(benchModes[benchModeIndex]));
+    }
   }
 
-  glDeleteVertexArrays(1, &mainVAO);
-  glDeleteBuffers(1, &mainVBO);
-  glDeleteVertexArrays(1, &nearVAO);
-  glDeleteBuffers(1, &nearVBO);
-  glDeleteVertexArrays(1, &farVAO);
-  glDeleteBuffers(1, &farVBO);
+#ifdef NEON_HAS_WALL_SYNC
+  if (wall && wallTile == 0)
+    wallSync.finish();
+#endif
+  if (!benchPacing)
+    std::cout << pacer->report();
+  if (idle.enabled())
+    std::cout << "Idle: "
+              << formatIdleReport(idle.report(monotonicNowNs() / 1e6));
+  pacer.reset();
+  idleGpuTimer.reset();
+
+  std::cout << "Render graph: " << graph.order().size() << " of "
+            << graph.passCount() << " passes, " << graph.slots().size()
+            << " targets " << formatTargetBytes(graph.transientBytes())
+            << " (unaliased " << formatTargetBytes(graph.unaliasedBytes())
+            << "), " << targetPool->allocations() << " allocations"
+            << std::endl
+            << passTimings.report();
+  passTimer.reset();
+  targetPool.reset();
+  glDeleteTextures(1, &blackTexture);
+
+  Distribution upload = summarize(spectrogramTexture->uploadMicros());
+  std::cout << "Spectrogram: " << spectrogramTexture->rowsUploaded()
+            << " rows, " << spectrogramTexture->fullUploads()
+            << " full uploads, upload us "
+            << (upload.count ? formatDistribution(upload, 1) : "n/a")
+            << std::endl;
+  spectrogramTexture.reset();
+
+  audioSource->stop();
+  CadenceReport cadence;
+  if (audioSource->cadence(cadence))
+    std::cout << "Audio cadence: " << formatCadenceReport(cadence);
+
+  glDeleteVertexArrays(WAVE_LAYER_COUNT, waveVAO);
+  glDeleteBuffers(WAVE_LAYER_COUNT, waveVBO);
   glDeleteProgram(particleShader);
   glDeleteProgram(bloomShader);
   glfwTerminate();
@@ -456,12 +945,16 @@ void processInput(GLFWwindow *window) {
   if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
     glfwSetWindowShouldClose(window, true);
 
+  // Tecla mantenida: sin eventos nuevos, pero la camara se sigue moviendo
+  float previousDistance = cameraDistance;
   if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS ||
       glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
     cameraDistance = glm::max(0.5f, cameraDistance - 0.03f);
   if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS ||
       glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
     cameraDistance = glm::min(10.0f, cameraDistance + 0.03f);
+  if (cameraDistance != previousDistance)
+    inputActivity = true;
 
   double mouseX, mouseY;
   glfwGetCursorPos(window, &mouseX, &mouseY);
@@ -478,67 +971,25 @@ void processInput(GLFWwindow *window) {
   lastMouseY = mouseY;
 }
 
-std::string readFile(const std::string &path) {
-  std::ifstream file(path);
-  if (!file.is_open()) {
-    std::cerr << "Error abriendo: " << path << std::endl;
-    return "";
+void createNebulaCache(unsigned int width, unsigned int height) {
+  if (nebulaFBO != 0) {
+    glDeleteFramebuffers(1, &nebulaFBO);
+    glDeleteTextures(1, &nebulaColorBuffer);
+    nebulaFBO = nebulaColorBuffer = 0;
   }
-  std::stringstream buffer;
-  buffer << file.rdbuf();
-  return buffer.str();
-}
-
-std::vector<float> generateGrid(int size, float spacing) {
-  std::vector<float> vertices;
-  float offset = (size - 1) * spacing / 2.0f;
-  for (int z = 0; z < size; z++) {
-    for (int x = 0; x < size; x++) {
-      vertices.push_back(x * spacing - offset);
-      vertices.push_back(z * spacing - offset);
-    }
-  }
-  return vertices;
-}
+  if (!nebulaCacheEnabled)
+    return;
 
-void createFramebuffers(unsigned int width, unsigned int height) {
-  if (sceneFBO != 0) {
-    glDeleteFramebuffers(1, &sceneFBO);
-    glDeleteTextures(1, &sceneColorBuffer);
-    glDeleteFramebuffers(2, pingpongFBO);
-    glDeleteTextures(2, pingpongBuffer);
-  }
-
-  glGenFramebuffers(1, &sceneFBO);
-  glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
-
-  glGenTextures(1, &sceneColorBuffer);
-  glBindTexture(GL_TEXTURE_2D, sceneColorBuffer);
+  glGenFramebuffers(1, &nebulaFBO);
+  glBindFramebuffer(GL_FRAMEBUFFER, nebulaFBO);
+  glGenTextures(1, &nebulaColorBuffer);
+  glBindTexture(GL_TEXTURE_2D, nebulaColorBuffer);
   glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA,
                GL_FLOAT, nullptr);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
   glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
-                         sceneColorBuffer, 0);
-
-  glGenFramebuffers(2, pingpongFBO);
-  glGenTextures(2, pingpongBuffer);
-
-  for (int i = 0; i < 2; i++) {
-    glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[i]);
-    glBindTexture(GL_TEXTURE_2D, pingpongBuffer[i]);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA,
-                 GL_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
-                           pingpongBuffer[i], 0);
-  }
-
+                         nebulaColorBuffer, 0);
   glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
@@ -560,44 +1011,6 @@ void setupQuad(unsigned int &quadVAO, unsigned int &quadVBO) {
   glEnableVertexAttribArray(1);
 }
 
-unsigned int createShader(const char *vertexCode, const char *fragmentCode) {
-  int success;
-  char infoLog[512];
-
-  unsigned int vs = glCreateShader(GL_VERTEX_SHADER);
-  glShaderSource(vs, 1, &vertexCode, nullptr);
-  glCompileShader(vs);
-  glGetShaderiv(vs, GL_COMPILE_STATUS, &success);
-  if (!success) {
-    glGetShaderInfoLog(vs, 512, nullptr, infoLog);
-    std::cerr << "Vertex shader error: " << infoLog << std::endl;
-  }
-
-  unsigned int fs = glCreateShader(GL_FRAGMENT_SHADER);
-  glShaderSource(fs, 1, &fragmentCode, nullptr);
-  glCompileShader(fs);
-  glGetShaderiv(fs, GL_COMPILE_STATUS, &success);
-  if (!success) {
-    glGetShaderInfoLog(fs, 512, nullptr, infoLog);
-    std::cerr << "Fragment shader error: " << infoLog << std::endl;
-  }
-
-  unsigned int program = glCreateProgram();
-  glAttachShader(program, vs);
-  glAttachShader(program, fs);
-  glLinkProgram(program);
-  glGetProgramiv(program, GL_LINK_STATUS, &success);
-  if (!success) {
-    glGetProgramInfoLog(program, 512, nullptr, infoLog);
-    std::cerr << "Shader link error: " << infoLog << std::endl;
-  }
-
-  glDeleteShader(vs);
-  glDeleteShader(fs);
-
-  return program;
-}
-
 void setupSkybox(unsigned int &skyboxVAO, unsigned int &skyboxVBO) {
   float skyboxVertices[] = {
       // positions
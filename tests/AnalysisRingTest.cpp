@@ -0,0 +1,88 @@
+#include "AnalysisRing.h"
+#include "Test.h"
+
+#include <vector>
+
+namespace {
+
+// Bloque alineado a 64 para la cabecera y los slots
+struct RingMemory {
+  explicit RingMemory(uint32_t capacity)
+      : bytes(AnalysisRing::bytesFor(capacity)),
+        storage((bytes + 63) / 64) {}
+  void *data() { return storage.data(); }
+  size_t bytes;
+  struct alignas(64) Line {
+    unsigned char b[64];
+  };
+  std::vector<Line> storage;
+};
+
+AudioFrame makeFrame(float v) {
+  AudioFrame f;
+  f.timestampNs = (int64_t)(v * 1000);
+  f.bass = v;
+  f.mids = v * 0.5f;
+  f.treble = v * 0.25f;
+  return f;
+}
+
+} // namespace
+
+TEST(ring_empty_until_published) {
+  RingMemory mem(8);
+  CHECK(AnalysisRing::format(mem.data(), mem.bytes, 8));
+  CHECK(AnalysisRing::validate(mem.data(), mem.bytes));
+  AnalysisRingReader reader(mem.data());
+  AudioFrame out;
+  CHECK(reader.latestSequence() == 0);
+  CHECK(!reader.readLatest(out));
+  CHECK(reader.read(1, out) == RingRead::NotYet);
+}
+
+TEST(ring_assigns_sequences_in_order) {
+  RingMemory mem(8);
+  AnalysisRing::format(mem.data(), mem.bytes, 8);
+  AnalysisRingWriter writer(mem.data());
+  AnalysisRingReader reader(mem.data());
+  for (int i = 1; i <= 5; i++)
+    CHECK(writer.publish(makeFrame((float)i)) == (uint64_t)i);
+
+  AudioFrame out;
+  CHECK(reader.readLatest(out));
+  CHECK(out.sequence == 5);
+  CHECK_NEAR(out.bass, 5.0f, 0.0f);
+  CHECK(reader.read(3, out) == RingRead::Ok);
+  CHECK(out.sequence == 3 && out.mids == 1.5f);
+  CHECK(reader.read(6, out) == RingRead::NotYet);
+}
+
+TEST(ring_reports_overwritten_frames) {
+  RingMemory mem(4);
+  AnalysisRing::format(mem.data(), mem.bytes, 4);
+  AnalysisRingWriter writer(mem.data());
+  AnalysisRingReader reader(mem.data());
+  for (int i = 1; i <= 10; i++)
+    writer.publish(makeFrame((float)i));
+
+  AudioFrame out;
+  CHECK(reader.read(6, out) == RingRead::Overwritten);
+  CHECK(reader.read(7, out) == RingRead::Ok);
+  CHECK(out.sequence == 7 && out.bass == 7.0f);
+}
+
+TEST(ring_rejects_bad_layout) {
+  RingMemory mem(4);
+  CHECK(!AnalysisRing::format(mem.data(), mem.bytes - 1, 4));
+  CHECK(!AnalysisRing::validate(mem.data(), mem.bytes)); // Sin formatear
+  AnalysisRing::format(mem.data(), mem.bytes, 4);
+  CHECK(!AnalysisRing::validate(mem.data(), mem.bytes - 64));
+}
+
+TEST(ring_writer_resumes_after_last_sequence) {
+  RingMemory mem(4);
+  AnalysisRing::format(mem.data(), mem.bytes, 4);
+  AnalysisRingWriter(mem.data()).publish(makeFrame(1.0f));
+  AnalysisRingWriter again(mem.data());
+  CHECK(again.publish(makeFrame(2.0f)) == 2);
+}
@@ -0,0 +1,171 @@
+#include "BandAnalyzer.h"
+#include "SignalFixtures.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+// Ruta original (FFT recursiva en double + bandas) para comparar resultados
+static void legacyFFT(std::vector<std::complex<double>> &x) {
+  const double PI = 3.141592653589793238460;
+  const size_t N = x.size();
+  if (N <= 1)
+    return;
+  std::vector<std::complex<double>> even(N / 2), odd(N / 2);
+  for (size_t i = 0; i < N / 2; ++i) {
+    even[i] = x[2 * i];
+    odd[i] = x[2 * i + 1];
+  }
+  legacyFFT(even);
+  legacyFFT(odd);
+  for (size_t k = 0; k < N / 2; ++k) {
+    std::complex<double> t = std::polar(1.0, -2 * PI * k / N) * odd[k];
+    x[k] = even[k] + t;
+    x[k + N / 2] = even[k] - t;
+  }
+}
+
+static BandLevels legacyBands(const float *data, size_t samples) {
+  std::vector<std::complex<double>> c(samples);
+  for (size_t i = 0; i < samples; ++i)
+    c[i] = std::complex<double>(data[i], 0);
+  legacyFFT(c);
+  BandLevels b;
+  for (size_t i = 0; i < samples / 2; ++i) {
+    float magnitude = (float)std::abs(c[i]);
+    if (i > 0 && i <= 5)
+      b.bass += magnitude;
+    else if (i > 5 && i <= 40)
+      b.mids += magnitude;
+    else if (i > 40 && i < 250)
+      b.treble += magnitude;
+  }
+  b.bass = std::min(1.0f, b.bass / 150.0f);
+  b.mids = std::min(1.0f, b.mids / 250.0f);
+  b.treble = std::min(1.0f, b.treble / 400.0f);
+  return b;
+}
+
+TEST(bands_match_legacy_analysis) {
+  const size_t n = BandAnalyzer::BLOCK_SIZE;
+  for (float amp : {0.001f, 0.01f, 0.05f, 0.3f}) {
+    std::vector<float> signal = fixtures::whiteNoise(amp, n);
+    BandLevels ref = legacyBands(signal.data(), n);
+
+    BandAnalyzer analyzer;
+    analyzer.analyzeBlock(signal.data());
+    CHECK_NEAR(analyzer.levels().bass, ref.bass, 1e-4);
+    CHECK_NEAR(analyzer.levels().mids, ref.mids, 1e-4);
+    CHECK_NEAR(analyzer.levels().treble, ref.treble, 1e-4);
+  }
+}
+
+TEST(bands_isolate_synthetic_tones) {
+  const size_t n = BandAnalyzer::BLOCK_SIZE;
+  struct Tone {
+    float freq;
+    int dominant; // 0 bass, 1 mids, 2 treble
+  };
+  for (Tone tone : {Tone{120.0f, 0}, Tone{1000.0f, 1}, Tone{6000.0f, 2}}) {
+    std::vector<float> signal = fixtures::sine(tone.freq, 0.2f, n);
+    BandAnalyzer analyzer;
+    analyzer.analyzeBlock(signal.data());
+    float v[3] = {analyzer.levels().bass, analyzer.levels().mids,
+                  analyzer.levels().treble};
+    for (int b = 0; b < 3; b++) {
+      if (b != tone.dominant)
+        CHECK(v[tone.dominant] > v[b] * 4.0f);
+    }
+  }
+}
+
+TEST(bands_silence_is_zero) {
+  std::vector<float> signal = fixtures::silence(BandAnalyzer::BLOCK_SIZE);
+  BandAnalyzer analyzer;
+  analyzer.analyzeBlock(signal.data());
+  CHECK(analyzer.levels().bass == 0.0f);
+  CHECK(analyzer.levels().mids == 0.0f);
+  CHECK(analyzer.levels().treble == 0.0f);
+}
+
+TEST(smoother_fast_attack_slow_decay) {
+  BandSmoother smoother;
+  smoother.update({0.8f, 0.6f, 0.4f});
+  CHECK_NEAR(smoother.levels().bass, 0.8f, 1e-6);
+
+  smoother.update({0.0f, 0.0f, 0.0f});
+  float keep = 1.0f - BandSmoother::SMOOTHING;
+  CHECK_NEAR(smoother.levels().bass, 0.8f * keep, 1e-6);
+  CHECK_NEAR(smoother.levels().mids, 0.6f * keep, 1e-6);
+  CHECK_NEAR(smoother.levels().treble, 0.4f * keep, 1e-6);
+
+  smoother.decay();
+  CHECK_NEAR(smoother.levels().bass,
+             0.8f * keep * BandSmoother::SILENCE_DECAY, 1e-6);
+}
+
+TEST(analyzer_push_is_chunking_invariant) {
+  const size_t total = BandAnalyzer::BLOCK_SIZE * 5 + 100;
+  std::vector<float> signal = fixtures::whiteNoise(0.1f, total);
+
+  BandAnalyzer whole;
+  CHECK(whole.push(signal.data(), total) == 5);
+
+  // Paquetes de tamaño irregular como los de WASAPI
+  BandAnalyzer chunked;
+  size_t blocks = 0;
+  size_t offset = 0;
+  size_t sizes[] = {480, 7, 1024, 333, 2048, 1};
+  for (size_t i = 0; offset < total; i++) {
+    size_t take = std::min(sizes[i % 6], total - offset);
+    blocks += chunked.push(signal.data() + offset, take);
+    offset += take;
+  }
+  CHECK(blocks == 5);
+  CHECK(whole.levels().bass == chunked.levels().bass);
+  CHECK(whole.levels().mids == chunked.levels().mids);
+  CHECK(whole.levels().treble == chunked.levels().treble);
+}
+
+TEST(downmix_averages_channels) {
+  std::vector<float> mono = fixtures::whiteNoise(1.0f, 256);
+  for (int channels : {1, 2, 6}) {
+    std::vector<float> inter = fixtures::interleave(mono, channels);
+    std::vector<float> out(mono.size());
+    downmixToMono(inter.data(), mono.size(), channels, out.data());
+    for (size_t i = 0; i < mono.size(); i++)
+      CHECK_NEAR(out[i], mono[i], 1e-6);
+  }
+
+  float stereo[] = {1.0f, 0.0f, -0.5f, 0.5f};
+  float out[2];
+  downmixToMono(stereo, 2, 2, out);
+  CHECK_NEAR(out[0], 0.5f, 1e-7);
+  CHECK_NEAR(out[1], 0.0f, 1e-7);
+}
+
+TEST(synthetic_music_stays_in_range) {
+  // 2 s a 48 kHz: cuatro tiempos de bombo y ocho hi-hats
+  const int rate = 48000;
+  std::vector<float> signal(2 * rate);
+  float peak = 0.0f;
+  for (size_t i = 0; i < signal.size(); i++) {
+    signal[i] = syntheticMusicSample(i, rate);
+    peak = std::max(peak, std::fabs(signal[i]));
+  }
+  CHECK(peak <= 1.0f);
+  CHECK(peak > 0.5f);
+
+  // Las bandas se mueven con la musica en vez de quedarse saturadas
+  BandAnalyzer analyzer;
+  float minBass = 1.0f, maxBass = 0.0f;
+  for (size_t offset = 0; offset + BandAnalyzer::BLOCK_SIZE <= signal.size();
+       offset += BandAnalyzer::BLOCK_SIZE) {
+    analyzer.push(signal.data() + offset, BandAnalyzer::BLOCK_SIZE);
+    minBass = std::min(minBass, analyzer.levels().bass);
+    maxBass = std::max(maxBass, analyzer.levels().bass);
+  }
+  CHECK(maxBass > minBass + 0.1f);
+  CHECK(analyzer.levels().treble < 1.0f);
+}
@@ -0,0 +1,107 @@
+#include "CaptureCadence.h"
+#include "RealtimeThread.h"
+#include "Test.h"
+
+#include <thread>
+
+namespace {
+
+constexpr uint64_t MS = 1000000;
+
+// Despertar en 'at' ms y procesar durante 'work' ms
+void packet(CadenceMonitor &monitor, double at, double work) {
+  monitor.wake((uint64_t)(at * MS));
+  monitor.workDone((uint64_t)((at + work) * MS));
+}
+
+} // namespace
+
+TEST(cadence_steady_period_has_no_jitter) {
+  CadenceMonitor monitor(10.0);
+  for (int i = 1; i <= 100; i++)
+    packet(monitor, 10.0 * i, 0.5);
+  CadenceReport r = monitor.report();
+  CHECK(r.wakeups == 100);
+  CHECK(r.late == 0 && r.overruns == 0 && r.timeouts == 0);
+  CHECK(r.intervalMs.count == 99); // El primero no tiene intervalo
+  CHECK(r.workMs.count == 100);
+  CHECK_NEAR(r.intervalMs.mean, 10.0, 1e-6);
+  CHECK_NEAR(r.jitterMs.max, 0.0, 1e-6);
+  CHECK_NEAR(r.workMs.p99, 0.5, 1e-6);
+}
+
+TEST(cadence_counts_late_wakeups_and_overruns) {
+  CadenceMonitor monitor(10.0);
+  packet(monitor, 10.0, 1.0);
+  packet(monitor, 20.0, 1.0);
+  packet(monitor, 34.0, 1.0);  // 14 ms: jitter, aun no es retraso
+  packet(monitor, 50.0, 12.0); // 16 ms > 15: retraso; 12 ms de trabajo
+  packet(monitor, 62.0, 1.0);
+  monitor.discontinuity();
+  CadenceReport r = monitor.report();
+  CHECK(r.late == 1);
+  CHECK(r.overruns == 1);
+  CHECK(r.discontinuities == 1);
+  CHECK_NEAR(r.jitterMs.max, 6.0, 1e-6);
+  CHECK_NEAR(r.intervalMs.min, 10.0, 1e-6);
+  CHECK_NEAR(r.workMs.max, 12.0, 1e-6);
+}
+
+TEST(cadence_timeout_restarts_interval) {
+  // Silencio en loopback: no llegan paquetes y la espera vence. El hueco
+  // no debe contar como despertar tardio.
+  CadenceMonitor monitor(10.0);
+  packet(monitor, 10.0, 0.5);
+  monitor.timeout();
+  monitor.timeout();
+  packet(monitor, 500.0, 0.5);
+  packet(monitor, 510.0, 0.5);
+  CadenceReport r = monitor.report();
+  CHECK(r.timeouts == 2);
+  CHECK(r.late == 0);
+  CHECK(r.intervalMs.count == 1);
+  CHECK_NEAR(r.intervalMs.max, 10.0, 1e-6);
+}
+
+TEST(cadence_window_keeps_recent_samples) {
+  CadenceMonitor monitor(10.0, 16);
+  for (int i = 1; i <= 100; i++)
+    packet(monitor, 10.0 * i, i <= 50 ? 9.0 : 1.0);
+  CadenceReport r = monitor.report();
+  CHECK(r.wakeups == 100); // Contadores de toda la vida
+  CHECK(r.workMs.count == 16);
+  CHECK_NEAR(r.workMs.max, 1.0, 1e-6);
+
+  monitor.reset();
+  CHECK(monitor.report().wakeups == 0);
+  CHECK(monitor.report().workMs.count == 0);
+}
+
+TEST(realtime_policy_names_round_trip) {
+  for (RealtimePolicy policy : {RealtimePolicy::Normal, RealtimePolicy::Fifo,
+                                RealtimePolicy::RoundRobin}) {
+    RealtimePolicy parsed = RealtimePolicy::Normal;
+    CHECK(parseRealtimePolicy(realtimePolicyName(policy), parsed));
+    CHECK(parsed == policy);
+  }
+  RealtimePolicy parsed;
+  CHECK(!parseRealtimePolicy("idle", parsed));
+}
+
+TEST(realtime_scope_reports_failures) {
+  // En un hilo aparte: no tocar la planificacion del runner de tests
+  bool normalOk = false, badCpuOk = true;
+  std::thread([&] {
+    RealtimeOptions normal;
+    normal.mmcss = false;
+    RealtimeScope scope(normal);
+    normalOk = scope.ok() && scope.describe().empty();
+
+    RealtimeOptions badCpu = normal;
+    badCpu.cpu = 100000;
+    RealtimeScope failing(badCpu);
+    badCpuOk = failing.ok();
+  }).join();
+  CHECK(normalOk);
+  CHECK(!badCpuOk);
+}
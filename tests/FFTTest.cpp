@@ -0,0 +1,80 @@
+#include "FFT.h"
+#include "SignalFixtures.h"
+#include "Test.h"
+
+#include <complex>
+#include <stdexcept>
+
+// DFT directa O(N^2) en doble precision como referencia
+static std::vector<std::complex<double>> naiveDFT(const std::vector<float> &x) {
+  const double PI = 3.141592653589793238460;
+  const size_t n = x.size();
+  std::vector<std::complex<double>> out(n);
+  for (size_t k = 0; k < n; k++) {
+    std::complex<double> sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+      sum += (double)x[i] * std::polar(1.0, -2.0 * PI * (double)(k * i) / n);
+    }
+    out[k] = sum;
+  }
+  return out;
+}
+
+TEST(fft_matches_naive_dft) {
+  for (size_t n : {2u, 8u, 64u, 256u, 1024u}) {
+    std::vector<float> signal = fixtures::whiteNoise(1.0f, n, (uint32_t)n);
+    std::vector<std::complex<double>> ref = naiveDFT(signal);
+
+    FFT fft(n);
+    std::vector<std::complex<float>> out(n);
+    fft.forwardReal(signal.data(), out.data());
+    for (size_t k = 0; k < n; k++) {
+      CHECK_NEAR(out[k].real(), ref[k].real(), 1e-3 * n);
+      CHECK_NEAR(out[k].imag(), ref[k].imag(), 1e-3 * n);
+    }
+  }
+}
+
+TEST(fft_complex_and_real_paths_agree) {
+  const size_t n = 512;
+  std::vector<float> signal = fixtures::whiteNoise(0.5f, n);
+  FFT fft(n);
+
+  std::vector<std::complex<float>> viaReal(n);
+  fft.forwardReal(signal.data(), viaReal.data());
+
+  std::vector<std::complex<float>> viaComplex(signal.begin(), signal.end());
+  fft.forward(viaComplex.data());
+
+  for (size_t k = 0; k < n; k++) {
+    CHECK_NEAR(viaReal[k].real(), viaComplex[k].real(), 1e-5);
+    CHECK_NEAR(viaReal[k].imag(), viaComplex[k].imag(), 1e-5);
+  }
+}
+
+TEST(fft_sine_peaks_at_expected_bin) {
+  const size_t n = 1024;
+  // Bin 10 exacto: 10 * 48000 / 1024 Hz
+  float freq = 10.0f * fixtures::SAMPLE_RATE / (float)n;
+  std::vector<float> signal = fixtures::sine(freq, 1.0f, n);
+
+  FFT fft(n);
+  std::vector<std::complex<float>> out(n);
+  fft.forwardReal(signal.data(), out.data());
+
+  CHECK_NEAR(std::abs(out[10]), n / 2.0, 0.5);
+  for (size_t k = 1; k < n / 2; k++) {
+    if (k != 10)
+      CHECK(std::abs(out[k]) < 0.05f);
+  }
+}
+
+TEST(fft_rejects_non_power_of_two) {
+  bool threw = false;
+  try {
+    FFT fft(1000);
+  } catch (const std::invalid_argument &) {
+    threw = true;
+  }
+  CHECK(threw);
+}
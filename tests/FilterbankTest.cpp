@@ -0,0 +1,155 @@
+#include "BandAnalyzer.h"
+#include "FilterbankAnalyzer.h"
+#include "SignalFixtures.h"
+#include "Spectrogram.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+static BandLevels filterbankLevels(const std::vector<float> &signal) {
+  FilterbankAnalyzer analyzer;
+  analyzer.push(signal.data(), signal.size());
+  return analyzer.levels();
+}
+
+TEST(filterbank_isolates_synthetic_tones) {
+  const size_t n = 24000;
+  BandLevels bass = filterbankLevels(fixtures::sine(60.0f, 0.1f, n));
+  CHECK(bass.bass > 0.3f);
+  CHECK(bass.bass > 5.0f * bass.mids && bass.bass > 5.0f * bass.treble);
+
+  BandLevels mids = filterbankLevels(fixtures::sine(600.0f, 0.1f, n));
+  CHECK(mids.mids > 0.3f);
+  CHECK(mids.mids > 3.0f * mids.bass && mids.mids > 3.0f * mids.treble);
+
+  BandLevels treble = filterbankLevels(fixtures::sine(8000.0f, 0.1f, n));
+  CHECK(treble.treble > 0.3f);
+  CHECK(treble.treble > 5.0f * treble.mids);
+  CHECK(treble.bass < 0.01f);
+}
+
+TEST(filterbank_levels_track_fft_on_noise) {
+  // Escala empirica: mismo orden de magnitud que el analisis FFT
+  std::vector<float> noise = fixtures::whiteNoise(0.05f, 48000);
+  BandAnalyzer fft;
+  fft.push(noise.data(), noise.size());
+  BandLevels ref = fft.levels();
+  BandLevels fb = filterbankLevels(noise);
+  CHECK(std::fabs(fb.bass - ref.bass) < 0.3f * ref.bass);
+  CHECK(std::fabs(fb.mids - ref.mids) < 0.3f * ref.mids);
+  CHECK(std::fabs(fb.treble - ref.treble) < 0.3f * ref.treble);
+}
+
+TEST(filterbank_spectrum_tones_land_in_their_band) {
+  for (size_t k : {20u, 35u, 55u}) {
+    FilterbankAnalyzer::Channel ch = FilterbankAnalyzer::channel(k);
+    float center = std::sqrt(ch.loHz * ch.hiHz);
+    std::vector<float> tone = fixtures::sine(center, 0.002f, 24000);
+    FilterbankAnalyzer analyzer;
+    analyzer.push(tone.data(), tone.size());
+    const float *row = analyzer.spectrum();
+    CHECK(std::max_element(row, row + SPECTRUM_BINS) - row == (long)k);
+  }
+}
+
+TEST(filterbank_silence_is_zero_and_decays) {
+  std::vector<float> quiet = fixtures::silence(4800);
+  BandLevels silent = filterbankLevels(quiet);
+  CHECK(silent.bass < 1e-6f && silent.mids < 1e-6f && silent.treble < 1e-6f);
+
+  std::vector<float> tone = fixtures::sine(1000.0f, 0.1f, 4800);
+  FilterbankAnalyzer analyzer;
+  analyzer.push(tone.data(), tone.size());
+  float before = analyzer.levels().mids;
+  analyzer.decaySilence();
+  CHECK_NEAR(analyzer.levels().mids, before * BandSmoother::SILENCE_DECAY,
+             1e-6);
+}
+
+TEST(filterbank_decay_matches_smoothing_time_constant) {
+  // Ataque instantaneo y, al cortar el tono, el mismo decaimiento por
+  // bloque de 1024 muestras que BandSmoother (1 - SMOOTHING)
+  std::vector<float> tone = fixtures::sine(1000.0f, 0.05f, 24000);
+  FilterbankAnalyzer analyzer;
+  analyzer.push(tone.data(), tone.size());
+  float steady = analyzer.levels().mids;
+
+  std::vector<float> quiet = fixtures::silence(BandAnalyzer::BLOCK_SIZE * 4);
+  analyzer.push(quiet.data(), quiet.size());
+  float expected = steady * std::pow(1.0f - BandSmoother::SMOOTHING, 4.0f);
+  CHECK(std::fabs(analyzer.levels().mids - expected) < 0.05f * steady);
+}
+
+TEST(filterbank_push_is_chunking_invariant) {
+  const size_t total = 5000;
+  std::vector<float> signal = fixtures::whiteNoise(0.1f, total);
+
+  FilterbankAnalyzer whole;
+  CHECK(whole.push(signal.data(), total) == total / FilterbankAnalyzer::HOP);
+
+  FilterbankAnalyzer chunked;
+  size_t hops = 0, offset = 0;
+  size_t sizes[] = {480, 7, 1024, 333, 2048, 1};
+  for (size_t i = 0; offset < total; i++) {
+    size_t take = std::min(sizes[i % 6], total - offset);
+    hops += chunked.push(signal.data() + offset, take);
+    offset += take;
+  }
+  CHECK(hops == total / FilterbankAnalyzer::HOP);
+  CHECK(whole.levels().bass == chunked.levels().bass);
+  CHECK(whole.levels().treble == chunked.levels().treble);
+  CHECK(whole.spectrum()[40] == chunked.spectrum()[40]);
+}
+
+TEST(filterbank_onsets_beat_fft_blocks) {
+  // Tono tras silencio, con el inicio a mitad de un bloque FFT
+  for (float freq : {60.0f, 1000.0f, 6000.0f}) {
+    const size_t onset = 12000 + 512;
+    std::vector<float> signal = fixtures::silence(onset);
+    std::vector<float> tone = fixtures::sine(freq, 0.05f, 24000);
+    signal.insert(signal.end(), tone.begin(), tone.end());
+    Band band = freq < 200.0f ? Band::Bass
+                : freq < 2000.0f ? Band::Mids
+                                 : Band::Treble;
+    size_t fb = measureOnsetLatency(AnalysisEngine::Filterbank, signal.data(),
+                                    signal.size(), onset, 32, band);
+    size_t fft = measureOnsetLatency(AnalysisEngine::FFT, signal.data(),
+                                     signal.size(), onset, 32, band);
+    CHECK(fb <= 200); // < 4.2 ms; el bajo a 60 Hz tarda un cuarto de ciclo
+    CHECK(fft >= 512);
+    CHECK(fb < fft);
+  }
+}
+
+TEST(analysis_engine_names_round_trip) {
+  for (AnalysisEngine engine :
+       {AnalysisEngine::FFT, AnalysisEngine::Filterbank}) {
+    AnalysisEngine parsed = AnalysisEngine::FFT;
+    CHECK(parseAnalysisEngine(analysisEngineName(engine), parsed));
+    CHECK(parsed == engine);
+    CHECK(createBandEngine(engine)->updateInterval() ==
+          (engine == AnalysisEngine::FFT ? BandAnalyzer::BLOCK_SIZE
+                                         : FilterbankAnalyzer::HOP));
+  }
+  AnalysisEngine parsed;
+  CHECK(!parseAnalysisEngine("wavelet", parsed));
+}
+
+TEST(spectrogram_clock_advances_in_real_time) {
+  // Un analisis cada 0.67 ms (filterbank): una fila cada ~32 analisis
+  SpectrogramClock clock;
+  const uint64_t start = 1000000000ull;
+  size_t rows = clock.advance(start, SPECTROGRAM_ROWS);
+  CHECK(rows == 1);
+  for (uint64_t t = 666667; t <= 1000000000ull; t += 666667)
+    rows += clock.advance(start + t, SPECTROGRAM_ROWS);
+  CHECK(rows == 1 + 1000000000ull / SPECTROGRAM_ROW_NS);
+
+  // Un frame que llega tarde repite filas; un hueco enorme llena la historia
+  CHECK(clock.advance(start + 1000000000ull + 3 * SPECTROGRAM_ROW_NS,
+                      SPECTROGRAM_ROWS) == 3);
+  CHECK(clock.advance(start + 60000000000ull, SPECTROGRAM_ROWS) ==
+        SPECTROGRAM_ROWS);
+}
@@ -0,0 +1,73 @@
+#include "FramePacing.h"
+#include "Test.h"
+
+TEST(pacing_presets) {
+  PacingConfig def = pacingPreset(PacingMode::Default);
+  CHECK(def.swapInterval == -1 && def.framesInFlight == 0);
+  CHECK(!def.lateAudio && !def.deadlineSleep);
+
+  PacingConfig low = pacingPreset(PacingMode::LowLatency);
+  CHECK(low.swapInterval == 1 && low.framesInFlight == 1);
+  CHECK(low.lateAudio && !low.deadlineSleep);
+
+  PacingConfig deadline = pacingPreset(PacingMode::Deadline);
+  CHECK(deadline.lateAudio && deadline.deadlineSleep);
+}
+
+TEST(pacing_mode_names_round_trip) {
+  for (PacingMode mode :
+       {PacingMode::Default, PacingMode::LowLatency, PacingMode::Deadline}) {
+    PacingMode parsed = PacingMode::Default;
+    CHECK(parsePacingMode(pacingModeName(mode), parsed));
+    CHECK(parsed == mode);
+  }
+  PacingMode parsed;
+  CHECK(!parsePacingMode("fast", parsed));
+}
+
+TEST(pacing_frames_in_flight_clamped) {
+  CHECK(clampFramesInFlight(-2) == 0);
+  CHECK(clampFramesInFlight(0) == 0);
+  CHECK(clampFramesInFlight(2) == 2);
+  CHECK(clampFramesInFlight(8) == MAX_FRAMES_IN_FLIGHT);
+}
+
+TEST(rolling_estimate_keeps_window) {
+  RollingEstimate estimate(10, 90.0);
+  CHECK(estimate.estimate() == 0.0);
+  for (int i = 0; i < 100; i++)
+    estimate.add(i < 90 ? 50.0 : 2.0); // Pico antiguo fuera de la ventana
+  CHECK(estimate.size() == 10);
+  CHECK_NEAR(estimate.estimate(), 2.0, 1e-9);
+}
+
+TEST(deadline_starts_late_enough_to_finish_on_time) {
+  DeadlineScheduler scheduler(16.0, 1.0);
+  for (int i = 0; i < 20; i++) {
+    scheduler.recordCpu(2.0);
+    scheduler.recordGpu(5.0);
+  }
+  // Present en t=100: deadline 116, trabajo 2 + 5 + 1 => empezar en 108
+  CHECK_NEAR(scheduler.sleepMs(100.0, 101.0), 7.0, 1e-9);
+  CHECK_NEAR(scheduler.sleepMs(100.0, 108.0), 0.0, 1e-9);
+  CHECK_NEAR(scheduler.sleepMs(100.0, 112.0), 0.0, 1e-9);
+}
+
+TEST(deadline_never_sleeps_when_over_budget) {
+  DeadlineScheduler scheduler(16.0, 1.0);
+  scheduler.recordCpu(6.0);
+  scheduler.recordGpu(14.0);
+  CHECK(scheduler.sleepMs(100.0, 100.0) == 0.0);
+}
+
+TEST(pacing_report_lists_each_series) {
+  PacingSamples samples;
+  samples.frameMs = {16.6, 16.7, 16.8};
+  samples.latencyMs = {20.0, 22.0};
+  std::string report = formatPacingReport(PacingMode::LowLatency, samples);
+  CHECK(report.find("low-latency  frame") != std::string::npos);
+  CHECK(report.find("latency    mean 21.00") != std::string::npos);
+  CHECK(report.find("audio age  n/a") != std::string::npos);
+  samples.clear();
+  CHECK(samples.frameMs.empty() && samples.latencyMs.empty());
+}
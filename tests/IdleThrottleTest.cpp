@@ -0,0 +1,170 @@
+#include "IdleThrottle.h"
+#include "Test.h"
+
+namespace {
+
+AudioFrame analysis(uint64_t sequence, double atMs, float bass) {
+  AudioFrame frame;
+  frame.sequence = sequence;
+  frame.timestampNs = (int64_t)(atMs * 1e6);
+  frame.bass = bass;
+  return frame;
+}
+
+IdleConfig testConfig() {
+  IdleConfig config;
+  config.idleFps = 5.0; // Un frame idle cada 200 ms
+  config.enterAfterMs = 1000.0;
+  config.activePeriodMs = 10.0;
+  config.nebulaRefreshMs = 500.0;
+  return config;
+}
+
+} // namespace
+
+TEST(idle_enters_after_silence_and_still_input) {
+  IdleThrottle throttle(testConfig());
+  throttle.reset(0.0);
+  uint64_t sequence = 0;
+  double t = 0.0;
+  for (; t < 1000.0; t += 10.0) {
+    throttle.audio(analysis(++sequence, t, 0.0f), t); // Silencio
+    CHECK(throttle.next(t) == IdleAction::Render);
+  }
+  CHECK(!throttle.idle());
+  CHECK(throttle.next(1000.0) == IdleAction::IdleFrame);
+  CHECK(throttle.idle());
+
+  // Entre frames idle se espera, en rodajas de un periodo normal
+  CHECK(throttle.next(1010.0) == IdleAction::Wait);
+  CHECK_NEAR(throttle.waitMs(1010.0), 10.0, 1e-9);
+  CHECK_NEAR(throttle.waitMs(1195.0), 5.0, 1e-9);
+  CHECK(throttle.next(1200.0) == IdleAction::IdleFrame);
+  CHECK(throttle.next(1400.0) == IdleAction::IdleFrame);
+  CHECK(throttle.next(1410.0) == IdleAction::Wait);
+}
+
+TEST(idle_wakes_on_audio_within_one_period) {
+  IdleThrottle throttle(testConfig());
+  throttle.reset(0.0);
+  CHECK(throttle.next(2000.0) == IdleAction::IdleFrame);
+
+  // Analisis repetido o bajo el umbral: sigue en idle
+  throttle.audio(analysis(7, 2005.0, 0.01f), 2010.0);
+  throttle.audio(analysis(7, 2005.0, 0.01f), 2020.0);
+  CHECK(throttle.next(2020.0) == IdleAction::Wait);
+
+  // El bucle despierta cada <= 10 ms y ve el analisis nuevo
+  throttle.audio(analysis(8, 2026.0, 0.4f), 2030.0);
+  CHECK(throttle.next(2030.0) == IdleAction::Render);
+  CHECK(!throttle.idle());
+  IdleReport r = throttle.report(2030.0);
+  CHECK(r.wakes == 1);
+  CHECK_NEAR(r.maxWakeMs, 4.0, 1e-6);
+  CHECK_NEAR(r.idleMs, 30.0, 1e-9);
+  CHECK_NEAR(r.activeMs, 2000.0, 1e-9);
+
+  // El silencio tiene que durar enterAfterMs otra vez
+  CHECK(throttle.next(2500.0) == IdleAction::Render);
+  CHECK(throttle.next(3030.0) == IdleAction::IdleFrame);
+}
+
+TEST(idle_wakes_on_input_and_presents_cached_frames) {
+  IdleThrottle throttle(testConfig());
+  throttle.reset(0.0);
+  throttle.requestPresent(); // Fuera de idle lo cubre el frame completo
+  CHECK(throttle.next(10.0) == IdleAction::Render);
+  CHECK(throttle.next(1010.0) == IdleAction::IdleFrame);
+  CHECK(throttle.next(1020.0) == IdleAction::Wait);
+
+  // Expose en idle: solo combine con escena y bloom cacheados
+  throttle.requestPresent();
+  CHECK(throttle.next(1030.0) == IdleAction::Present);
+  CHECK(throttle.next(1040.0) == IdleAction::Wait);
+
+  throttle.input(1045.0);
+  CHECK(throttle.next(1050.0) == IdleAction::Render);
+  IdleReport r = throttle.report(1050.0);
+  CHECK(r.presents == 1);
+  CHECK(r.idleFrames == 1);
+  CHECK_NEAR(r.maxWakeMs, 5.0, 1e-9);
+}
+
+TEST(idle_nebula_cache_refresh_cadence) {
+  IdleThrottle throttle(testConfig());
+  throttle.reset(0.0);
+  int redraws = 0;
+  for (double t = 1000.0; t < 2000.0; t += 10.0) {
+    if (throttle.next(t) == IdleAction::IdleFrame && throttle.refreshNebula(t))
+      redraws++;
+  }
+  // Frames idle en 1000, 1200, ..., 1800: redibuja en 1000 y 1600
+  CHECK(redraws == 2);
+  CHECK(throttle.report(2000.0).nebulaReuses == 3);
+
+  // Al despertar la cache deja de valer
+  throttle.input(2000.0);
+  CHECK(throttle.next(2000.0) == IdleAction::Render);
+  CHECK(throttle.next(3000.0) == IdleAction::IdleFrame);
+  CHECK(throttle.refreshNebula(3000.0));
+  throttle.invalidateCache();
+  CHECK(throttle.refreshNebula(3010.0));
+}
+
+TEST(idle_report_estimates_time_saved) {
+  IdleThrottle throttle(testConfig());
+  throttle.reset(0.0);
+  // 100 frames a ritmo normal en 1 s: 4 ms de CPU y 6 de GPU cada uno
+  for (int i = 0; i < 100; i++) {
+    CHECK(throttle.next(i * 10.0) == IdleAction::Render);
+    throttle.recordCpu(IdleAction::Render, 4.0);
+    throttle.recordGpu(IdleAction::Render, 6.0);
+  }
+  // 1 s en idle: 5 frames de 3 ms CPU / 5 ms GPU
+  for (double t = 1000.0; t < 2000.0; t += 10.0) {
+    IdleAction action = throttle.next(t);
+    if (action == IdleAction::IdleFrame) {
+      throttle.recordCpu(action, 3.0);
+      throttle.recordGpu(action, 5.0);
+    }
+  }
+  IdleReport r = throttle.report(2000.0);
+  CHECK(r.idleFrames == 5);
+  CHECK(r.gpuMeasured);
+  CHECK_NEAR(r.idleMs, 1000.0, 1e-9);
+  // 100 frames no dibujados (4 ms, 6 ms) menos los 5 frames idle
+  CHECK_NEAR(r.savedCpuMs, 100 * 4.0 - 5 * 3.0, 1e-6);
+  CHECK_NEAR(r.savedGpuMs, 100 * 6.0 - 5 * 5.0, 1e-6);
+  CHECK(!formatIdleReport(r).empty());
+}
+
+TEST(idle_disabled_always_renders) {
+  IdleConfig config = testConfig();
+  config.idleFps = 0.0;
+  IdleThrottle throttle(config);
+  throttle.reset(0.0);
+  CHECK(!throttle.enabled());
+  CHECK(throttle.next(60000.0) == IdleAction::Render);
+  CHECK(!throttle.idle());
+  CHECK_NEAR(throttle.waitMs(60000.0), 0.0, 1e-9);
+}
+
+TEST(idle_flags_first_render_after_pause) {
+  IdleThrottle throttle(testConfig());
+  throttle.reset(0.0);
+  CHECK(throttle.next(10.0) == IdleAction::Render);
+  CHECK(!throttle.resumed()); // Arranque: el pacer aun no tiene present
+
+  CHECK(throttle.next(2000.0) == IdleAction::IdleFrame);
+  CHECK(!throttle.resumed());
+  throttle.requestPresent();
+  CHECK(throttle.next(2010.0) == IdleAction::Present);
+  CHECK(throttle.next(2020.0) == IdleAction::Wait);
+
+  // Solo el primer Render tras la pausa descarta su present a present
+  throttle.input(2030.0);
+  CHECK(throttle.next(2030.0) == IdleAction::Render);
+  CHECK(throttle.resumed());
+  CHECK(throttle.next(2040.0) == IdleAction::Render);
+  CHECK(!throttle.resumed());
+}
@@ -0,0 +1,217 @@
+#include "FrameGraph.h"
+#include "RenderGraph.h"
+#include "Test.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t HDR_720P = (size_t)1280 * 720 * 8; // RGBA16F
+
+TargetDesc desc(int width, int height) {
+  TargetDesc d;
+  d.width = width;
+  d.height = height;
+  return d;
+}
+
+class RecordingProfiler : public PassProfiler {
+public:
+  void beginPass(size_t, const std::string &name) override {
+    events.push_back("+" + name);
+  }
+  void endPass(size_t, const std::string &name) override {
+    events.push_back("-" + name);
+  }
+  std::vector<std::string> events;
+};
+
+} // namespace
+
+TEST(frame_graph_order_and_footprint_with_bloom) {
+  RenderGraph graph;
+  FrameGraphTargets targets =
+      declareFrameGraph(graph, FrameGraphSettings(), FrameGraphCallbacks());
+  CHECK(graph.compile());
+  std::vector<std::string> expected = {
+      "nebula",  "stars",   "waves_far", "waves_main", "waves_near",
+      "blur_h0", "blur_v0", "blur_h1",   "blur_v1",    "blur_h2",
+      "blur_v2", "blur_h3", "blur_v3",   "combine"};
+  CHECK(graph.orderNames() == expected);
+
+  // Escena y ping-pong vivos a la vez en el ultimo blur: nada que compartir
+  CHECK(graph.slots().size() == 3);
+  CHECK(graph.transientBytes() == 3 * HDR_720P);
+  CHECK(graph.unaliasedBytes() == 3 * HDR_720P);
+  CHECK(targets.bloomResult == targets.bloom[1]);
+  CHECK(graph.available(targets.bloomResult));
+  CHECK(graph.slot(targets.scene) != graph.slot(targets.bloomResult));
+}
+
+TEST(frame_graph_culls_bloom_at_zero_strength) {
+  RenderGraph graph;
+  FrameGraphSettings settings;
+  settings.bloomStrength = 0.0f;
+  FrameGraphTargets targets =
+      declareFrameGraph(graph, settings, FrameGraphCallbacks());
+  CHECK(graph.compile());
+  std::vector<std::string> expected = {"nebula", "stars", "waves_far",
+                                       "waves_main", "waves_near", "combine"};
+  CHECK(graph.orderNames() == expected);
+  // El ping-pong no se reserva y combine lee un valor neutro
+  CHECK(graph.slots().size() == 1);
+  CHECK(graph.transientBytes() == HDR_720P);
+  CHECK(!graph.available(targets.bloomResult));
+  CHECK(graph.slot(targets.bloom[0]) == -1);
+}
+
+TEST(frame_graph_splat_is_one_pass) {
+  RenderGraph graph;
+  FrameGraphSettings settings;
+  settings.splat = true;
+  settings.width = 1920;
+  settings.height = 1080;
+  declareFrameGraph(graph, settings, FrameGraphCallbacks());
+  CHECK(graph.compile());
+  CHECK(graph.order().size() == 1 + 1 + 1 + 8 + 1);
+  CHECK(graph.orderNames()[2] == "waves_splat");
+  CHECK(graph.transientBytes() == 3 * (size_t)1920 * 1080 * 8);
+}
+
+TEST(render_graph_aliases_disjoint_lifetimes) {
+  // a -> b -> c -> salida: a muere antes de que nazca c
+  RenderGraph graph;
+  ResourceHandle a = graph.createTarget("a", desc(64, 64));
+  ResourceHandle b = graph.createTarget("b", desc(64, 64));
+  ResourceHandle c = graph.createTarget("c", desc(64, 64));
+  ResourceHandle small = graph.createTarget("small", desc(32, 32));
+  ResourceHandle out = graph.importTarget("out", true);
+
+  size_t p0 = graph.addPass("make_a", nullptr);
+  graph.write(p0, a);
+  size_t p1 = graph.addPass("a_to_b", nullptr);
+  graph.read(p1, a);
+  graph.write(p1, b);
+  size_t p2 = graph.addPass("b_to_c", nullptr);
+  graph.read(p2, b);
+  graph.write(p2, c);
+  // Otro tamaño: no puede ocupar la memoria de a aunque este libre
+  size_t p3 = graph.addPass("c_to_small", nullptr);
+  graph.read(p3, c);
+  graph.write(p3, small);
+  size_t p4 = graph.addPass("present", nullptr);
+  graph.read(p4, small);
+  graph.write(p4, out);
+
+  CHECK(graph.compile());
+  CHECK(graph.order().size() == 5);
+  CHECK(graph.slot(a) == graph.slot(c));
+  CHECK(graph.slot(a) != graph.slot(b));
+  CHECK(graph.slot(small) != graph.slot(a));
+  CHECK(graph.slots().size() == 3);
+  CHECK(graph.transientBytes() == 2 * 64 * 64 * 8 + 32 * 32 * 8);
+  CHECK(graph.unaliasedBytes() == 3 * 64 * 64 * 8 + 32 * 32 * 8);
+}
+
+TEST(render_graph_culls_unused_outputs) {
+  RenderGraph graph;
+  ResourceHandle color = graph.createTarget("color", desc(16, 16));
+  ResourceHandle debug = graph.createTarget("debug", desc(16, 16));
+  ResourceHandle debugInput = graph.createTarget("debug_in", desc(16, 16));
+  ResourceHandle out = graph.importTarget("out", true);
+
+  size_t draw = graph.addPass("draw", nullptr);
+  graph.write(draw, color);
+  // Solo alimenta a 'debug_view', que nadie lee
+  size_t feed = graph.addPass("feed", nullptr);
+  graph.write(feed, debugInput);
+  size_t view = graph.addPass("debug_view", nullptr);
+  graph.read(view, debugInput);
+  graph.read(view, color);
+  graph.write(view, debug);
+  size_t present = graph.addPass("present", nullptr);
+  graph.read(present, color);
+  graph.write(present, out);
+
+  CHECK(graph.compile());
+  CHECK(graph.live(draw) && graph.live(present));
+  CHECK(!graph.live(feed) && !graph.live(view));
+  CHECK(graph.slot(debug) == -1 && graph.slot(debugInput) == -1);
+  CHECK(graph.slots().size() == 1);
+}
+
+TEST(render_graph_rejects_read_before_write) {
+  RenderGraph graph;
+  ResourceHandle color = graph.createTarget("color", desc(16, 16));
+  ResourceHandle out = graph.importTarget("out", true);
+  size_t early = graph.addPass("early", nullptr);
+  graph.read(early, color);
+  graph.write(early, out);
+  size_t late = graph.addPass("late", nullptr);
+  graph.read(late, out);
+  graph.write(late, color);
+  size_t present = graph.addPass("present", nullptr);
+  graph.read(present, color);
+  graph.write(present, out);
+  CHECK(!graph.compile());
+}
+
+TEST(render_graph_profiles_live_passes_in_order) {
+  RenderGraph graph;
+  std::vector<std::string> ran;
+  FrameGraphCallbacks callbacks;
+  callbacks.nebula = [&] { ran.push_back("nebula"); };
+  callbacks.stars = [&] { ran.push_back("stars"); };
+  callbacks.waves = [&](size_t layer) {
+    ran.push_back("waves" + std::to_string(layer));
+  };
+  callbacks.blur = [&](ResourceHandle, ResourceHandle, bool) {
+    ran.push_back("blur");
+  };
+  callbacks.combine = [&] { ran.push_back("combine"); };
+  FrameGraphSettings settings;
+  settings.bloomStrength = 0.0f;
+  declareFrameGraph(graph, settings, callbacks);
+  CHECK(graph.compile());
+
+  RecordingProfiler profiler;
+  graph.execute(&profiler);
+  std::vector<std::string> expected = {"nebula", "stars", "waves0",
+                                       "waves1", "waves2", "combine"};
+  CHECK(ran == expected);
+  CHECK(profiler.events.size() == 12);
+  CHECK(profiler.events.front() == "+nebula");
+  CHECK(profiler.events.back() == "-combine");
+
+  PassTimings timings(4);
+  for (int i = 0; i < 10; i++) {
+    timings.addCpu("nebula", i < 6 ? 100.0 : 1.0);
+    timings.addGpu("nebula", 2.0);
+  }
+  std::string report = timings.report();
+  CHECK(report.find("nebula") != std::string::npos);
+  CHECK(report.find("cpu mean 1.000") != std::string::npos);
+  CHECK(report.find("(4 frames)") != std::string::npos);
+}
+
+TEST(frame_graph_skips_passes_still_loading) {
+  // Primer frame del arranque: solo nebulosa y combine
+  RenderGraph graph;
+  FrameGraphSettings settings;
+  settings.stars = false;
+  settings.waves = false;
+  declareFrameGraph(graph, settings, FrameGraphCallbacks());
+  CHECK(graph.compile());
+  CHECK(graph.orderNames().size() == 1 + 8 + 1);
+  CHECK(graph.orderNames().front() == "nebula");
+
+  settings.stars = true;
+  settings.splat = true;
+  graph.clear();
+  declareFrameGraph(graph, settings, FrameGraphCallbacks());
+  CHECK(graph.compile());
+  std::vector<std::string> names = graph.orderNames();
+  CHECK(names[1] == "stars");
+  CHECK(names[2] == "blur_h0");
+}
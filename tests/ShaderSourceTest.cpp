@@ -0,0 +1,34 @@
+#include "ShaderSource.h"
+#include "Test.h"
+
+#include <map>
+
+TEST(shader_include_expands_once) {
+  std::map<std::string, std::string> files = {
+      {"common.glsl", "const float A = 1.0;\n"},
+      {"wave.glsl", "#include \"common.glsl\"\nfloat wave() { return A; }\n"},
+  };
+  auto loader = [&files](const std::string &name) { return files[name]; };
+
+  std::string src = "#version 450 core\n"
+                    "#include \"wave.glsl\"\n"
+                    "  #include \"common.glsl\"\n"
+                    "void main() {}\n";
+  std::string out = expandIncludes(src, loader);
+  CHECK(out == "#version 450 core\n"
+               "const float A = 1.0;\n"
+               "float wave() { return A; }\n"
+               "void main() {}\n");
+}
+
+TEST(shader_without_includes_is_unchanged) {
+  std::string src = "#version 450 core\nvoid main() {}\n";
+  CHECK(expandIncludes(src, [](const std::string &) { return "x"; }) == src);
+}
+
+TEST(shader_missing_include_expands_to_nothing) {
+  std::string out =
+      expandIncludes("a\n#include \"missing.glsl\"\nb\n",
+                     [](const std::string &) { return std::string(); });
+  CHECK(out == "a\nb\n");
+}
@@ -0,0 +1,43 @@
+#include "SignalFixtures.h"
+
+#include <cmath>
+
+namespace fixtures {
+
+std::vector<float> sine(float frequency, float amplitude, size_t samples) {
+  const double PI = 3.141592653589793238460;
+  std::vector<float> out(samples);
+  for (size_t i = 0; i < samples; i++) {
+    out[i] = amplitude *
+             (float)std::sin(2.0 * PI * frequency * (double)i / SAMPLE_RATE);
+  }
+  return out;
+}
+
+std::vector<float> silence(size_t samples) {
+  return std::vector<float>(samples, 0.0f);
+}
+
+std::vector<float> whiteNoise(float amplitude, size_t samples,
+                              uint32_t seed) {
+  std::vector<float> out(samples);
+  uint32_t state = seed;
+  for (size_t i = 0; i < samples; i++) {
+    state = state * 1664525u + 1013904223u;
+    float unit = (float)(state >> 8) / (float)(1u << 24); // [0, 1)
+    out[i] = (unit * 2.0f - 1.0f) * amplitude;
+  }
+  return out;
+}
+
+std::vector<float> interleave(const std::vector<float> &mono, int channels) {
+  std::vector<float> out(mono.size() * channels);
+  for (size_t i = 0; i < mono.size(); i++) {
+    for (int c = 0; c < channels; c++) {
+      out[i * channels + c] = mono[i];
+    }
+  }
+  return out;
+}
+
+} // namespace fixtures
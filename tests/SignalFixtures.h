@@ -0,0 +1,23 @@
+#pragma once
+/*
+ * SignalFixtures - Señales sinteticas para tests y benchmarks
+ * Todas a SAMPLE_RATE (48kHz, como el mix format tipico de WASAPI)
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fixtures {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+
+std::vector<float> sine(float frequency, float amplitude, size_t samples);
+std::vector<float> silence(size_t samples);
+// Ruido blanco determinista (LCG) en [-amplitude, amplitude]
+std::vector<float> whiteNoise(float amplitude, size_t samples,
+                              uint32_t seed = 1234);
+// Intercala la misma señal en 'channels' canales
+std::vector<float> interleave(const std::vector<float> &mono, int channels);
+
+} // namespace fixtures
@@ -0,0 +1,248 @@
+#include "ImageIO.h"
+#include "PostProcess.h"
+#include "SignalFixtures.h"
+#include "SoftBloom.h"
+#include "SoftRenderer.h"
+#include "Test.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+FloatImage randomImage(int width, int height, uint32_t seed) {
+  FloatImage image;
+  image.resize(width, height);
+  std::vector<float> r =
+      fixtures::whiteNoise(1.0f, image.pixels.size(), seed);
+  for (size_t i = 0; i < r.size(); i++)
+    image.pixels[i] = std::fabs(r[i]) * 4.0f;
+  return image;
+}
+
+// Transcripcion literal de la pasada de blur de bloom.frag en double
+std::vector<double> referenceBlur(const FloatImage &src, bool horizontal) {
+  std::vector<double> out(src.pixels.size());
+  for (int y = 0; y < src.height; y++) {
+    for (int x = 0; x < src.width; x++) {
+      for (int c = 0; c < 4; c++) {
+        auto at = [&](int dx, int dy) {
+          int sx = std::min(std::max(x + dx, 0), src.width - 1);
+          int sy = std::min(std::max(y + dy, 0), src.height - 1);
+          return (double)src.row(sy)[sx * 4 + c];
+        };
+        double sum = at(0, 0) * BLOOM_WEIGHTS[0];
+        for (int i = 1; i < BLOOM_TAPS; i++) {
+          sum += (horizontal ? at(i, 0) + at(-i, 0) : at(0, i) + at(0, -i)) *
+                 BLOOM_WEIGHTS[i];
+        }
+        out[((size_t)y * src.width + x) * 4 + c] = sum;
+      }
+    }
+  }
+  return out;
+}
+
+struct DiffStats {
+  double meanAbs = 0.0;
+  int maxAbs = 0;
+  size_t over = 0; // Canales con diferencia > 8 niveles
+};
+
+DiffStats diffImages(const std::vector<uint8_t> &a,
+                     const std::vector<uint8_t> &b) {
+  DiffStats d;
+  for (size_t i = 0; i < a.size(); i++) {
+    int diff = std::abs((int)a[i] - (int)b[i]);
+    d.meanAbs += diff;
+    d.maxAbs = std::max(d.maxAbs, diff);
+    if (diff > 8)
+      d.over++;
+  }
+  d.meanAbs /= (double)a.size();
+  return d;
+}
+
+// Escenas de referencia: la de RenderBench y una en silencio girada
+SoftFrame loudFrame() {
+  SoftFrame frame;
+  frame.time = 10.0f;
+  frame.bass = 0.5f;
+  frame.mids = 0.3f;
+  frame.treble = 0.4f;
+  return frame;
+}
+
+SoftFrame quietFrame() {
+  SoftFrame frame;
+  frame.time = 3.0f;
+  frame.cameraDistance = 7.0f;
+  frame.cameraAngleX = 0.3f;
+  frame.cameraAngleY = 0.8f;
+  return frame;
+}
+
+constexpr int REF_WIDTH = 240;
+constexpr int REF_HEIGHT = 135;
+
+} // namespace
+
+TEST(thread_pool_visits_every_index_once) {
+  ThreadPool pool(4);
+  CHECK(pool.size() == 4);
+  std::vector<std::atomic<int>> visits(1000);
+  for (int round = 0; round < 3; round++) {
+    pool.parallelFor(visits.size(), 7, [&](size_t b, size_t e) {
+      for (size_t i = b; i < e; i++)
+        visits[i]++;
+    });
+  }
+  bool allThree = true;
+  for (const std::atomic<int> &v : visits)
+    allThree = allThree && v.load() == 3;
+  CHECK(allThree);
+}
+
+TEST(soft_blur_matches_shader_reference) {
+  ThreadPool pool(3);
+  FloatImage src = randomImage(37, 23, 5);
+  for (bool horizontal : {true, false}) {
+    FloatImage dst;
+    blurPass(src, dst, horizontal, pool);
+    std::vector<double> expected = referenceBlur(src, horizontal);
+    double maxErr = 0.0;
+    for (size_t i = 0; i < expected.size(); i++)
+      maxErr = std::max(maxErr, std::fabs(dst.pixels[i] - expected[i]));
+    CHECK(maxErr < 1e-5);
+  }
+
+  // Los pesos suman 1: una imagen constante no cambia (bordes incluidos)
+  FloatImage flat;
+  flat.resize(9, 9);
+  std::fill(flat.pixels.begin(), flat.pixels.end(), 2.0f);
+  FloatImage ping, pong;
+  bloomBlur(flat, ping, pong, pool);
+  CHECK_NEAR(pong.row(0)[0], 2.0, 1e-5);
+  CHECK_NEAR(pong.row(4)[4 * 4 + 2], 2.0, 1e-5);
+}
+
+TEST(soft_combine_matches_bloom_shader) {
+  // Negro: exp(0) = 1 -> 0
+  float black[3] = {0, 0, 0}, out[3];
+  combinePixel(black, black, 1.0f, out);
+  CHECK(out[0] == 0.0f && out[1] == 0.0f && out[2] == 0.0f);
+
+  // Gris: la saturacion no cambia un gris; 1 - exp(-0.7 * (1 + 0.5))
+  float grey[3] = {1, 1, 1};
+  combinePixel(grey, grey, 0.5f, out);
+  double mapped = 1.0 - std::exp(-1.5 * 0.7);
+  CHECK_NEAR(out[1], std::pow(mapped, 1.0 / 2.2), 1e-5);
+
+  // Rojo puro: saturacion 1.3 saca verde y azul por debajo de 0 -> clamp
+  float red[3] = {3, 0, 0};
+  combinePixel(red, black, 1.0f, out);
+  double r = 1.0 - std::exp(-3.0 * 0.7);
+  double lum = r * 0.299;
+  CHECK_NEAR(out[0], std::pow(std::min(lum + (r - lum) * 1.3, 1.0), 1 / 2.2),
+             1e-5);
+  CHECK(out[1] == 0.0f && out[2] == 0.0f);
+
+  CHECK(toUnorm8(1.0f) == 255 && toUnorm8(-1.0f) == 0);
+  CHECK(toUnorm8(0.5f) == 128);
+  CHECK_NEAR(bloomStrengthFor(2.5f), 0.90625, 1e-6);
+
+  // La tabla de gamma da el mismo byte que pow + redondeo
+  GammaEncoder encode;
+  int mismatched = 0;
+  for (int i = 0; i <= 100000; i++) {
+    float linear = (float)i / 100000.0f;
+    int exact = toUnorm8(std::pow(linear, 1.0f / 2.2f));
+    int fast = encode(linear);
+    CHECK(std::abs(exact - fast) <= 1);
+    mismatched += exact != fast;
+  }
+  CHECK(mismatched < 10);
+  CHECK(encode(0.0f) == 0 && encode(1.0f) == 255 && encode(7.0f) == 255);
+  CHECK_NEAR(bloomStrengthFor(20.0f), 0.5, 1e-6);
+}
+
+TEST(soft_render_is_thread_count_invariant) {
+  SoftRenderer single(96, 54, 1);
+  SoftRenderer threaded(96, 54, 3);
+  single.setNebulaScale(2);
+  threaded.setNebulaScale(2);
+  for (const SoftFrame &frame : {loudFrame(), quietFrame()}) {
+    single.render(frame);
+    threaded.render(frame);
+    CHECK(single.hdr().pixels == threaded.hdr().pixels);
+    CHECK(single.image() == threaded.image());
+  }
+  CHECK(single.splatCount() == 4 * 4900 + 100 * 100 + 200 * 200 + 300 * 300);
+}
+
+TEST(soft_render_matches_reference_frames) {
+  struct Reference {
+    const char *name;
+    SoftFrame frame;
+  };
+  SoftRenderer renderer(REF_WIDTH, REF_HEIGHT, 2);
+  for (const Reference &ref : {Reference{"soft_loud", loudFrame()},
+                               Reference{"soft_quiet", quietFrame()}}) {
+    renderer.render(ref.frame);
+
+    int width = 0, height = 0;
+    std::vector<uint8_t> expected;
+    std::string path = std::string(NEON_TEST_DATA_DIR) + "/" + ref.name +
+                       ".ppm";
+    bool matches = readPPM(path, width, height, expected) &&
+                   width == REF_WIDTH && height == REF_HEIGHT;
+
+    // Tolerancia para sin/exp de otra libm (hash de estrellas, nebulosa)
+    DiffStats d;
+    if (matches) {
+      d = diffImages(renderer.image(), expected);
+      matches = d.meanAbs < 0.5 && d.over <= expected.size() / 200;
+    }
+    CHECK(matches);
+    if (!matches) {
+      // Para inspeccionar o regenerar la referencia
+      std::string actual = std::string(ref.name) + ".actual.ppm";
+      writePPM(actual, REF_WIDTH, REF_HEIGHT, renderer.image());
+      std::cerr << ref.name << ": mean " << d.meanAbs << " max " << d.maxAbs
+                << " over " << d.over << ", wrote " << actual << std::endl;
+    }
+  }
+}
+
+TEST(soft_render_nebula_scale_stays_close_to_exact) {
+  // Nebulosa interpolada desde 1/4 de las muestras vs exacta por pixel
+  SoftRenderer exact(REF_WIDTH, REF_HEIGHT, 2);
+  SoftRenderer coarse(REF_WIDTH, REF_HEIGHT, 2);
+  coarse.setNebulaScale(2);
+  for (const SoftFrame &frame : {loudFrame(), quietFrame()}) {
+    exact.render(frame);
+    coarse.render(frame);
+    DiffStats d = diffImages(exact.image(), coarse.image());
+    CHECK(d.meanAbs < 1.0);
+  }
+}
+
+TEST(ppm_round_trip) {
+  std::vector<uint8_t> rgb(5 * 3 * 3);
+  for (size_t i = 0; i < rgb.size(); i++)
+    rgb[i] = (uint8_t)(i * 37);
+  // Primer byte = '\n' (10): no debe confundirse con la cabecera
+  rgb[0] = 10;
+  CHECK(writePPM("ppm_round_trip.ppm", 5, 3, rgb));
+  int width = 0, height = 0;
+  std::vector<uint8_t> back;
+  CHECK(readPPM("ppm_round_trip.ppm", width, height, back));
+  CHECK(width == 5 && height == 3 && back == rgb);
+  std::remove("ppm_round_trip.ppm");
+}
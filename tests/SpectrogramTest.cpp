@@ -0,0 +1,82 @@
+#include "BandAnalyzer.h"
+#include "SignalFixtures.h"
+#include "Spectrogram.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Bin del espectrograma que contiene el bin FFT de una frecuencia
+static size_t spectrumBinFor(float frequency) {
+  float fftBin = frequency / (fixtures::SAMPLE_RATE / 1024.0f);
+  return (size_t)(std::log(fftBin) / std::log(250.0f) * SPECTRUM_BINS);
+}
+
+TEST(spectrogram_ring_wraps_by_age) {
+  SpectrogramHistory history(4, 3);
+  float rows[5][4];
+  for (int r = 0; r < 5; r++) {
+    for (int b = 0; b < 4; b++)
+      rows[r][b] = (float)(r * 10 + b);
+    history.push(rows[r]);
+  }
+  CHECK(history.pushes() == 5);
+  CHECK(history.head() == 1); // 0,1,2,0,1
+  CHECK(history.sample(0, 2) == 42.0f);
+  CHECK(history.sample(1, 0) == 30.0f);
+  CHECK(history.sample(2, 3) == 23.0f);
+  CHECK(history.rowForAge(3) == history.head()); // Da la vuelta
+
+  // La fila escrita queda en su sitio dentro de data() (layout de textura)
+  const float *texel = history.data().data() + history.head() * 4;
+  CHECK(texel[1] == 41.0f);
+}
+
+TEST(spectrogram_starts_empty) {
+  SpectrogramHistory history;
+  CHECK(history.bins() == SPECTRUM_BINS);
+  CHECK(history.rows() == SPECTROGRAM_ROWS);
+  CHECK(history.data().size() == SPECTRUM_BINS * SPECTROGRAM_ROWS);
+  CHECK(*std::max_element(history.data().begin(), history.data().end()) ==
+        0.0f);
+}
+
+TEST(spectrum_tones_land_in_their_bin) {
+  for (float freq : {120.0f, 1000.0f, 6000.0f}) {
+    std::vector<float> signal =
+        fixtures::sine(freq, 0.2f, BandAnalyzer::BLOCK_SIZE);
+    BandAnalyzer analyzer;
+    analyzer.analyzeBlock(signal.data());
+    const float *row = analyzer.spectrum();
+    size_t peak = (size_t)(std::max_element(row, row + SPECTRUM_BINS) - row);
+    size_t expected = spectrumBinFor(freq);
+    CHECK(peak + 2 >= expected && peak <= expected + 2);
+    CHECK(row[peak] > 0.1f);
+  }
+}
+
+TEST(spectrum_silence_is_zero) {
+  std::vector<float> mags(512, 0.0f);
+  float row[SPECTRUM_BINS];
+  measureSpectrum(mags.data(), mags.size(), row);
+  for (float v : row)
+    CHECK(v == 0.0f);
+}
+
+TEST(spectrum_keeps_attack_decay_semantics) {
+  std::vector<float> tone =
+      fixtures::sine(1000.0f, 0.2f, BandAnalyzer::BLOCK_SIZE);
+  std::vector<float> quiet = fixtures::silence(BandAnalyzer::BLOCK_SIZE);
+  BandAnalyzer analyzer;
+  analyzer.analyzeBlock(tone.data());
+  size_t bin = spectrumBinFor(1000.0f);
+  float peak = analyzer.spectrum()[bin];
+
+  analyzer.analyzeBlock(quiet.data());
+  float keep = 1.0f - BandSmoother::SMOOTHING;
+  CHECK_NEAR(analyzer.spectrum()[bin], peak * keep, 1e-6);
+
+  analyzer.decaySilence();
+  CHECK_NEAR(analyzer.spectrum()[bin],
+             peak * keep * BandSmoother::SILENCE_DECAY, 1e-6);
+}
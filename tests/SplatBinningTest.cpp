@@ -0,0 +1,87 @@
+#include "SignalFixtures.h"
+#include "SplatBinning.h"
+#include "Test.h"
+
+#include <cmath>
+
+// Splats pseudoaleatorios (tamaños como shader.vert: hasta 9 * 1.8)
+static std::vector<Splat> randomSplats(size_t count, int width, int height) {
+  std::vector<float> r = fixtures::whiteNoise(1.0f, count * 3, 99);
+  std::vector<Splat> splats(count);
+  for (size_t i = 0; i < count; i++) {
+    splats[i].x = (r[3 * i] * 0.6f + 0.5f) * width;
+    splats[i].y = (r[3 * i + 1] * 0.6f + 0.5f) * height;
+    splats[i].size = 1.0f + (r[3 * i + 2] * 0.5f + 0.5f) * 15.2f;
+    splats[i].r = 1.0f;
+  }
+  return splats;
+}
+
+TEST(splat_glow_matches_point_falloff) {
+  CHECK_NEAR(splatGlow(0.0f, 0.0f, 10.0f), 1.0f, 1e-6);
+  // dist = 0.25 -> smoothstep = 0.5
+  CHECK_NEAR(splatGlow(2.5f, 0.0f, 10.0f), 0.5f, 1e-6);
+  CHECK_NEAR(splatGlow(0.0f, 5.0f, 10.0f), 0.0f, 1e-6);
+  CHECK(splatGlow(5.01f, 0.0f, 10.0f) == 0.0f);
+}
+
+TEST(splat_tile_range_covers_lit_pixels) {
+  const int width = 97, height = 61;
+  TileGrid grid = makeTileGrid(width, height);
+  CHECK(grid.tilesX == 7 && grid.tilesY == 4);
+
+  for (const Splat &s : randomSplats(300, width, height)) {
+    TileRange range = splatTileRange(s.x, s.y, s.size, width, height, grid);
+    CHECK(range.count() <= maxTilesPerSplat(s.size));
+    for (int py = 0; py < height; py++) {
+      for (int px = 0; px < width; px++) {
+        float glow = splatGlow(px + 0.5f - s.x, py + 0.5f - s.y, s.size);
+        if (glow <= 0.0f)
+          continue;
+        int tx = px / grid.tileSize, ty = py / grid.tileSize;
+        CHECK(tx >= range.x0 && tx <= range.x1 && ty >= range.y0 &&
+              ty <= range.y1);
+      }
+    }
+  }
+}
+
+TEST(splat_tile_range_rejects_offscreen_and_clipped) {
+  TileGrid grid = makeTileGrid(64, 64);
+  CHECK(splatTileRange(-20.0f, 10.0f, 8.0f, 64, 64, grid).empty());
+  CHECK(splatTileRange(10.0f, 90.0f, 8.0f, 64, 64, grid).empty());
+  CHECK(splatTileRange(10.0f, 10.0f, 0.0f, 64, 64, grid).empty());
+  // Parcialmente dentro: solo el tile del borde
+  TileRange edge = splatTileRange(-2.0f, 8.0f, 8.0f, 64, 64, grid);
+  CHECK(edge.x0 == 0 && edge.x1 == 0 && edge.y0 == 0 && edge.y1 == 0);
+}
+
+TEST(splat_binned_accumulation_matches_brute_force) {
+  const int width = 80, height = 48;
+  TileGrid grid = makeTileGrid(width, height);
+  std::vector<Splat> splats = randomSplats(500, width, height);
+
+  TileBins bins;
+  binSplats(splats.data(), splats.size(), width, height, grid, bins);
+
+  size_t total = 0;
+  for (uint32_t c : bins.counts)
+    total += c;
+  CHECK(total == bins.indices.size());
+
+  for (int py = 0; py < height; py++) {
+    for (int px = 0; px < width; px++) {
+      float brute = 0.0f;
+      for (const Splat &s : splats)
+        brute += splatGlow(px + 0.5f - s.x, py + 0.5f - s.y, s.size);
+
+      int tile = (py / grid.tileSize) * grid.tilesX + px / grid.tileSize;
+      float binned = 0.0f;
+      for (uint32_t k = 0; k < bins.counts[tile]; k++) {
+        const Splat &s = splats[bins.indices[bins.offsets[tile] + k]];
+        binned += splatGlow(px + 0.5f - s.x, py + 0.5f - s.y, s.size);
+      }
+      CHECK_NEAR(binned, brute, 1e-4);
+    }
+  }
+}
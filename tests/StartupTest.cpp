@@ -0,0 +1,83 @@
+#include "Grid.h"
+#include "Starfield.h"
+#include "Startup.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+TEST(startup_loader_reads_shaders_and_builds_grids) {
+  StartupTimeline timeline(0);
+  std::atomic<int> reads{0};
+  StartupLoader loader;
+  loader.start(
+      [&reads](const std::string &path) {
+        reads++;
+        return "// " + path;
+      },
+      "shaders/", timeline);
+
+  const StartupShaderSources &sources = loader.shaders();
+  CHECK(sources.particle.vertex == "// shaders/shader.vert");
+  CHECK(sources.bloom.fragment == "// shaders/bloom.frag");
+  CHECK(sources.nebula.vertex == "// shaders/nebula.vert");
+  CHECK(reads == 8);
+
+  const StartupGrids &grids = loader.grids();
+  for (size_t i = 0; i < WAVE_LAYER_COUNT; i++)
+    CHECK(grids.waves[i] ==
+          generateGrid(WAVE_LAYERS[i].gridCount, WAVE_LAYERS[i].spacing));
+  CHECK(grids.stars.size() == (size_t)STAR_GRID_COUNT * STAR_GRID_COUNT * 2);
+  // Segunda llamada: mismo resultado sin volver a esperar
+  CHECK(&loader.grids() == &grids);
+
+  // Una etapa por hilo de trabajo y una espera por resultado
+  std::vector<std::string> lanes;
+  for (const StartupStageTime &stage : timeline.stages())
+    lanes.push_back(stage.lane + "/" + stage.name);
+  CHECK(lanes.size() == 4);
+  CHECK(std::count(lanes.begin(), lanes.end(), "grids/build_grids") == 1);
+  CHECK(std::count(lanes.begin(), lanes.end(), "main/wait_shaders") == 1);
+}
+
+TEST(startup_timeline_orders_stages_and_keeps_first_mark) {
+  const int64_t MS = 1000000;
+  StartupTimeline timeline(100 * MS);
+  timeline.record("grids", "build_grids", 101 * MS, 140 * MS);
+  timeline.record("main", "window", 100 * MS, 130 * MS);
+  timeline.mark("first frame", 150 * MS);
+  timeline.mark("first frame", 180 * MS);
+
+  std::vector<StartupStageTime> stages = timeline.stages();
+  CHECK(stages.size() == 2);
+  CHECK(stages[0].name == "window");
+  CHECK_NEAR(stages[1].startMs, 1.0, 1e-9);
+  CHECK_NEAR(timeline.milestoneMs("first frame"), 50.0, 1e-9);
+  CHECK(timeline.milestoneMs("complete") < 0.0);
+  CHECK_NEAR(timeline.serialMs(), 69.0, 1e-9);
+
+  std::string report = timeline.report();
+  CHECK(report.find("Startup: first frame 50.0 ms") == 0);
+  CHECK(report.find("69.0 ms of work in 50.0 ms") != std::string::npos);
+}
+
+TEST(startup_sequence_runs_one_step_per_call) {
+  StartupTimeline timeline(0);
+  StartupSequence sequence;
+  std::vector<int> ran;
+  sequence.add("stars", [&] { ran.push_back(1); });
+  sequence.add("waves", [&] { ran.push_back(2); });
+  CHECK(sequence.remaining() == 2);
+
+  CHECK(sequence.runNext(timeline));
+  CHECK(ran.size() == 1 && ran[0] == 1);
+  CHECK(!sequence.done());
+  CHECK(sequence.runNext(timeline));
+  CHECK(sequence.done());
+  CHECK(!sequence.runNext(timeline));
+  CHECK(ran.size() == 2 && ran[1] == 2);
+  CHECK(timeline.stages().size() == 2);
+  CHECK(timeline.stages()[1].lane == "main");
+}
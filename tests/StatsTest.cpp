@@ -0,0 +1,22 @@
+#include "Stats.h"
+#include "Test.h"
+
+TEST(stats_percentiles_interpolate) {
+  std::vector<double> samples;
+  for (int i = 100; i >= 1; i--)
+    samples.push_back((double)i);
+  Distribution d = summarize(samples);
+  CHECK(d.count == 100);
+  CHECK_NEAR(d.mean, 50.5, 1e-9);
+  CHECK_NEAR(d.min, 1.0, 1e-9);
+  CHECK_NEAR(d.max, 100.0, 1e-9);
+  CHECK_NEAR(d.p50, 50.5, 1e-9);
+  CHECK_NEAR(d.p95, 95.05, 1e-9);
+  CHECK_NEAR(d.p99, 99.01, 1e-9);
+}
+
+TEST(stats_empty_and_single) {
+  CHECK(summarize({}).count == 0);
+  Distribution one = summarize({4.0});
+  CHECK(one.p50 == 4.0 && one.p99 == 4.0 && one.mean == 4.0);
+}
@@ -0,0 +1,58 @@
+#pragma once
+/*
+ * Test - Mini framework de tests (sin dependencias externas)
+ * TEST(nombre) registra un caso; CHECK/CHECK_NEAR marcan fallos sin abortar
+ */
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace test {
+
+struct Case {
+  const char *name;
+  void (*fn)();
+};
+
+inline std::vector<Case> &registry() {
+  static std::vector<Case> cases;
+  return cases;
+}
+
+inline int &failures() {
+  static int count = 0;
+  return count;
+}
+
+struct Registrar {
+  Registrar(const char *name, void (*fn)()) { registry().push_back({name, fn}); }
+};
+
+inline void fail(const char *file, int line, const std::string &what) {
+  failures()++;
+  std::cerr << file << ":" << line << ": FAILED " << what << std::endl;
+}
+
+} // namespace test
+
+#define TEST(name)                                                             \
+  static void name();                                                          \
+  static test::Registrar name##_registrar(#name, &name);                       \
+  static void name()
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond))                                                               \
+      test::fail(__FILE__, __LINE__, #cond);                                   \
+  } while (0)
+
+#define CHECK_NEAR(a, b, tol)                                                  \
+  do {                                                                         \
+    double va_ = (double)(a), vb_ = (double)(b);                               \
+    if (!(std::fabs(va_ - vb_) <= (double)(tol)))                              \
+      test::fail(__FILE__, __LINE__,                                           \
+                 std::string(#a " ~= " #b " (") + std::to_string(va_) +        \
+                     " vs " + std::to_string(vb_) + ")");                      \
+  } while (0)
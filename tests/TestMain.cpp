@@ -0,0 +1,21 @@
+#include "Test.h"
+
+#include <cstring>
+
+// Uso: neon_tests [filtro]  (ejecuta los casos cuyo nombre contiene filtro)
+int main(int argc, char **argv) {
+  const char *filter = argc > 1 ? argv[1] : nullptr;
+  int run = 0;
+  for (const test::Case &c : test::registry()) {
+    if (filter && !std::strstr(c.name, filter))
+      continue;
+    int before = test::failures();
+    c.fn();
+    run++;
+    std::cout << (test::failures() == before ? "[ OK ] " : "[FAIL] ") << c.name
+              << std::endl;
+  }
+  std::cout << run << " tests, " << test::failures() << " failures"
+            << std::endl;
+  return test::failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+#include "Nebula.h"
+#include "Starfield.h"
+#include "Test.h"
+#include "Transform.h"
+#include "WaveLayers.h"
+
+#include <cmath>
+
+static bool nearlyEqual(const Mat4 &a, const Mat4 &b, float tol) {
+  for (int i = 0; i < 16; i++)
+    if (std::fabs(a.m[i] - b.m[i]) > tol)
+      return false;
+  return true;
+}
+
+TEST(transform_perspective_matches_glm) {
+  // glm::perspective(radians(45), 16/9, 0.1, 400)
+  Mat4 p = transform::perspective(0.785398163f, 16.0f / 9.0f, 0.1f, 400.0f);
+  CHECK_NEAR(p.at(0, 0), 1.357995, 1e-5);
+  CHECK_NEAR(p.at(1, 1), 2.414214, 1e-5);
+  CHECK_NEAR(p.at(2, 2), -1.0005, 1e-5);
+  CHECK_NEAR(p.at(2, 3), -0.20005, 1e-5);
+  CHECK(p.at(3, 2) == -1.0f && p.at(3, 3) == 0.0f);
+
+  // Un punto en el near plane sale en z = -w
+  Vec4 clip = p * Vec4{0.0f, 0.0f, -0.1f, 1.0f};
+  CHECK_NEAR(clip.z / clip.w, -1.0, 1e-5);
+}
+
+TEST(transform_off_center_perspective_crops_the_full_view) {
+  const float fovy = 0.785398163f;
+  Mat4 full = transform::perspective(fovy, 16.0f / 9.0f, 0.1f, 400.0f);
+  // La ventana entera es la perspectiva normal
+  CHECK(nearlyEqual(
+      full,
+      transform::offCenterPerspective(fovy, 1280, 720, 0, 0, 1280, 720, 0.1f,
+                                      400.0f),
+      1e-5f));
+
+  // Un punto cae en el mismo pixel de la pared desde cualquier ventana
+  Mat4 part = transform::offCenterPerspective(fovy, 1280, 720, 640, 100, 400,
+                                              300, 0.1f, 400.0f);
+  Vec4 point{0.7f, -0.2f, -3.0f, 1.0f};
+  Vec4 a = full * point, b = part * point;
+  double fullX = (a.x / a.w * 0.5 + 0.5) * 1280.0;
+  double fullY = (a.y / a.w * 0.5 + 0.5) * 720.0;
+  double partX = (b.x / b.w * 0.5 + 0.5) * 400.0 + 640.0;
+  double partY = (b.y / b.w * 0.5 + 0.5) * 300.0 + 100.0;
+  CHECK_NEAR(partX, fullX, 1e-3);
+  CHECK_NEAR(partY, fullY, 1e-3);
+  // La profundidad no cambia: el z-test es el mismo en todos los tiles
+  CHECK_NEAR(b.z / b.w, a.z / a.w, 1e-6);
+}
+
+TEST(transform_rotate_and_translate_post_multiply) {
+  // rotY(90) lleva +x a -z; la traslacion se aplica despues (m * T)
+  Mat4 r = transform::rotate(Mat4(), 1.5707963f, 0.0f, 1.0f, 0.0f);
+  Vec4 v = r * Vec4{1.0f, 0.0f, 0.0f, 1.0f};
+  CHECK_NEAR(v.x, 0.0, 1e-6);
+  CHECK_NEAR(v.z, -1.0, 1e-6);
+
+  Mat4 rt = transform::translate(r, 2.0f, 0.0f, 0.0f);
+  Vec4 o = rt * Vec4{0.0f, 0.0f, 0.0f, 1.0f};
+  CHECK_NEAR(o.x, 0.0, 1e-6);
+  CHECK_NEAR(o.z, -2.0, 1e-6);
+
+  // Eje sin normalizar = mismo giro
+  CHECK(nearlyEqual(r, transform::rotate(Mat4(), 1.5707963f, 0, 3, 0), 1e-6f));
+
+  Mat4 s = transform::scale(Mat4(), 200.0f);
+  Vec4 c = s * Vec4{1.0f, -1.0f, 1.0f, 1.0f};
+  CHECK(c.x == 200.0f && c.y == -200.0f && c.w == 1.0f);
+}
+
+TEST(transform_scene_views_place_layers_in_front_of_camera) {
+  // Sin rotacion la capa principal queda a cameraDistance delante
+  Mat4 main = waveLayerView(1, 2.5f, 0.0f, 0.0f);
+  Vec4 origin = main * Vec4{0.0f, 0.0f, 0.0f, 1.0f};
+  CHECK_NEAR(origin.z, -2.5, 1e-6);
+
+  Mat4 far = waveLayerView(0, 2.5f, 0.5f, 0.0f);
+  Vec4 farOrigin = far * Vec4{0.0f, 0.0f, 0.0f, 1.0f};
+  CHECK_NEAR(farOrigin.y, -1.0, 1e-6);
+  CHECK_NEAR(farOrigin.z, -3.0, 1e-6);
+
+  // Los 4 paneles de estrellas rodean la camara a la misma distancia
+  for (size_t panel = 0; panel < STAR_PANEL_COUNT; panel++) {
+    Vec4 c = starPanelView(panel, 0.3f, 0.7f) * Vec4{0, 0, 0, 1};
+    CHECK_NEAR(std::sqrt(c.x * c.x + c.y * c.y + c.z * c.z),
+               STAR_PANEL_DISTANCE, 1e-3);
+  }
+  Vec4 front = starPanelView(0, 0.0f, 0.0f) * Vec4{0, 0, 0, 1};
+  CHECK_NEAR(front.z, -STAR_PANEL_DISTANCE, 1e-4);
+
+  Vec4 corner = skyboxModel(0.0f, 0.0f) * Vec4{1, 1, -1, 1};
+  CHECK(corner.x == 200.0f && corner.z == -200.0f);
+}
@@ -0,0 +1,174 @@
+#include "SoftRenderer.h"
+#include "Test.h"
+#include "WallSync.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int WALL_WIDTH = 160;
+constexpr int WALL_HEIGHT = 90;
+constexpr int WALL_FRAMES = 3;
+constexpr double TIMEOUT_MS = 10000.0;
+
+WallLayout testLayout() {
+  WallLayout layout;
+  layout.width = WALL_WIDTH;
+  layout.height = WALL_HEIGHT;
+  layout.columns = 2;
+  layout.rows = 2;
+  return layout;
+}
+
+// Envolventes que cambian cada frame: si un tile usara el frame de otro
+// se notaria en la imagen
+AudioFrame leaderAudio(int frame) {
+  AudioFrame audio;
+  audio.bass = 0.2f + 0.1f * frame;
+  audio.mids = 0.1f * frame;
+  audio.treble = 0.4f - 0.1f * frame;
+  return audio;
+}
+
+SoftFrame softFrame(const WallFrame &frame) {
+  SoftFrame soft;
+  soft.time = frame.time;
+  soft.bass = frame.audio.bass;
+  soft.mids = frame.audio.mids;
+  soft.treble = frame.audio.treble;
+  soft.cameraDistance = frame.cameraDistance;
+  soft.cameraAngleX = frame.cameraAngleX;
+  soft.cameraAngleY = frame.cameraAngleY;
+  return soft;
+}
+
+// Un proceso tile, como neon_render --wall: escribe su parte de cada
+// frame en 'walls' (memoria compartida con el padre)
+int runTile(const std::string &name, int tile, uint8_t *walls) {
+  const WallLayout layout = testLayout();
+  WallSync sync;
+  if (tile == 0 ? !sync.create(name, layout.tiles())
+                : !sync.attach(name, tile, TIMEOUT_MS))
+    return 1;
+
+  WallRect core = wallTileRect(layout, tile);
+  WallRect area = wallRenderRect(layout, tile);
+  SoftRenderer renderer(area.width, area.height, 1);
+  renderer.setWindow(layout.width, layout.height, area.x, area.y);
+  WallRect crop = core;
+  crop.x -= area.x;
+  crop.y -= area.y;
+
+  WallClock clock(60.0);
+  const size_t wallBytes = (size_t)WALL_WIDTH * WALL_HEIGHT * 3;
+  for (int f = 0;; f++) {
+    WallFrame frame;
+    if (tile == 0) {
+      if (f == WALL_FRAMES)
+        break;
+      frame = clock.next(leaderAudio(f), 2.5f, 0.5f, 0.0f);
+      if (!sync.publish(frame, TIMEOUT_MS))
+        return 1;
+    } else if (!sync.waitFrame(f + 1, frame, TIMEOUT_MS)) {
+      return sync.finished() && f == WALL_FRAMES ? 0 : 1;
+    }
+    renderer.render(softFrame(frame));
+    if (!sync.readyAndWait(frame.index, TIMEOUT_MS))
+      return 1;
+
+    std::vector<uint8_t> part = cropRGB(renderer.image(), area.width, crop);
+    // Solo se escriben las filas del tile: los demas no se pisan
+    for (int y = 0; y < core.height; y++)
+      std::memcpy(walls + f * wallBytes +
+                      ((size_t)(core.y + y) * WALL_WIDTH + core.x) * 3,
+                  part.data() + (size_t)y * core.width * 3,
+                  (size_t)core.width * 3);
+  }
+  sync.finish();
+  return 0;
+}
+
+} // namespace
+
+TEST(wall_sync_leader_waits_for_every_tile) {
+  const std::string name = "/neon-wall-test-" + std::to_string(getpid());
+  WallSync leader, follower, stranger;
+  CHECK(leader.create(name, 2));
+  CHECK(follower.attach(name, 1, 100.0));
+  CHECK(leader.tiles() == 2 && follower.tile() == 1);
+  CHECK(!stranger.attach(name, 2, 100.0)); // Fuera de la pared
+
+  WallClock clock;
+  WallFrame first = clock.next(AudioFrame(), 2.5f, 0.5f, 0.0f);
+  CHECK(leader.publish(first, 100.0));
+  WallFrame seen;
+  CHECK(follower.waitFrame(1, seen, 100.0) && seen.time == first.time);
+
+  // Nadie presenta el frame 1 ni hay frame 2 hasta que todos lo dibujan
+  WallFrame second = clock.next(AudioFrame(), 2.5f, 0.5f, 0.0f);
+  CHECK(!leader.publish(second, 5.0));
+  CHECK(!follower.readyAndWait(1, 5.0));
+  CHECK(leader.readyAndWait(1, 100.0));
+  CHECK(leader.publish(second, 100.0));
+  CHECK(follower.waitFrame(2, seen, 100.0) && seen.index == 2);
+
+  // Al terminar el lider los tiles salen en vez de esperar
+  leader.finish();
+  CHECK(!follower.waitFrame(3, seen, 1000.0) && follower.finished());
+  leader.close();
+  CHECK(!stranger.attach(name, 1, 10.0)); // El nombre ya no existe
+}
+
+// Cuatro procesos dibujan un tile cada uno en lockstep; la pared
+// pegada es el render completo de los mismos frames
+TEST(wall_sync_tiles_stitch_into_the_full_render) {
+  const std::string name = "/neon-wall-stitch-" + std::to_string(getpid());
+  const WallLayout layout = testLayout();
+  const size_t wallBytes = (size_t)WALL_WIDTH * WALL_HEIGHT * 3;
+  void *shared = mmap(nullptr, wallBytes * WALL_FRAMES,
+                      PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1,
+                      0);
+  CHECK(shared != MAP_FAILED);
+  if (shared == MAP_FAILED)
+    return;
+  uint8_t *walls = static_cast<uint8_t *>(shared);
+
+  // Los seguidores primero: esperan en attach a que el lider cree
+  std::vector<pid_t> pids;
+  for (int tile = layout.tiles() - 1; tile >= 0; tile--) {
+    pid_t pid = fork();
+    if (pid == 0)
+      _exit(runTile(name, tile, walls));
+    pids.push_back(pid);
+  }
+  for (pid_t pid : pids) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+
+  SoftRenderer full(WALL_WIDTH, WALL_HEIGHT, 1);
+  WallClock clock(60.0);
+  for (int f = 0; f < WALL_FRAMES; f++) {
+    full.render(softFrame(clock.next(leaderAudio(f), 2.5f, 0.5f, 0.0f)));
+    const std::vector<uint8_t> &expected = full.image();
+    int worst = 0;
+    for (size_t i = 0; i < wallBytes; i++)
+      worst = std::max(worst,
+                       std::abs((int)walls[f * wallBytes + i] - expected[i]));
+    CHECK(worst <= 1);
+    if (worst > 1)
+      std::cerr << "frame " << f + 1 << ": stitched wall max diff " << worst
+                << std::endl;
+  }
+  munmap(shared, wallBytes * WALL_FRAMES);
+}
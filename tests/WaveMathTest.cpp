@@ -0,0 +1,127 @@
+#include "Grid.h"
+#include "SignalFixtures.h"
+#include "Test.h"
+#include "WaveMath.h"
+
+#include <cmath>
+
+// Transcripcion literal de gerstnerWave() de shader.vert en double
+static WavePoint shaderReference(double px, double pz, const WaveParams &p) {
+  auto mod = [](double x, double y) { return x - y * std::floor(x / y); };
+  double g = p.gridSize;
+  double dx = mod(px + g * 0.5, g) - g * 0.5;
+  double dz = mod(pz + p.time * 0.4 + g * 0.5, g) - g * 0.5;
+
+  double l1 = std::sqrt(1.25), l2 = std::sqrt(1.49);
+  double d1x = 1.0 / l1, d1y = 0.5 / l1;
+  double d2x = -0.7 / l2, d2y = 1.0 / l2;
+
+  double amp = 0.15 + ((p.bass * 0.4) * 0.8 + p.mids * 0.2) * 0.5;
+  double ph1 = (d1x * dx + d1y * dz) * 3.0 - p.time * 1.5;
+  double ph2 = (d2x * dx + d2y * dz) * 3.0 * 1.3 - p.time * 1.5 * 0.8;
+
+  WavePoint w;
+  w.x = (float)(dx + 0.5 * amp * d1x * std::cos(ph1) +
+                0.5 * amp * 0.6 * d2x * std::cos(ph2));
+  w.y = (float)(std::sin(ph1) * amp + std::sin(ph2) * amp * 0.6);
+  w.z = (float)(dz + 0.5 * amp * d1y * std::cos(ph1) +
+                0.5 * amp * 0.6 * d2y * std::cos(ph2));
+  return w;
+}
+
+TEST(wave_matches_shader_reference) {
+  std::vector<float> grid = generateGrid(40, 0.15f);
+  WaveParams params;
+  params.gridSize = 40 * 0.15f;
+  for (float t : {0.0f, 1.7f, 42.0f}) {
+    for (float bass : {0.0f, 0.9f}) {
+      params.time = t;
+      params.bass = bass;
+      params.mids = 0.3f;
+      for (size_t i = 0; i < grid.size() / 2; i += 7) {
+        WavePoint got = gerstnerWave(grid[2 * i], grid[2 * i + 1], params);
+        WavePoint ref = shaderReference(grid[2 * i], grid[2 * i + 1], params);
+        CHECK_NEAR(got.x, ref.x, 1e-3);
+        CHECK_NEAR(got.y, ref.y, 1e-3);
+        CHECK_NEAR(got.z, ref.z, 1e-3);
+      }
+    }
+  }
+}
+
+TEST(wave_grid_matches_pointwise) {
+  std::vector<float> grid = generateGrid(25, 0.2f);
+  WaveParams params;
+  params.time = 3.25f;
+  params.gridSize = 5.0f;
+  params.bass = 0.5f;
+  size_t count = grid.size() / 2;
+  std::vector<WavePoint> out(count);
+  evaluateWaveGrid(grid.data(), count, params, out.data());
+  for (size_t i = 0; i < count; i++) {
+    WavePoint p = gerstnerWave(grid[2 * i], grid[2 * i + 1], params);
+    CHECK(out[i].x == p.x && out[i].y == p.y && out[i].z == p.z);
+  }
+}
+
+TEST(wave_height_stays_in_expected_range) {
+  // Amplitud con bass = mids = 1: 0.15 + (0.4 * 0.8 + 0.2) * 0.5 = 0.41;
+  // las dos ondas suman como mucho 1.6 veces eso
+  WaveParams params;
+  params.gridSize = 6.0f;
+  params.bass = 1.0f;
+  params.mids = 1.0f;
+  std::vector<float> grid = generateGrid(60, 0.1f);
+  for (float t = 0.0f; t < 10.0f; t += 0.9f) {
+    params.time = t;
+    for (size_t i = 0; i < grid.size() / 2; i++) {
+      WavePoint p = gerstnerWave(grid[2 * i], grid[2 * i + 1], params);
+      CHECK(std::fabs(p.y) <= 1.6f * 0.41f + 1e-5f);
+    }
+  }
+}
+
+TEST(grid_is_centered) {
+  std::vector<float> grid = generateGrid(4, 1.0f);
+  CHECK(grid.size() == 4 * 4 * 2);
+  CHECK_NEAR(grid[0], -1.5f, 1e-7);
+  CHECK_NEAR(grid[1], -1.5f, 1e-7);
+  CHECK_NEAR(grid[grid.size() - 2], 1.5f, 1e-7);
+  CHECK_NEAR(grid[grid.size() - 1], 1.5f, 1e-7);
+}
+
+TEST(particle_appearance_matches_shader) {
+  WaveParams params;
+  params.gridSize = 6.0f; // main
+  params.bass = 0.5f;
+  params.treble = 0.25f;
+  ParticleStyle style;
+  style.intensity = 1.8f;
+
+  // Valle: tamaño minimo y cian atenuado (0.85), pulso bass * 0.15
+  WavePoint trough;
+  trough.y = -0.4f;
+  ParticleLook low = particleAppearance(trough, params, style);
+  const double pulse = 1.8 * (1.0 + 0.5 * 0.15);
+  CHECK_NEAR(low.size, (2.0 + (6.5 - 2.0) * 0.001) * 1.8, 1e-4);
+  CHECK_NEAR(low.r, 0.1 * 0.85 * pulse, 1e-5);
+  CHECK_NEAR(low.g, 0.6 * 0.85 * pulse, 1e-5);
+  CHECK_NEAR(low.b, 0.9 * 0.85 * pulse, 1e-5);
+
+  // Cresta: tamaño maximo (6 + treble * 2) y espuma rosa pastel completa
+  WavePoint crest;
+  crest.y = 0.4f;
+  ParticleLook high = particleAppearance(crest, params, style);
+  CHECK_NEAR(high.size, 6.5 * 1.8, 1e-4);
+  CHECK_NEAR(high.r, 1.0 * pulse, 1e-5);
+  CHECK_NEAR(high.g, 0.8 * pulse, 1e-5);
+
+  // Capa lejana: picos con peakExp 10, sin espuma y pulso bass * 0.8
+  params.gridSize = 25.0f;
+  style.intensity = 0.6f;
+  style.peakExp = 10.0f;
+  ParticleLook farCrest = particleAppearance(crest, params, style);
+  CHECK_NEAR(farCrest.size, 7.5 * 0.6, 1e-4);
+  CHECK_NEAR(farCrest.r, (1.3 + 0.25 * 0.2) * 0.6 * 1.4, 1e-5);
+  CHECK_NEAR(farCrest.g, (0.1 + 0.25 * 0.2) * 0.6 * 1.4, 1e-5);
+}
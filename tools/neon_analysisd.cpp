@@ -0,0 +1,195 @@
+// Neon Gerstner - servidor de analisis en memoria compartida
+// Lee PCM float32 intercalado de stdin, analiza bandas y publica un
+// AudioFrame por bloque en un AnalysisRing POSIX para N renderers.
+//
+// Uso:
+//   parec --format=float32le --channels=2 | neon_analysisd --channels 2
+//   neon_analysisd --synthetic          (tono de prueba en tiempo real)
+//   neon_analysisd --rt-policy fifo --rt-cpu 3 --mlock --stats 10
+//   neon_analysisd --engine filterbank  (bandas cada 32 muestras)
+//   NeonGerstner --attach /neon-analysis
+
+#include "BandAnalyzer.h"
+#include "BandEngine.h"
+#include "CaptureCadence.h"
+#include "RealtimeThread.h"
+#include "SharedAnalysis.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr size_t PACKET_FRAMES = 480; // 10 ms, como un periodo WASAPI
+
+std::atomic<bool> running{true};
+
+void onSignal(int) { running = false; }
+
+struct Options {
+  std::string name = DEFAULT_ANALYSIS_SHM;
+  int channels = 2;
+  uint32_t capacity = 256;
+  bool synthetic = false;
+  RealtimeOptions realtime;
+  double statsSeconds = 0.0; // 0: ritmo solo al salir
+  AnalysisEngine engine = AnalysisEngine::FFT;
+  size_t packetFrames = 0; // 0: PACKET_FRAMES, o un hop con filterbank
+};
+
+bool parseOptions(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--name") == 0 && hasValue)
+      options.name = argv[++i];
+    else if (std::strcmp(argv[i], "--channels") == 0 && hasValue)
+      options.channels = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--capacity") == 0 && hasValue)
+      options.capacity = (uint32_t)std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--synthetic") == 0)
+      options.synthetic = true;
+    else if (std::strcmp(argv[i], "--rt-policy") == 0 && hasValue) {
+      if (!parseRealtimePolicy(argv[++i], options.realtime.policy))
+        return false;
+    } else if (std::strcmp(argv[i], "--rt-priority") == 0 && hasValue)
+      options.realtime.priority = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--rt-cpu") == 0 && hasValue)
+      options.realtime.cpu = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--mlock") == 0)
+      options.realtime.lockMemory = true;
+    else if (std::strcmp(argv[i], "--stats") == 0 && hasValue)
+      options.statsSeconds = std::atof(argv[++i]);
+    else if (std::strcmp(argv[i], "--engine") == 0 && hasValue) {
+      if (!parseAnalysisEngine(argv[++i], options.engine))
+        return false;
+    } else if (std::strcmp(argv[i], "--packet") == 0 && hasValue)
+      options.packetFrames = (size_t)std::atoi(argv[++i]);
+    else
+      return false;
+  }
+  return options.channels > 0 && options.capacity > 0 &&
+         options.statsSeconds >= 0.0;
+}
+
+// Bombo a 2 Hz sobre un pad de medios y ruido de agudos
+void synthesize(std::vector<float> &interleaved, size_t frames,
+                int channels, uint64_t &frameIndex) {
+  for (size_t i = 0; i < frames; i++, frameIndex++) {
+    double t = (double)frameIndex / SAMPLE_RATE;
+    double beat = std::fmod(t, 0.5);
+    double kick = std::exp(-beat * 12.0) * std::sin(2.0 * M_PI * 60.0 * t);
+    double pad = 0.15 * std::sin(2.0 * M_PI * 1000.0 * t);
+    double hiss = 0.02 * ((double)std::rand() / RAND_MAX - 0.5);
+    float sample = (float)(0.6 * kick + pad + hiss);
+    for (int c = 0; c < channels; c++)
+      interleaved[i * channels + c] = sample;
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    std::fprintf(stderr,
+                 "usage: neon_analysisd [--name /shm] [--channels N] "
+                 "[--capacity N] [--synthetic] [--rt-policy normal|fifo|rr] "
+                 "[--rt-priority N] [--rt-cpu N] [--mlock] [--stats S] "
+                 "[--engine fft|filterbank] [--packet frames]\n");
+    return 2;
+  }
+
+  // El filterbank publica cada hop: leer paquetes de ese tamaño para que
+  // el ritmo de publicacion no lo limite la lectura
+  std::unique_ptr<BandEngine> analyzer = createBandEngine(options.engine);
+  size_t packetFrames = options.packetFrames;
+  if (packetFrames == 0)
+    packetFrames = std::min(PACKET_FRAMES, analyzer->updateInterval());
+
+  SharedAnalysisWriter shared;
+  if (!shared.create(options.name, options.capacity))
+    return 1;
+
+  std::signal(SIGINT, onSignal);
+  std::signal(SIGTERM, onSignal);
+  std::fprintf(stderr,
+               "neon_analysisd: publishing %s (%u slots), %s engine, "
+               "%zu-frame packets\n",
+               options.name.c_str(), options.capacity,
+               analysisEngineName(options.engine), packetFrames);
+
+  // Buffers reservados antes de mlockall y de subir la prioridad
+  std::vector<float> interleaved(packetFrames * options.channels);
+  std::vector<float> mono(packetFrames);
+  uint64_t frameIndex = 0;
+
+  RealtimeScope realtimeScope(options.realtime);
+  if (!realtimeScope.describe().empty())
+    std::fprintf(stderr, "neon_analysisd: %s\n",
+                 realtimeScope.describe().c_str());
+
+  CadenceMonitor cadence(1000.0 * packetFrames / SAMPLE_RATE);
+  const int64_t statsIntervalNs = (int64_t)(options.statsSeconds * 1e9);
+  int64_t nextStatsNs = monotonicNowNs() + statsIntervalNs;
+  const auto start = std::chrono::steady_clock::now();
+
+  while (running) {
+    size_t frames = packetFrames;
+    if (options.synthetic) {
+      // Espera absoluta al final del paquete: el retraso no se acumula
+      uint64_t endFrame = frameIndex + packetFrames;
+      std::this_thread::sleep_until(
+          start + std::chrono::nanoseconds(endFrame * 1000000000ull /
+                                           SAMPLE_RATE));
+      cadence.wake(monotonicNowNs());
+      synthesize(interleaved, packetFrames, options.channels, frameIndex);
+    } else {
+      // fread bloquea hasta que llega audio: el ritmo lo marca la fuente
+      size_t samples = std::fread(interleaved.data(), sizeof(float),
+                                  interleaved.size(), stdin);
+      frames = samples / options.channels;
+      if (frames == 0)
+        break; // EOF
+      cadence.wake(monotonicNowNs());
+    }
+
+    downmixToMono(interleaved.data(), frames, options.channels, mono.data());
+    if (analyzer->push(mono.data(), frames) == 0) {
+      cadence.workDone(monotonicNowNs());
+      continue;
+    }
+
+    BandLevels levels = analyzer->levels();
+    AudioFrame frame;
+    frame.timestampNs = monotonicNowNs();
+    frame.bass = levels.bass;
+    frame.mids = levels.mids;
+    frame.treble = levels.treble;
+    std::copy(analyzer->spectrum(), analyzer->spectrum() + SPECTRUM_BINS,
+              frame.spectrum);
+    shared.publish(frame);
+    cadence.workDone(monotonicNowNs());
+
+    if (statsIntervalNs > 0 && frame.timestampNs >= nextStatsNs) {
+      std::fprintf(stderr, "neon_analysisd: %s",
+                   formatCadenceReport(cadence.report()).c_str());
+      nextStatsNs = frame.timestampNs + statsIntervalNs;
+    }
+  }
+
+  std::fprintf(stderr, "neon_analysisd: %s",
+               formatCadenceReport(cadence.report()).c_str());
+  shared.close();
+  return 0;
+}
@@ -0,0 +1,399 @@
+// Neon Gerstner - renderer por software (nodos sin GPU)
+// Renderiza el pipeline completo en CPU a PPM (ficheros o stdout) a un
+// ritmo de frames fijo. El audio sale de un PCM float32 o de una señal
+// sintetica, analizado offline con el mismo motor de bandas que la captura.
+//
+// Uso:
+//   neon_render --frames 600 --out frames/%05d.ppm
+//   neon_render --pcm song.f32 --channels 2 --out - |
+//       ffmpeg -f image2pipe -c:v ppm -framerate 60 -i - out.mp4
+//   neon_render --bench                  (fps con 1, 2, 4 ... nucleos)
+//
+// Pared de pantallas: un proceso por tile, el 0 lidera (audio y reloj)
+//   neon_render --width 3840 --height 1080 --wall 2x1 --tile 0 --out a%05d.ppm
+//   neon_render --width 3840 --height 1080 --wall 2x1 --tile 1 --out b%05d.ppm
+
+#include "BandAnalyzer.h"
+#include "BandEngine.h"
+#include "ImageIO.h"
+#include "SoftRenderer.h"
+#include "Stats.h"
+#include "VideoWall.h"
+#ifdef NEON_HAS_WALL_SYNC
+#include "WallSync.h"
+#endif
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr int BENCH_WARMUP_FRAMES = 3;
+
+struct Options {
+  int width = 1280;
+  int height = 720;
+  int frames = 300;
+  bool framesSet = false;
+  double fps = 60.0;
+  unsigned threads = 0;
+  int nebulaScale = 2;
+  float cameraDistance = 2.5f;
+  std::string out;        // Patron printf ("%05d") o "-" para stdout
+  std::string pcm;        // float32 intercalado; vacio = sintetico
+  int channels = 2;
+  bool bench = false;
+  AnalysisEngine engine = AnalysisEngine::FFT;
+  // Pared: --width/--height son los de la pared entera
+  int wallColumns = 1;
+  int wallRows = 1;
+  int tile = -1; // -1: sin pared
+  int guard = WALL_GUARD_BAND;
+  std::string wallSync = "/neon-wall";
+};
+
+bool parseOptions(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--width") == 0 && hasValue)
+      options.width = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--height") == 0 && hasValue)
+      options.height = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+      options.frames = std::atoi(argv[++i]);
+      options.framesSet = true;
+    } else if (std::strcmp(argv[i], "--fps") == 0 && hasValue)
+      options.fps = std::atof(argv[++i]);
+    else if (std::strcmp(argv[i], "--threads") == 0 && hasValue)
+      options.threads = (unsigned)std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--nebula-scale") == 0 && hasValue)
+      options.nebulaScale = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--distance") == 0 && hasValue)
+      options.cameraDistance = (float)std::atof(argv[++i]);
+    else if (std::strcmp(argv[i], "--out") == 0 && hasValue)
+      options.out = argv[++i];
+    else if (std::strcmp(argv[i], "--pcm") == 0 && hasValue)
+      options.pcm = argv[++i];
+    else if (std::strcmp(argv[i], "--channels") == 0 && hasValue)
+      options.channels = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--bench") == 0)
+      options.bench = true;
+    else if (std::strcmp(argv[i], "--engine") == 0 && hasValue) {
+      if (!parseAnalysisEngine(argv[++i], options.engine))
+        return false;
+    } else if (std::strcmp(argv[i], "--wall") == 0 && hasValue) {
+      if (!parseWallGrid(argv[++i], options.wallColumns, options.wallRows))
+        return false;
+    } else if (std::strcmp(argv[i], "--tile") == 0 && hasValue)
+      options.tile = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--guard") == 0 && hasValue)
+      options.guard = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--wall-sync") == 0 && hasValue)
+      options.wallSync = argv[++i];
+    else
+      return false;
+  }
+  if (options.tile >= options.wallColumns * options.wallRows ||
+      options.guard < 0)
+    return false;
+  return options.width > 0 && options.height > 0 && options.frames > 0 &&
+         options.fps > 0.0 && options.channels > 0 &&
+         options.nebulaScale > 0;
+}
+
+// Audio mono del frame: fichero PCM o bombo + pad + hi-hat sinteticos
+class OfflineAudio {
+public:
+  bool open(const Options &options) {
+    channels = options.channels;
+    if (options.pcm.empty())
+      return true;
+    file = std::fopen(options.pcm.c_str(), "rb");
+    if (!file)
+      std::fprintf(stderr, "neon_render: cannot open %s\n",
+                   options.pcm.c_str());
+    return file != nullptr;
+  }
+
+  ~OfflineAudio() {
+    if (file)
+      std::fclose(file);
+  }
+
+  // Siguientes 'frames' muestras mono (silencio tras el EOF)
+  void read(size_t frames, std::vector<float> &mono) {
+    mono.assign(frames, 0.0f);
+    if (!file) {
+      for (size_t i = 0; i < frames; i++, sampleIndex++)
+        mono[i] = syntheticMusicSample(sampleIndex, SAMPLE_RATE);
+      return;
+    }
+    interleaved.resize(frames * channels);
+    size_t got = std::fread(interleaved.data(), sizeof(float),
+                            interleaved.size(), file) /
+                 channels;
+    downmixToMono(interleaved.data(), got, channels, mono.data());
+  }
+
+private:
+  std::FILE *file = nullptr;
+  int channels = 2;
+  uint64_t sampleIndex = 0;
+  std::vector<float> interleaved;
+};
+
+std::string framePath(const std::string &pattern, int frame) {
+  char path[1024];
+  std::snprintf(path, sizeof(path), pattern.c_str(), frame);
+  return path;
+}
+
+int renderFrames(const Options &options) {
+  OfflineAudio audio;
+  if (!audio.open(options))
+    return 1;
+
+  // Sin pared, un unico tile que es la imagen entera
+  WallLayout layout;
+  layout.width = options.width;
+  layout.height = options.height;
+  layout.columns = options.wallColumns;
+  layout.rows = options.wallRows;
+  layout.guard = options.guard;
+  const bool wall = options.tile >= 0;
+  const int tile = wall ? options.tile : 0;
+  const bool leader = tile == 0;
+  const WallRect core = wallTileRect(layout, wall ? tile : 0);
+  const WallRect area = wall ? wallRenderRect(layout, tile) : core;
+
+  SoftRenderer renderer(area.width, area.height, options.threads);
+  renderer.setNebulaScale(options.nebulaScale);
+  if (wall)
+    renderer.setWindow(layout.width, layout.height, area.x, area.y);
+  // El tile dentro de lo que se renderiza (sin la banda de guarda)
+  WallRect crop = core;
+  crop.x -= area.x;
+  crop.y -= area.y;
+
+#ifdef NEON_HAS_WALL_SYNC
+  WallSync sync;
+  if (wall && !(leader ? sync.create(options.wallSync, layout.tiles())
+                       : sync.attach(options.wallSync, tile,
+                                     WALL_TIMEOUT_MS)))
+    return 1;
+#else
+  if (wall) {
+    std::fprintf(stderr, "neon_render: --wall needs POSIX shared memory\n");
+    return 1;
+  }
+#endif
+
+  std::unique_ptr<BandEngine> analyzer = createBandEngine(options.engine);
+  std::vector<float> mono;
+
+  const bool toStdout = options.out == "-";
+#ifdef _WIN32
+  // stdout en modo texto convertiria cada 0x0A del P6 en CRLF
+  if (toStdout)
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+  const double frameSeconds = 1.0 / options.fps;
+  double audioClock = 0.0;
+  uint64_t samplesRead = 0;
+  WallClock clock(options.fps);
+
+  std::vector<double> totalMs, lockMs;
+  SoftStageTimes sum;
+  auto wallStart = std::chrono::steady_clock::now();
+
+  int frames = 0;
+  for (; !leader || frames < options.frames; frames++) {
+    WallFrame frame;
+    if (leader) {
+      // Audio hasta el instante de este frame
+      audioClock += frameSeconds;
+      uint64_t target = (uint64_t)(audioClock * SAMPLE_RATE);
+      audio.read((size_t)(target - samplesRead), mono);
+      samplesRead = target;
+      analyzer->push(mono.data(), mono.size());
+      BandLevels levels = analyzer->levels();
+      AudioFrame envelope;
+      envelope.bass = levels.bass;
+      envelope.mids = levels.mids;
+      envelope.treble = levels.treble;
+      std::copy(analyzer->spectrum(), analyzer->spectrum() + SPECTRUM_BINS,
+                envelope.spectrum);
+
+      // Mismo tiempo variable que main.cpp, con delta fijo
+      frame = clock.next(envelope, options.cameraDistance, 0.5f, 0.0f);
+    }
+#ifdef NEON_HAS_WALL_SYNC
+    auto lockStart = std::chrono::steady_clock::now();
+    if (wall && leader && !sync.publish(frame, WALL_TIMEOUT_MS))
+      return 1;
+    if (wall && !leader && !sync.waitFrame(frames + 1, frame,
+                                           WALL_TIMEOUT_MS)) {
+      if (sync.finished())
+        break;
+      std::fprintf(stderr, "neon_render: tile %d lost the leader\n", tile);
+      return 1;
+    }
+    double lockWaitMs = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - lockStart)
+                            .count();
+#endif
+
+    SoftFrame soft;
+    soft.time = frame.time;
+    soft.bass = frame.audio.bass;
+    soft.mids = frame.audio.mids;
+    soft.treble = frame.audio.treble;
+    soft.cameraDistance = frame.cameraDistance;
+    soft.cameraAngleX = frame.cameraAngleX;
+    soft.cameraAngleY = frame.cameraAngleY;
+    renderer.render(soft);
+    const SoftStageTimes &t = renderer.times();
+    totalMs.push_back(t.totalMs());
+    sum.nebulaMs += t.nebulaMs;
+    sum.geometryMs += t.geometryMs;
+    sum.binMs += t.binMs;
+    sum.rasterMs += t.rasterMs;
+    sum.bloomMs += t.bloomMs;
+    sum.combineMs += t.combineMs;
+
+#ifdef NEON_HAS_WALL_SYNC
+    // Swap lock: nadie escribe el frame N hasta que todos lo tienen
+    lockStart = std::chrono::steady_clock::now();
+    if (wall && !sync.readyAndWait(frame.index, WALL_TIMEOUT_MS))
+      return 1;
+    lockMs.push_back(lockWaitMs +
+                     std::chrono::duration<double, std::milli>(
+                         std::chrono::steady_clock::now() - lockStart)
+                         .count());
+#endif
+
+    std::vector<uint8_t> tileImage;
+    if (wall)
+      tileImage = cropRGB(renderer.image(), area.width, crop);
+    const std::vector<uint8_t> &image = wall ? tileImage : renderer.image();
+    bool written = true;
+    if (toStdout)
+      written = writePPM(stdout, core.width, core.height, image);
+    else if (!options.out.empty())
+      written =
+          writePPM(framePath(options.out, frames), core.width, core.height,
+                   image);
+    if (!written)
+      return 1;
+  }
+#ifdef NEON_HAS_WALL_SYNC
+  if (wall && leader)
+    sync.finish();
+#endif
+  if (toStdout)
+    std::fflush(stdout);
+
+  double wallSeconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - wallStart)
+                           .count();
+  double n = (double)std::max(frames, 1);
+  std::fprintf(stderr,
+               "neon_render: %d frames %dx%d, %u threads, %.1f fps "
+               "(with output)\n  render ms %s\n"
+               "  stage mean ms: nebula %.2f geometry %.2f bin %.2f "
+               "raster %.2f bloom %.2f combine %.2f\n",
+               frames, core.width, core.height, renderer.threads(),
+               frames / wallSeconds,
+               formatDistribution(summarize(totalMs), 2).c_str(),
+               sum.nebulaMs / n, sum.geometryMs / n, sum.binMs / n,
+               sum.rasterMs / n, sum.bloomMs / n, sum.combineMs / n);
+  if (wall)
+    std::fprintf(stderr,
+                 "  wall tile %d of %d, rendered %dx%d at (%d, %d), "
+                 "frame lock wait ms %s\n",
+                 tile, layout.tiles(), area.width, area.height, area.x,
+                 area.y, formatDistribution(summarize(lockMs), 2).c_str());
+  return 0;
+}
+
+// fps del mismo frame con 1, 2, 4 ... hilos y con todos los nucleos
+int runBenchmark(const Options &options) {
+  unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<unsigned> counts;
+  for (unsigned n = 1; n < cores; n *= 2)
+    counts.push_back(n);
+  counts.push_back(cores);
+
+  const int measured = options.framesSet ? options.frames : 30;
+  SoftFrame frame; // Escena fija, como RenderBench
+  frame.time = 10.0f;
+  frame.bass = 0.5f;
+  frame.mids = 0.3f;
+  frame.treble = 0.4f;
+  frame.cameraDistance = options.cameraDistance;
+
+  std::printf("%dx%d, nebula scale %d, %d frames per row\n", options.width,
+              options.height, options.nebulaScale, measured);
+  std::printf("%-8s %-8s %-8s %-44s %s\n", "threads", "fps", "speedup",
+              "frame ms", "stage mean ms (neb geo bin ras blm cmb)");
+  double baseFps = 0.0;
+  for (unsigned threads : counts) {
+    SoftRenderer renderer(options.width, options.height, threads);
+    renderer.setNebulaScale(options.nebulaScale);
+    std::vector<double> samples;
+    SoftStageTimes sum;
+    for (int i = 0; i < BENCH_WARMUP_FRAMES + measured; i++) {
+      renderer.render(frame);
+      if (i < BENCH_WARMUP_FRAMES)
+        continue;
+      const SoftStageTimes &t = renderer.times();
+      samples.push_back(t.totalMs());
+      sum.nebulaMs += t.nebulaMs;
+      sum.geometryMs += t.geometryMs;
+      sum.binMs += t.binMs;
+      sum.rasterMs += t.rasterMs;
+      sum.bloomMs += t.bloomMs;
+      sum.combineMs += t.combineMs;
+    }
+    Distribution d = summarize(samples);
+    double fps = 1000.0 / d.mean;
+    if (baseFps == 0.0)
+      baseFps = fps;
+    std::printf("%-8u %-8.1f %-8.2f %-44s %.1f %.1f %.1f %.1f %.1f %.1f\n",
+                threads, fps, fps / baseFps,
+                formatDistribution(d, 1).c_str(), sum.nebulaMs / measured,
+                sum.geometryMs / measured, sum.binMs / measured,
+                sum.rasterMs / measured, sum.bloomMs / measured,
+                sum.combineMs / measured);
+  }
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    std::fprintf(stderr,
+                 "usage: neon_render [--width W] [--height H] [--frames N] "
+                 "[--fps F] [--threads N] [--nebula-scale N] [--distance D] "
+                 "[--pcm file.f32 --channels N] [--engine fft|filterbank] "
+                 "[--out pattern.ppm | -] [--bench] [--wall CxR --tile I "
+                 "[--guard PX] [--wall-sync /name]]\n");
+    return 2;
+  }
+  return options.bench ? runBenchmark(options) : renderFrames(options);
+}